@@ -0,0 +1,39 @@
+#ifndef BENCHMARKCOMMAND_H
+#define BENCHMARKCOMMAND_H
+
+class QCoreApplication;
+
+/**
+ * @brief Scene and solver performance measurements from the command line
+ *
+ *   DFD-HEAT --benchmark faces|objects|pick [--counts 1000,10000,...]
+ *   DFD-HEAT --benchmark mesh|assembly [--element-size h] [--threads 1,2,4,...]
+ *            [--repeat N]
+ *   DFD-HEAT --benchmark solver [--element-size h] [--preconditioners jacobi,ilu,amg]
+ *
+ * "faces" times MeshData face insertion and edge lookup per face on quad
+ * grids of each size; "objects" times ObjectManager adds, UUID lookups
+ * and removals per object at each scene size; "pick" times ScenePicker
+ * ray casts into a grid of boxes against a 1 ms budget.
+ *
+ * The solver stages mesh a built-in building model (soil, slab, brick
+ * walls, insulation).
+ * "mesh" and "assembly" time volume meshing and matrix assembly once per
+ * thread count and print a scaling table ("mesh" adds a rotated chimney
+ * and a spherical tank, filled from their surfaces); "solver" compares
+ * preconditioners by setup time, iterations and solve time over two load
+ * cases sharing one setup.
+ * Results go to stdout. Needs no display.
+ */
+namespace BenchmarkCommand {
+
+// True if the arguments ask for a benchmark (checked before any
+// QCoreApplication exists)
+bool isRequested(int argc, char* argv[]);
+
+// Parse the arguments, run the benchmark and return the process exit code
+int run(QCoreApplication& app);
+
+} // namespace BenchmarkCommand
+
+#endif // BENCHMARKCOMMAND_H
@@ -0,0 +1,30 @@
+#ifndef RENDERCOMMAND_H
+#define RENDERCOMMAND_H
+
+class QGuiApplication;
+
+/**
+ * @brief Headless batch rendering from the command line
+ *
+ *   DFD-HEAT --render <dir> [--size WxH] [--views iso,front,top,...]
+ *            [--parallel N] [--name <base>] [--scene <file>]
+ *
+ * Writes one PNG per view into <dir> without opening a window; run with
+ * QT_QPA_PLATFORM=offscreen (or under Xvfb) on machines without a display.
+ * The scene is a JSON scene file (see SceneFile) or, without --scene, the
+ * default scene the viewport starts with.
+ * Views are split across N OffscreenRenderers, each with its own scene and
+ * Qt3D engine, so batches render in parallel.
+ */
+namespace RenderCommand {
+
+// True if the arguments ask for a headless render (checked before any
+// QApplication exists)
+bool isRequested(int argc, char* argv[]);
+
+// Parse the arguments, render and return the process exit code
+int run(QGuiApplication& app);
+
+} // namespace RenderCommand
+
+#endif // RENDERCOMMAND_H
@@ -0,0 +1,35 @@
+#ifndef RENDERCOUNTERS_H
+#define RENDERCOUNTERS_H
+
+#include <QtGlobal>
+#include <atomic>
+
+/**
+ * @brief Process-wide counters fed by the code that hands data to Qt3D
+ *
+ * Every QBuffer::setData()/updateData() call site adds its byte count;
+ * FrameProfiler takes the total once per frame. Counting is one relaxed
+ * atomic add, so it stays on even when nobody profiles.
+ */
+namespace RenderCounters {
+
+inline std::atomic<qint64>& uploadedBytesCounter()
+{
+    static std::atomic<qint64> counter{0};
+    return counter;
+}
+
+inline void addUploadedBytes(qint64 bytes)
+{
+    uploadedBytesCounter().fetch_add(bytes, std::memory_order_relaxed);
+}
+
+// Bytes handed to Qt3D buffers since the previous call
+inline qint64 takeUploadedBytes()
+{
+    return uploadedBytesCounter().exchange(0, std::memory_order_relaxed);
+}
+
+} // namespace RenderCounters
+
+#endif // RENDERCOUNTERS_H
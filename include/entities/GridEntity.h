@@ -8,8 +8,19 @@
 namespace Qt3DRender {
     class QGeometryRenderer;
     class QMaterial;
+    class QParameter;
 }
 
+/**
+ * @brief Procedural ground grid on the y = 0 plane
+ *
+ * Draws one large quad; the fragment shader computes anti-aliased lines
+ * from the world position. Line spacing adapts to the on-screen cell size
+ * in steps of 10 (cross-fading between levels), and the grid fades out
+ * with distance from the camera. The cost is constant regardless of the
+ * grid extent, and changing size, divisions or color only updates
+ * shader parameters.
+ */
 class GridEntity : public Qt3DCore::QEntity
 {
     Q_OBJECT
@@ -18,20 +29,30 @@ public:
     explicit GridEntity(Qt3DCore::QNode *parent = nullptr);
     ~GridEntity();
 
+    // Spacing of the finest grid lines, in meters
     void setGridSize(float size);
+    // Cells across the area kept fully visible before the distance fade
+    // (the fade radius also grows with camera height)
     void setGridDivisions(int divisions);
     void setColor(const QColor &color);
     void setVisible(bool visible);
 
+    // Half-extent of the drawn quad; beyond this the grid is faded out anyway
+    static constexpr float Extent = 5000.0f;
+
 private:
     void createGrid();
+    void updateFadeRadius();
 
     Qt3DRender::QGeometryRenderer *m_mesh;
     Qt3DRender::QMaterial *m_material;
+    Qt3DRender::QParameter *m_colorParameter;
+    Qt3DRender::QParameter *m_cellSizeParameter;
+    Qt3DRender::QParameter *m_fadeRadiusParameter;
 
     float m_gridSize;
     int m_gridDivisions;
     QColor m_color;
 };
 
-#endif // GRIDENTITY_H
\ No newline at end of file
+#endif // GRIDENTITY_H
@@ -0,0 +1,34 @@
+#ifndef RENDERSTATSOVERLAY_H
+#define RENDERSTATSOVERLAY_H
+
+#include <QWidget>
+#include <QElapsedTimer>
+#include "viewport/FrameProfiler.h"
+
+/**
+ * @brief Corner readout of FrameProfiler samples over the viewport
+ *
+ * A child overlay like CrosshairsOverlay, but a native one so it shows
+ * above the Qt3D window container. Samples arrive every frame; the text
+ * is repainted at most a few times per second.
+ */
+class RenderStatsOverlay : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit RenderStatsOverlay(QWidget *parent = nullptr);
+
+public slots:
+    void setSample(const FrameProfiler::Sample &sample);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    FrameProfiler::Sample m_sample;
+    QElapsedTimer m_lastRepaint;
+    int m_repaintIntervalMs;
+};
+
+#endif // RENDERSTATSOVERLAY_H
@@ -0,0 +1,127 @@
+#ifndef BOUNDINGBOX_H
+#define BOUNDINGBOX_H
+
+#include <QVector3D>
+#include <QMatrix4x4>
+#include <limits>
+#include <utility>
+
+/**
+ * @brief Ray with an unnormalized direction
+ *
+ * Points along the ray are origin + t * direction. Transforming origin and
+ * direction by an affine matrix keeps t unchanged, so hit distances from
+ * different local frames can be compared directly.
+ */
+struct Ray {
+    QVector3D origin;
+    QVector3D direction;
+
+    Ray() = default;
+    Ray(const QVector3D& o, const QVector3D& d) : origin(o), direction(d) {}
+
+    QVector3D at(float t) const { return origin + direction * t; }
+
+    Ray transformed(const QMatrix4x4& matrix) const
+    {
+        return Ray(matrix.map(origin), matrix.mapVector(direction));
+    }
+};
+
+/**
+ * @brief Axis-aligned bounding box
+ *
+ * A default-constructed box is empty (min > max) and absorbs the first
+ * point or box it is expanded with.
+ */
+class BoundingBox
+{
+public:
+    BoundingBox()
+        : m_min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max())
+        , m_max(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max())
+    {
+    }
+
+    BoundingBox(const QVector3D& min, const QVector3D& max) : m_min(min), m_max(max) {}
+
+    bool isEmpty() const { return m_min.x() > m_max.x() || m_min.y() > m_max.y() || m_min.z() > m_max.z(); }
+
+    const QVector3D& min() const { return m_min; }
+    const QVector3D& max() const { return m_max; }
+    QVector3D center() const { return (m_min + m_max) * 0.5f; }
+    QVector3D size() const { return isEmpty() ? QVector3D() : m_max - m_min; }
+
+    // Index of the longest axis (0 = x, 1 = y, 2 = z)
+    int longestAxis() const
+    {
+        const QVector3D s = size();
+        return (s.x() >= s.y() && s.x() >= s.z()) ? 0 : (s.y() >= s.z() ? 1 : 2);
+    }
+
+    void expand(const QVector3D& point)
+    {
+        m_min = QVector3D(qMin(m_min.x(), point.x()), qMin(m_min.y(), point.y()), qMin(m_min.z(), point.z()));
+        m_max = QVector3D(qMax(m_max.x(), point.x()), qMax(m_max.y(), point.y()), qMax(m_max.z(), point.z()));
+    }
+
+    void expand(const BoundingBox& other)
+    {
+        if (!other.isEmpty()) {
+            expand(other.m_min);
+            expand(other.m_max);
+        }
+    }
+
+    // Box around the eight transformed corners
+    BoundingBox transformed(const QMatrix4x4& matrix) const
+    {
+        BoundingBox result;
+        if (isEmpty()) {
+            return result;
+        }
+        for (int corner = 0; corner < 8; ++corner) {
+            result.expand(matrix.map(QVector3D(corner & 1 ? m_max.x() : m_min.x(),
+                                               corner & 2 ? m_max.y() : m_min.y(),
+                                               corner & 4 ? m_max.z() : m_min.z())));
+        }
+        return result;
+    }
+
+    // Slab test. On a hit within [tMin, tMax], tEnter is the entry parameter
+    // (clamped to tMin when the origin is inside).
+    bool intersects(const Ray& ray, float tMin, float tMax, float* tEnter = nullptr) const
+    {
+        if (isEmpty()) {
+            return false;
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            const float o = ray.origin[axis];
+            const float d = ray.direction[axis];
+            if (qFuzzyIsNull(d)) {
+                if (o < m_min[axis] || o > m_max[axis]) {
+                    return false;
+                }
+                continue;
+            }
+            float t0 = (m_min[axis] - o) / d;
+            float t1 = (m_max[axis] - o) / d;
+            if (t0 > t1) std::swap(t0, t1);
+            tMin = qMax(tMin, t0);
+            tMax = qMin(tMax, t1);
+            if (tMin > tMax) {
+                return false;
+            }
+        }
+        if (tEnter) {
+            *tEnter = tMin;
+        }
+        return true;
+    }
+
+private:
+    QVector3D m_min;
+    QVector3D m_max;
+};
+
+#endif // BOUNDINGBOX_H
@@ -0,0 +1,94 @@
+#ifndef HALFEDGEMESH_H
+#define HALFEDGEMESH_H
+
+#include <QVector>
+
+class MeshData;
+
+/**
+ * @brief Half-edge adjacency built from a MeshData polygon mesh
+ *
+ * Stores topology in contiguous arrays (half-edges, vertex -> outgoing
+ * half-edge, face -> first half-edge, edge -> half-edge) so that one-ring,
+ * edge-face and boundary-loop queries do not scan the whole mesh.
+ *
+ * Internally everything is addressed by MeshData storage slot. The public
+ * queries take and return MeshData's stable vertex/edge/face indices.
+ * Boundary edges get an explicit half-edge with face == -1, so circulating
+ * around a boundary vertex and walking boundary loops need no special cases.
+ *
+ * A HalfEdgeMesh is a snapshot: it becomes stale as soon as the MeshData
+ * topology changes. Use MeshData::halfEdgeTopology() to get a cached,
+ * automatically invalidated instance.
+ */
+class HalfEdgeMesh
+{
+public:
+    struct HalfEdge {
+        int origin;  // Vertex slot this half-edge starts at
+        int twin;    // Opposite half-edge (always valid, boundary twins have face == -1)
+        int next;    // Next half-edge around the face (or boundary loop)
+        int prev;    // Previous half-edge around the face (or boundary loop)
+        int face;    // Face slot, -1 for boundary half-edges
+        int edge;    // Edge slot
+    };
+
+    explicit HalfEdgeMesh(const MeshData& mesh);
+
+    // Adjacency queries (MeshData stable indices in and out)
+    QVector<int> vertexNeighbors(int vertexIndex) const;  // One-ring vertices
+    QVector<int> vertexFaces(int vertexIndex) const;      // Faces around a vertex
+    QVector<int> vertexEdges(int vertexIndex) const;      // Edges around a vertex
+    QVector<int> edgeFaces(int edgeIndex) const;          // One or two faces
+    QVector<int> faceNeighbors(int faceIndex) const;      // Faces sharing an edge
+
+    bool isBoundaryVertex(int vertexIndex) const;
+    bool isBoundaryEdge(int edgeIndex) const;
+
+    // Boundary detection (open shells, thermal boundary surfaces)
+    QVector<int> boundaryEdges() const;
+    QVector<QVector<int>> boundaryLoops() const;  // Ordered vertex loops
+
+    // Edges that are not part of any face (added directly via MeshData::addEdge)
+    int looseEdgeCount() const { return m_looseEdgeCount; }
+
+    // False if an edge is shared by more than two faces or a vertex is pinched
+    bool isManifold() const { return m_manifold; }
+
+    // Raw access (slot-addressed)
+    const QVector<HalfEdge>& halfEdges() const { return m_halfEdges; }
+    int vertexHalfEdge(int vertexSlot) const { return m_vertexHalfEdge[vertexSlot]; }
+    int faceHalfEdge(int faceSlot) const { return m_faceHalfEdge[faceSlot]; }
+    int edgeHalfEdge(int edgeSlot) const { return m_edgeHalfEdge[edgeSlot]; }
+    int destination(int halfEdge) const { return m_halfEdges[m_halfEdges[halfEdge].next].origin; }
+
+    /**
+     * Visit every outgoing half-edge of a vertex (by slot). Runs in
+     * O(valence); fn receives the half-edge index.
+     */
+    template<typename Fn>
+    void forEachOutgoing(int vertexSlot, Fn fn) const
+    {
+        int start = m_vertexHalfEdge[vertexSlot];
+        if (start == -1) return;
+
+        int he = start;
+        do {
+            fn(he);
+            he = m_halfEdges[m_halfEdges[he].prev].twin;
+        } while (he != start);
+    }
+
+private:
+    const MeshData& m_mesh;
+
+    QVector<HalfEdge> m_halfEdges;
+    QVector<int> m_vertexHalfEdge;  // Vertex slot -> outgoing half-edge (boundary one preferred)
+    QVector<int> m_faceHalfEdge;    // Face slot -> first half-edge
+    QVector<int> m_edgeHalfEdge;    // Edge slot -> one of its half-edges (-1 for loose edges)
+
+    int m_looseEdgeCount;
+    bool m_manifold;
+};
+
+#endif // HALFEDGEMESH_H
@@ -0,0 +1,71 @@
+#ifndef MESHBVH_H
+#define MESHBVH_H
+
+#include <QVector>
+#include <QVector3D>
+#include <limits>
+#include "mesh/BoundingBox.h"
+
+class MeshData;
+
+/**
+ * @brief Bounding-volume hierarchy over the triangles of a MeshData
+ *
+ * Faces are fan-triangulated the same way as for rendering. Nodes are
+ * split at the centroid median of their longest axis; leaves hold a few
+ * triangles. Ray casts visit children front to back and stop descending
+ * into boxes farther than the nearest hit so far.
+ *
+ * Like HalfEdgeMesh this is a snapshot of one topology. Vertex moves only
+ * need refit(); use MeshData::triangleBVH() for a cached instance that is
+ * refitted or rebuilt automatically.
+ */
+class MeshBVH
+{
+public:
+    struct Hit {
+        float t = std::numeric_limits<float>::max();
+        int faceIndex = -1;    // Stable MeshData face index
+        int vertexIndex = -1;  // Stable index of the face vertex nearest the hit
+        QVector3D position;    // In mesh space
+    };
+
+    explicit MeshBVH(const MeshData& mesh);
+
+    // Re-read vertex positions and recompute node bounds (same topology)
+    void refit(const MeshData& mesh);
+
+    // Nearest hit with t in [0, maxT]; false if nothing was hit
+    bool raycast(const Ray& ray, Hit* hit, float maxT = std::numeric_limits<float>::max()) const;
+
+    BoundingBox bounds() const { return m_nodes.isEmpty() ? BoundingBox() : m_nodes.first().box; }
+    int triangleCount() const { return m_triangles.size(); }
+    int nodeCount() const { return m_nodes.size(); }
+
+private:
+    struct Triangle {
+        int v[3];       // Vertex slots
+        int faceIndex;  // Stable face index
+    };
+
+    // Leaf: count > 0, triangles [first, first + count)
+    // Inner: count == 0, children at first and first + 1
+    struct Node {
+        BoundingBox box;
+        int first;
+        int count;
+    };
+
+    static constexpr int MaxLeafTriangles = 4;
+
+    void build(int nodeIndex, int first, int count, QVector<QVector3D>& centroids);
+    BoundingBox triangleBounds(const Triangle& triangle) const;
+    bool intersectTriangle(const Ray& ray, const Triangle& triangle, float maxT, float* t) const;
+
+    QVector<QVector3D> m_positions;  // By vertex slot
+    QVector<int> m_vertexIndices;    // Slot -> stable vertex index
+    QVector<Triangle> m_triangles;
+    QVector<Node> m_nodes;           // Root first, children after their parent
+};
+
+#endif // MESHBVH_H
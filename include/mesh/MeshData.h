@@ -3,6 +3,12 @@
 
 #include <QVector>
 #include <QVector3D>
+#include <QHash>
+#include <QSet>
+#include <memory>
+
+class HalfEdgeMesh;
+class MeshBVH;
 
 namespace Qt3DCore {
     class QNode;
@@ -46,30 +52,73 @@ public:
     };
 
     MeshData();
+    MeshData(const MeshData& other);
+    MeshData& operator=(const MeshData& other);
     ~MeshData();
 
+    // Pre-allocate storage for bulk construction (e.g. imported models)
+    void reserve(int vertexCount, int faceCount);
+
     // Vertex operations
     int addVertex(const QVector3D& position);
     void removeVertex(int index);
+    void removeVertices(const QVector<int>& indices);  // Batch removal (half-edge adjacency when manifold)
     void updateVertex(int index, const QVector3D& position);
     const QVector<Vertex>& getVertices() const { return m_vertices; }
+    const Vertex* findVertex(int index) const;
     int vertexCount() const { return m_vertices.size(); }
 
     // Edge operations
     int addEdge(int v0, int v1);
     void removeEdge(int index);
     const QVector<Edge>& getEdges() const { return m_edges; }
+    int findEdge(int v0, int v1) const;  // Edge index or -1 (either direction)
     int edgeCount() const { return m_edges.size(); }
 
     // Face operations
     int addFace(const QVector<int>& vertexIndices);
     void removeFace(int index);
     const QVector<Face>& getFaces() const { return m_faces; }
+    const Face* findFace(int index) const;
     int faceCount() const { return m_faces.size(); }
 
-    // Geometry generation for Qt3D rendering
+    // Geometry generation for Qt3D rendering. Produces flat-shaded triangles
+    // in one interleaved position/normal buffer (VertexStride bytes per
+    // vertex) and a 16-bit index buffer when the vertex count allows it.
+    static constexpr int VertexStride = 6 * sizeof(float);
     Qt3DCore::QGeometry* generateGeometry(Qt3DCore::QNode* parent = nullptr);
 
+    // Incremental update of a buffer produced by generateGeometry(). Rewrites
+    // only the faces touching vertices moved since the last update, pushing
+    // merged byte ranges via QBuffer::updateData(). Returns false (and does
+    // nothing) when the topology changed and a full rebuild is required.
+    bool updateVertexBuffer(Qt3DCore::QBuffer* vertexBuffer);
+    bool needsFullRebuild() const { return !m_layoutValid; }
+    bool hasDirtyVertices() const { return !m_dirtyVertices.isEmpty(); }
+
+    // Face drawn as the given triangle of generateGeometry() output (its
+    // primitive id), -1 if out of range. Works whether or not this mesh
+    // built the geometry itself, since the triangle order is deterministic.
+    int faceOfTriangle(int triangle) const;
+
+    // The interleaved vertex buffer of a geometry built by generateGeometry()
+    static Qt3DCore::QBuffer* vertexBufferOf(const Qt3DCore::QGeometry* geometry);
+
+    // Half-edge adjacency, built on first use and cached until the topology
+    // changes (vertex positions may change without invalidating it)
+    const HalfEdgeMesh* halfEdgeTopology() const;
+    bool hasHalfEdgeTopology() const { return m_halfEdges != nullptr; }
+
+    // Triangle BVH for ray casts, built on first use. Vertex moves refit it
+    // on the next call; topology changes rebuild it.
+    const MeshBVH* triangleBVH() const;
+
+    // Storage slot of a stable index (-1 if not present). Slots are dense
+    // [0, count) and change when elements are removed.
+    int vertexSlot(int index) const { return m_vertexSlots.value(index, -1); }
+    int edgeSlot(int index) const { return m_edgeSlots.value(index, -1); }
+    int faceSlot(int index) const { return m_faceSlots.value(index, -1); }
+
     // Clear all data
     void clear();
 
@@ -85,9 +134,41 @@ private:
     int m_nextEdgeIndex;
     int m_nextFaceIndex;
 
+    // Stable index -> storage slot. Removal swaps the last element into the
+    // freed slot, so the storage order of vertices/edges/faces is not stable.
+    QHash<int, int> m_vertexSlots;
+    QHash<int, int> m_edgeSlots;
+    QHash<int, int> m_faceSlots;
+
+    // Undirected edge lookup: packed (min(v0,v1), max(v0,v1)) -> edge index
+    QHash<quint64, int> m_edgeLookup;
+
+    static quint64 edgeKey(int v0, int v1);
+
+    // Cached adjacency (never copied, rebuilt on demand)
+    mutable std::unique_ptr<HalfEdgeMesh> m_halfEdges;
+    mutable std::unique_ptr<MeshBVH> m_triangleBVH;
+    mutable bool m_bvhStale;  // Vertices moved since the BVH was fitted
+    void invalidateTopology();
+
+    // Output layout of the last generateGeometry() call: face slot -> first
+    // triangle (faceCount + 1 entries), valid until the topology changes.
+    // faceOfTriangle() may compute the offsets without a geometry build, so
+    // m_layoutValid (a GPU buffer with this layout exists) is tracked apart.
+    mutable QVector<int> m_faceTriangleOffset;
+    mutable bool m_triangleOffsetsValid;
+    bool m_layoutValid;
+    void buildTriangleOffsets() const;
+    QSet<int> m_dirtyVertices;  // Moved since the last geometry build/update
+
+    float* writeFaceTriangles(const Face& face, float* out) const;
+
     // Helper methods
     void buildEdgesFromFaces();
     int findOrCreateEdge(int v0, int v1);
+    void removeVertexAt(int slot);
+    void removeEdgeAt(int slot);
+    void removeFaceAt(int slot);
 };
 
 #endif // MESHDATA_H
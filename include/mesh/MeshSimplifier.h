@@ -0,0 +1,58 @@
+#ifndef MESHSIMPLIFIER_H
+#define MESHSIMPLIFIER_H
+
+#include <QVector>
+#include <QVector3D>
+#include <QByteArray>
+
+class MeshData;
+
+namespace Qt3DCore {
+    class QNode;
+    class QGeometry;
+}
+
+/**
+ * @brief Builds simplified levels of detail for a mesh
+ *
+ * Uses vertex clustering: vertices are snapped to a uniform grid, each
+ * occupied cell collapses to the average of its vertices and triangles
+ * that collapse or duplicate another one are dropped. Each level halves
+ * the grid resolution of the previous one. The cell size bounds how far
+ * a surface moves, so it is the level's geometric error.
+ *
+ * snapshot() copies what is needed from a MeshData on the calling thread;
+ * buildChain() only touches that copy and can run on a worker thread.
+ * Levels come out flat-shaded in the MeshData::generateGeometry() vertex
+ * layout (unshared corners, position + normal, no index buffer).
+ */
+class MeshSimplifier
+{
+public:
+    struct Input {
+        QVector<QVector3D> positions;  // By vertex slot
+        QVector<int> triangles;        // Three vertex slots per triangle
+    };
+
+    struct Level {
+        QByteArray vertexData;  // MeshData::VertexStride bytes per corner
+        int triangleCount = 0;
+        float error = 0.0f;     // Cluster cell size, in mesh units
+    };
+
+    // Fan-triangulated copy of the mesh, matching generateGeometry()
+    static Input snapshot(const MeshData& mesh);
+
+    // Progressively coarser levels, finest first, not including the input.
+    // Stops at maxLevels, when a level no longer removes enough triangles
+    // or when it would drop below minTriangles.
+    static QVector<Level> buildChain(const Input& input, int maxLevels = 4, int minTriangles = 64);
+
+    // Qt3D geometry for one level, attribute names as generateGeometry()
+    static Qt3DCore::QGeometry* createGeometry(const Level& level, Qt3DCore::QNode* parent = nullptr);
+
+private:
+    static Level simplify(const Input& input, float cellSize);
+};
+
+#endif // MESHSIMPLIFIER_H
@@ -17,6 +17,8 @@ class BoxObject : public SceneObject
 public:
     explicit BoxObject(Qt3DCore::QNode *parent = nullptr);
     BoxObject(float width, float height, float depth, Qt3DCore::QNode *parent = nullptr);
+    // Boxes with equal dimensions share geometry and materials through the cache
+    BoxObject(const QVector3D& dimensions, GeometryCache* cache, Qt3DCore::QNode *parent = nullptr);
     ~BoxObject() override;
 
     // Override to handle width/height/depth separately
@@ -29,6 +31,7 @@ public:
 
 protected:
     void generateMesh() override;
+    QString geometryKey() const override;
 
 private:
     void initialize();
@@ -5,6 +5,8 @@
 #include <QString>
 #include <QVector>
 #include <QUuid>
+#include <QSet>
+#include "mesh/BoundingBox.h"
 
 class SceneObject;
 
@@ -35,17 +37,23 @@ public:
     // Object management
     void addObject(SceneObject* object);
     void removeObject(SceneObject* object);
+    void removeObjects(const QVector<SceneObject*>& objects);  // One pass over the collection
     bool containsObject(SceneObject* object) const;
-    QVector<SceneObject*> objects() const { return m_objects; }
+    const QVector<SceneObject*>& objects() const { return m_objects; }
+    int objectCount() const { return m_objects.size(); }
 
     // Child collection management
     void addChildCollection(Collection* collection);
     void removeChildCollection(Collection* collection);
-    QVector<Collection*> childCollections() const { return m_childCollections; }
+    const QVector<Collection*>& childCollections() const { return m_childCollections; }
 
     Collection* parentCollection() const { return m_parentCollection; }
     void setParentCollection(Collection* parent);
 
+    // World bounds of the visible objects in this collection and its
+    // children, cached until a member's bounds or membership change
+    BoundingBox bounds() const;
+
 signals:
     void nameChanged(const QString& name);
     void visibilityChanged(bool visible);
@@ -55,13 +63,20 @@ signals:
     void childCollectionRemoved(Collection* collection);
 
 private:
+    void invalidateBounds();
+
     QString m_name;
     QUuid m_uuid;
     bool m_visible;
 
     QVector<SceneObject*> m_objects;
+    QSet<SceneObject*> m_objectSet;  // Membership tests for large collections
     QVector<Collection*> m_childCollections;
     Collection* m_parentCollection;
+
+    // Cached bounds()
+    mutable BoundingBox m_bounds;
+    mutable bool m_boundsValid;
 };
 
 #endif // COLLECTION_H
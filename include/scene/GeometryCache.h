@@ -0,0 +1,74 @@
+#ifndef GEOMETRYCACHE_H
+#define GEOMETRYCACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QVector3D>
+
+class MeshData;
+
+namespace Qt3DCore {
+    class QNode;
+}
+
+namespace Qt3DRender {
+    class QGeometryRenderer;
+    class QMaterial;
+}
+
+/**
+ * @brief Reference-counted cache of shared geometry renderers and materials
+ *
+ * Objects built from the same primitive parameters (e.g. hundreds of
+ * identical piles) share one QGeometryRenderer, so one set of GPU buffers.
+ * Objects with the same material id and selection state share one material.
+ * Shared nodes are parented to a long-lived scene node so they outlive any
+ * single object; the last release deletes them.
+ *
+ * Objects that edit their mesh must stop using the shared renderer first
+ * (copy-on-write, see SceneObject::detachGeometry()).
+ */
+class GeometryCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GeometryCache(Qt3DCore::QNode* sharedParent, QObject* parent = nullptr);
+    ~GeometryCache();
+
+    // Geometry: the mesh is only used to build the renderer on a cache miss
+    Qt3DRender::QGeometryRenderer* acquireRenderer(const QString& key, MeshData& mesh);
+    void releaseRenderer(Qt3DRender::QGeometryRenderer* renderer);
+    bool isShared(Qt3DRender::QGeometryRenderer* renderer) const;
+    int refCount(Qt3DRender::QGeometryRenderer* renderer) const;
+
+    // Materials, keyed by material id and selection highlight
+    Qt3DRender::QMaterial* acquireMaterial(int materialId, bool selected);
+    void releaseMaterial(Qt3DRender::QMaterial* material);
+    bool isShared(Qt3DRender::QMaterial* material) const;
+
+    // Statistics
+    int rendererCount() const { return m_renderers.size(); }
+    int materialCount() const { return m_materials.size(); }
+
+    // Cache keys for primitives (dimensions quantized to 0.1 mm)
+    static QString boxKey(const QVector3D& dimensions);
+
+private:
+    template<typename T>
+    struct Entry {
+        T* node = nullptr;
+        int refCount = 0;
+    };
+
+    Qt3DCore::QNode* m_sharedParent;
+
+    QHash<QString, Entry<Qt3DRender::QGeometryRenderer>> m_renderers;
+    QHash<Qt3DRender::QGeometryRenderer*, QString> m_rendererKeys;
+
+    QHash<QString, Entry<Qt3DRender::QMaterial>> m_materials;
+    QHash<Qt3DRender::QMaterial*, QString> m_materialKeys;
+};
+
+#endif // GEOMETRYCACHE_H
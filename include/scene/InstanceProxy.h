@@ -0,0 +1,53 @@
+#ifndef INSTANCEPROXY_H
+#define INSTANCEPROXY_H
+
+#include "scene/SceneObject.h"
+#include <QMatrix4x4>
+
+class InstancedObject;
+
+/**
+ * @brief One instance of an InstancedObject, as seen by the rest of the app
+ *
+ * A regular SceneObject for ObjectManager, SelectionManager, the hierarchy
+ * and the properties panel, but it draws nothing itself: transform,
+ * dimensions, visibility and selection are written into its row of the
+ * group's per-instance buffer.
+ *
+ * Editing the mesh detaches the proxy: it gets its own geometry renderer
+ * and material and its instance row is hidden.
+ */
+class InstanceProxy : public SceneObject
+{
+    Q_OBJECT
+
+public:
+    ~InstanceProxy() override;
+
+    InstancedObject* group() const { return m_group; }
+    int instanceIndex() const { return m_slot; }
+
+    // True once the mesh was edited and the proxy renders on its own
+    bool isDetached() const { return m_detached; }
+
+    // Model matrix of this instance relative to the group
+    QMatrix4x4 instanceMatrix() const;
+
+    void updateGeometry() override;
+
+protected:
+    void generateMesh() override;
+    void rebuildGeometry() override;
+
+private:
+    friend class InstancedObject;
+    InstanceProxy(InstancedObject* group, int slot);
+
+    void detachFromGroup();
+
+    QPointer<InstancedObject> m_group;
+    int m_slot;
+    bool m_detached;
+};
+
+#endif // INSTANCEPROXY_H
@@ -0,0 +1,81 @@
+#ifndef INSTANCEDOBJECT_H
+#define INSTANCEDOBJECT_H
+
+#include <Qt3DCore/QEntity>
+#include <QVector>
+#include <QVector3D>
+#include <QSet>
+#include "mesh/MeshData.h"
+
+class InstanceProxy;
+
+namespace Qt3DCore {
+    class QBuffer;
+    class QBoundingVolume;
+}
+
+namespace Qt3DRender {
+    class QGeometryRenderer;
+    class QMaterial;
+}
+
+/**
+ * @brief Many copies of one mesh drawn with a single instanced draw call
+ *
+ * Used for arrays and patterns (pile grids, repeated wall segments). The
+ * mesh is uploaded once; each instance is one row of a per-instance
+ * buffer holding its model matrix and colour. Every instance is exposed
+ * as an InstanceProxy so it can be selected and edited like any other
+ * object.
+ *
+ * Rows are stored densely: removing an instance moves the last one into
+ * its slot. Changes are batched and uploaded once per event loop pass.
+ */
+class InstancedObject : public Qt3DCore::QEntity
+{
+    Q_OBJECT
+
+public:
+    // Per-instance layout: mat4 model (column-major) + RGBA colour + pick id
+    static constexpr int InstanceStride = 21 * sizeof(float);
+
+    InstancedObject(const MeshData& mesh, const QVector3D& baseDimensions,
+                    Qt3DCore::QNode *parent = nullptr);
+    ~InstancedObject() override;
+
+    // Instances
+    InstanceProxy* addInstance(const QVector3D& location);
+    const QVector<InstanceProxy*>& instances() const { return m_instances; }
+    int instanceCount() const { return m_instances.size(); }
+
+    // Shared mesh, in the local frame of an instance with baseDimensions()
+    const MeshData& baseMesh() const { return m_mesh; }
+    QVector3D baseDimensions() const { return m_baseDimensions; }
+
+private:
+    friend class InstanceProxy;
+
+    void removeInstance(InstanceProxy* proxy);
+    void markDirty(InstanceProxy* proxy);
+    void scheduleUpload();
+    void uploadInstances();
+    void writeInstance(const InstanceProxy* proxy, float* out) const;
+    void updateBounds();
+
+    MeshData m_mesh;
+    QVector3D m_baseDimensions;
+    QVector3D m_meshMin;
+    QVector3D m_meshMax;
+
+    QVector<InstanceProxy*> m_instances;  // Slot = row in the instance buffer
+    QSet<int> m_dirtySlots;
+    bool m_countChanged;
+    bool m_uploadPending;
+
+    Qt3DRender::QGeometryRenderer* m_renderer;
+    Qt3DRender::QMaterial* m_material;
+    Qt3DCore::QBuffer* m_instanceBuffer;
+    Qt3DCore::QBoundingVolume* m_boundingVolume;
+};
+
+#endif // INSTANCEDOBJECT_H
@@ -5,8 +5,13 @@
 #include <QVector>
 #include <QVector3D>
 #include <QUuid>
+#include <QHash>
+#include <QSet>
+#include "mesh/BoundingBox.h"
 
 class SceneObject;
+class GeometryCache;
+class InstancedObject;
 namespace Qt3DCore {
     class QEntity;
 }
@@ -30,26 +35,96 @@ public:
     void removeObject(SceneObject* object);
     SceneObject* duplicateObject(SceneObject* object);
 
+    // Batched lifecycle: one objectsAdded/objectsRemoved for the whole batch
+    void addObjects(const QVector<SceneObject*>& objects);
+    void removeObjects(const QVector<SceneObject*>& objects);
+
+    /**
+     * @brief Scoped bulk edit (import, paste, arrays)
+     *
+     * While any guard is alive, adds and removals are collected and
+     * objectsAdded/objectsRemoved are emitted once when the outermost guard
+     * goes out of scope. Guards nest.
+     */
+    class BulkEdit
+    {
+    public:
+        explicit BulkEdit(ObjectManager* manager);
+        ~BulkEdit();
+
+        BulkEdit(const BulkEdit&) = delete;
+        BulkEdit& operator=(const BulkEdit&) = delete;
+
+    private:
+        ObjectManager* m_manager;
+    };
+
+    bool isBulkEditing() const { return m_bulkDepth > 0; }
+
     // Object creation (primitives)
     SceneObject* createBox(const QVector3D& dimensions = QVector3D(1, 1, 1));
     SceneObject* createCylinder(float radius = 0.5f, float height = 2.0f);
     SceneObject* createSphere(float radius = 1.0f);
 
-    // Object access
-    QVector<SceneObject*> allObjects() const { return m_objects; }
+    // Arrays and patterns: copies of source placed at source location +
+    // offset, drawn with one instanced draw call (see InstancedObject).
+    // Each copy is a regular object for selection and editing.
+    QVector<SceneObject*> createArray(SceneObject* source, const QVector<QVector3D>& offsets);
+    QVector<SceneObject*> createGridArray(SceneObject* source, int columns, int rows,
+                                          const QVector3D& spacing);
+
+    // Object access. Lookup by UUID or object is O(1); removal swaps the
+    // last object into the freed slot, so allObjects() order is not stable.
+    const QVector<SceneObject*>& allObjects() const { return m_objects; }
     SceneObject* findByUuid(const QUuid& uuid) const;
+    bool contains(const SceneObject* object) const;
     int objectCount() const { return m_objects.size(); }
+    QVector<InstancedObject*> instanceGroups() const;
+
+    // World bounds of all visible objects. Cached: adds grow the cached box,
+    // removals and object bound changes recompute it on the next call from
+    // the objects' own cached bounds.
+    BoundingBox sceneBounds() const;
+    static BoundingBox boundsOf(const QVector<SceneObject*>& objects);
 
     // Root entity (for scene graph)
     Qt3DCore::QEntity* rootEntity() const { return m_rootEntity; }
 
+    // Geometry/material cache shared by primitives
+    GeometryCache* geometryCache() const { return m_geometryCache; }
+
 signals:
+    // Per object, always emitted. Views that rebuild on change should use
+    // the batched signals instead.
     void objectAdded(SceneObject* obj);
     void objectRemoved(SceneObject* obj);
 
+    // Once per single add/remove, batch call or outermost BulkEdit
+    void objectsAdded(const QVector<SceneObject*>& objects);
+    void objectsRemoved(const QVector<SceneObject*>& objects);
+
 private:
+    bool insertObject(SceneObject* object);
+    bool takeObject(SceneObject* object);
+    void beginBulkEdit();
+    void endBulkEdit();
+
     Qt3DCore::QEntity* m_rootEntity;
+    GeometryCache* m_geometryCache;
     QVector<SceneObject*> m_objects;
+
+    // UUID -> slot in m_objects (object UUIDs never change)
+    QHash<QUuid, int> m_objectSlots;
+
+    // Bulk edit state: nesting depth and changes not yet announced
+    int m_bulkDepth;
+    QVector<SceneObject*> m_pendingAdded;  // In add order; may hold objects removed again
+    QSet<SceneObject*> m_pendingAddedSet;  // Still pending among m_pendingAdded
+    QVector<SceneObject*> m_pendingRemoved;
+
+    // Cached sceneBounds()
+    mutable BoundingBox m_sceneBounds;
+    mutable bool m_sceneBoundsValid;
 };
 
 #endif // OBJECTMANAGER_H
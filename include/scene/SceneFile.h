@@ -0,0 +1,32 @@
+#ifndef SCENEFILE_H
+#define SCENEFILE_H
+
+#include <QString>
+
+class ObjectManager;
+
+/**
+ * @brief Scene contents shared by the viewport and headless renders
+ *
+ * createDefault() adds the objects a new scene starts with. load() reads
+ * a JSON scene description:
+ *
+ *   { "objects": [ { "type": "box", "name": "Cube",
+ *                    "dimensions": [2, 2, 2], "location": [0, 1, 0],
+ *                    "rotation": [0, 0, 0], "scale": [1, 1, 1],
+ *                    "material": 0, "meshSize": 0.05, "visible": true } ] }
+ *
+ * Only "type" is required; boxes are the only type so far. Vectors are
+ * [x, y, z] in metres and degrees. Objects are added in one bulk edit.
+ */
+namespace SceneFile {
+
+void createDefault(ObjectManager* objectManager);
+
+// Add the objects of a scene file; false (nothing added) with a message
+// in error if the file cannot be read or an object is invalid
+bool load(const QString& filePath, ObjectManager* objectManager, QString* error);
+
+} // namespace SceneFile
+
+#endif // SCENEFILE_H
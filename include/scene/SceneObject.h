@@ -4,15 +4,23 @@
 #include <Qt3DCore/QEntity>
 #include <Qt3DCore/QTransform>
 #include <QVector3D>
+#include <QMatrix4x4>
 #include <QUuid>
 #include <QString>
+#include <QPointer>
+#include "mesh/BoundingBox.h"
 
 class MeshData;
+class GeometryCache;
+
+namespace Qt3DCore {
+    class QGeometry;
+    class QBuffer;
+}
 
 namespace Qt3DRender {
     class QMaterial;
     class QGeometryRenderer;
-    class QObjectPicker;
 }
 
 /**
@@ -47,25 +55,67 @@ public:
     void setScale(const QVector3D& scale);
     virtual void setDimensions(const QVector3D& dim);
 
+    // Local-to-world matrix of the mesh
+    QMatrix4x4 transformMatrix() const;
+
+    // Cached axis-aligned bounds of the mesh. Local bounds are recomputed
+    // after geometry changes, world bounds after transform changes.
+    const BoundingBox& localBounds() const;
+    const BoundingBox& worldBounds() const;
+
+    // Triangles of the full-detail mesh (cached with the local bounds)
+    int triangleCount() const;
+
+    // Levels of detail (see MeshSimplifier). Level 0 is the full mesh.
+    // requestLodChain() builds coarser levels on a worker thread for meshes
+    // of at least LodMinTriangles; the chain is dropped whenever the
+    // geometry changes. Picking and Edit Mode always use level 0.
+    static constexpr int LodMinTriangles = 2000;
+    void requestLodChain();
+    int lodLevelCount() const { return 1 + m_lodLevels.size(); }
+    int lodLevel() const { return m_lodLevel; }
+    void setLodLevel(int level);
+    float lodError(int level) const;  // Geometric error in mesh units
+    int lodTriangleCount(int level) const;
+
+    // View culling (see ViewCuller): a culled object keeps its visibility
+    // but is not submitted for rendering
+    bool isCulled() const { return m_culled; }
+    void setCulled(bool culled);
+
     // Object properties
     QString name() const { return m_name; }
     QUuid uuid() const { return m_uuid; }
+    quint32 pickId() const { return m_pickId; }  // Compact id for the GPU ID pass (never 0)
     bool isVisible() const { return m_visible; }
     bool isLocked() const { return m_locked; }
     int materialId() const { return m_materialId; }
+    // Largest volume element edge inside the object for the solver mesh;
+    // 0 uses the global element size (see SceneTetrahedralizer)
+    double meshSize() const { return m_meshSize; }
 
     void setName(const QString& name);
     void setVisible(bool visible);
     void setLocked(bool locked);
     void setMaterialId(int id);
+    void setMeshSize(double size);
 
     // Mesh access for edit mode
     MeshData* meshData() { return m_meshData; }
     const MeshData* meshData() const { return m_meshData; }
 
-    // Geometry update (call after modifying mesh data)
+    // Geometry update (call after modifying mesh data). Vertex moves are
+    // pushed into the existing GPU buffer; topology changes rebuild it.
+    // Objects sharing cached geometry are detached first (copy-on-write).
     virtual void updateGeometry();
 
+    // Renderer currently drawing this object (null while drawn by an InstancedObject)
+    Qt3DRender::QGeometryRenderer* geometryRenderer() const { return m_renderer; }
+
+    // Shared geometry (see GeometryCache)
+    bool hasSharedGeometry() const;
+    void detachGeometry();
+
     // Selection state (managed by SelectionManager)
     bool isSelected() const { return m_selected; }
     void setSelected(bool selected);
@@ -74,38 +124,88 @@ signals:
     void transformChanged();
     void propertiesChanged();
     void selectionChanged(bool selected);
-    void clicked(SceneObject* object);
+    void geometryChanged();  // Mesh data was regenerated or edited
+    void boundsChanged();    // World bounds or visibility changed
+    void lodChainReady();    // Coarser levels became available
 
 protected:
     // Components (for derived classes to set up)
     Qt3DCore::QTransform* m_transform;
     Qt3DRender::QMaterial* m_material;
     Qt3DRender::QGeometryRenderer* m_renderer;
-    Qt3DRender::QObjectPicker* m_picker;
+
+    // Current geometry built from m_meshData and its interleaved vertex buffer
+    Qt3DCore::QGeometry* m_geometry;
+    Qt3DCore::QBuffer* m_vertexBuffer;
 
     // Mesh data
     MeshData* m_meshData;
 
+    // Optional cache for sharing geometry and materials with identical objects
+    QPointer<GeometryCache> m_geometryCache;
+
     // Derived classes implement mesh generation
     virtual void generateMesh() = 0;
 
-private slots:
-    void onObjectClicked();
+    // Cache key for the unedited primitive mesh (empty = never shared)
+    virtual QString geometryKey() const { return QString(); }
+
+    // Regenerate the primitive mesh and rebuild (or re-share) its geometry
+    void regenerateMesh();
+
+    // Swap to the cached material for the current material id and selection
+    void updateSharedMaterial();
+
+    // Push m_meshData to the GPU (shared, incremental or full rebuild)
+    virtual void rebuildGeometry();
 
 private:
+    void replaceRenderer(Qt3DRender::QGeometryRenderer* renderer);
+    void invalidateBounds(bool geometry);
+    void clearLodChain();
+    Qt3DRender::QGeometryRenderer* lodRenderer(int level) const;
+
     // Transform
     QVector3D m_dimensions;
 
+    // Mesh no longer matches geometryKey() (edited in Edit Mode)
+    bool m_meshEdited;
+
     // Properties
     QString m_name;
     QUuid m_uuid;
+    quint32 m_pickId;
     bool m_visible;
     bool m_locked;
     int m_materialId;
+    double m_meshSize;
     bool m_selected;
 
+    // Bounds caches (see localBounds()/worldBounds())
+    mutable BoundingBox m_localBounds;
+    mutable BoundingBox m_worldBounds;
+    mutable bool m_localBoundsValid;
+    mutable bool m_worldBoundsValid;
+    mutable int m_triangleCount;
+
+    // Level of detail: coarser levels, the one drawn, and the geometry
+    // generation a chain was built for (results of older ones are dropped)
+    struct LodLevel {
+        Qt3DRender::QGeometryRenderer* renderer;
+        float error;
+        int triangleCount;
+    };
+    QVector<LodLevel> m_lodLevels;
+    int m_lodLevel;
+    int m_lodGeneration;
+    int m_lodBuiltGeneration;
+    bool m_lodPending;
+
+    bool m_culled;
+
     // Counter for default naming
     static int s_objectCounter;
+    static quint32 s_pickIdCounter;
 };
 
 #endif // SCENEOBJECT_H
@@ -0,0 +1,96 @@
+#ifndef SCENEPICKER_H
+#define SCENEPICKER_H
+
+#include <QObject>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QPointF>
+#include <QSize>
+#include <limits>
+#include "mesh/BoundingBox.h"
+
+class SceneObject;
+class ObjectManager;
+
+namespace Qt3DRender {
+    class QCamera;
+}
+
+/**
+ * @brief CPU ray picking for all objects of an ObjectManager
+ *
+ * A BVH over world-space object bounds finds the candidate objects; each
+ * candidate is then tested against its mesh's triangle BVH
+ * (MeshData::triangleBVH()) in object space. Instanced copies are
+ * ordinary objects here, so no per-object QObjectPicker is needed.
+ *
+ * The object tree is rebuilt lazily after objects are added or removed
+ * and refitted after transform, geometry or visibility changes, so a
+ * pick after an edit costs one O(n) refit at most.
+ */
+class ScenePicker : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Hit {
+        SceneObject* object = nullptr;
+        float distance = std::numeric_limits<float>::max();  // In units of the ray direction
+        QVector3D position;    // World space
+        int faceIndex = -1;    // Stable MeshData indices
+        int vertexIndex = -1;
+
+        bool isValid() const { return object != nullptr; }
+    };
+
+    explicit ScenePicker(ObjectManager* objectManager, QObject *parent = nullptr);
+    ~ScenePicker();
+
+    // Nearest visible object along a world-space ray
+    Hit pick(const Ray& ray) const;
+
+    // World-space ray through a widget position (origin on the near plane,
+    // direction reaching the far plane)
+    static Ray screenRay(const Qt3DRender::QCamera* camera, const QPointF& pos, const QSize& viewportSize);
+
+    // World-space bounds of an object's mesh
+    static BoundingBox worldBounds(const SceneObject* object);
+
+private slots:
+    void onObjectsAdded(const QVector<SceneObject*>& objects);
+    void onObjectsRemoved(const QVector<SceneObject*>& objects);
+
+private:
+    // Leaf: count > 0, items m_order[first, first + count)
+    // Inner: count == 0, children at first and first + 1
+    struct Node {
+        BoundingBox box;
+        int first;
+        int count;
+    };
+
+    static constexpr int MaxLeafObjects = 4;
+
+    void trackObject(SceneObject* object);
+    void markDirty(SceneObject* object);
+    void ensureUpToDate() const;
+    void rebuild() const;
+    void refit() const;
+    void build(int nodeIndex, int first, int count) const;
+
+    ObjectManager* m_objectManager;
+
+    // Picked objects (slot map, swap-remove) and their world bounds
+    QVector<SceneObject*> m_items;
+    QHash<SceneObject*, int> m_itemSlots;
+
+    // Tree state, updated on the next pick
+    mutable QVector<BoundingBox> m_itemBounds;
+    mutable QVector<Node> m_nodes;
+    mutable QVector<int> m_order;  // Item slots in leaf order
+    mutable QSet<int> m_dirtyItems;
+    mutable bool m_structureDirty;
+};
+
+#endif // SCENEPICKER_H
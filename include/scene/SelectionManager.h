@@ -3,14 +3,21 @@
 
 #include <QObject>
 #include <QVector>
+#include <QSet>
+#include <QHash>
 
 class SceneObject;
+class MeshData;
 
 /**
  * @brief Manages object and mesh element selection
  *
  * SelectionManager handles selection state for both Object Mode
  * (whole objects) and Edit Mode (vertices, edges, faces).
+ *
+ * Selections are hash sets keyed by object or stable element index, so
+ * selecting and testing are O(1). Every public operation, including the
+ * bulk ones, emits at most one selectionChanged.
  */
 class SelectionManager : public QObject
 {
@@ -32,31 +39,52 @@ public:
     SelectionMode mode() const { return m_mode; }
     void setMode(SelectionMode mode);
 
-    // Object mode selection
-    QVector<SceneObject*> selectedObjects() const { return m_selectedObjects; }
+    // Object mode selection (selectedObjects() keeps selection order)
+    QVector<SceneObject*> selectedObjects() const;
     void selectObject(SceneObject* obj, bool addToSelection = false);
+    void selectObjects(const QVector<SceneObject*>& objects, bool addToSelection = false);
     void deselectObject(SceneObject* obj);
     void clearSelection();
     bool isSelected(SceneObject* obj) const;
-    int selectedObjectCount() const { return m_selectedObjects.size(); }
+    int selectedObjectCount() const { return m_selectedObjectSlots.size(); }
+
+    // Edit mode selection (stable vertex/edge/face indices, unordered)
+    const QSet<int>& selectedVertices() const { return m_selectedVertices; }
+    const QSet<int>& selectedEdges() const { return m_selectedEdges; }
+    const QSet<int>& selectedFaces() const { return m_selectedFaces; }
 
-    // Edit mode selection (vertex/edge/face indices)
-    QVector<int> selectedVertices() const { return m_selectedVertices; }
-    QVector<int> selectedEdges() const { return m_selectedEdges; }
-    QVector<int> selectedFaces() const { return m_selectedFaces; }
+    bool isVertexSelected(int index) const { return m_selectedVertices.contains(index); }
+    bool isEdgeSelected(int index) const { return m_selectedEdges.contains(index); }
+    bool isFaceSelected(int index) const { return m_selectedFaces.contains(index); }
 
     void selectVertex(int index, bool addToSelection = false);
     void selectEdge(int index, bool addToSelection = false);
     void selectFace(int index, bool addToSelection = false);
 
+    // Bulk edit mode selection (box select, select linked, ...)
+    void selectVertices(const QVector<int>& indices, bool addToSelection = false);
+    void selectEdges(const QVector<int>& indices, bool addToSelection = false);
+    void selectFaces(const QVector<int>& indices, bool addToSelection = false);
+
     void deselectVertex(int index);
     void deselectEdge(int index);
     void deselectFace(int index);
 
+    void deselectVertices(const QVector<int>& indices);
+    void deselectEdges(const QVector<int>& indices);
+    void deselectFaces(const QVector<int>& indices);
+
     void clearVertexSelection();
     void clearEdgeSelection();
     void clearFaceSelection();
 
+    // Select all / invert for the current mode: objects from the given list
+    // in Object Mode, elements of the given mesh in Edit Mode
+    void selectAll(const QVector<SceneObject*>& objects);
+    void selectAll(const MeshData& mesh);
+    void invertSelection(const QVector<SceneObject*>& objects);
+    void invertSelection(const MeshData& mesh);
+
     // Convenience
     bool hasSelection() const;
     SceneObject* activeObject() const;  // First selected object
@@ -66,15 +94,24 @@ signals:
     void modeChanged(SelectionMode mode);
 
 private:
+    QSet<int>* elementSelection(SelectionMode mode);
+    bool selectElements(QSet<int>& selection, const QVector<int>& indices, bool addToSelection);
+    bool deselectElements(QSet<int>& selection, const QVector<int>& indices);
+    static QVector<int> elementIndices(const MeshData& mesh, SelectionMode mode);
+    void compactSelectedObjects() const;
+
     SelectionMode m_mode;
 
-    // Object mode
-    QVector<SceneObject*> m_selectedObjects;
+    // Object mode: selection order, with nullptr holes left by deselection
+    // until the next compaction, and each selected object's slot in it
+    mutable QVector<SceneObject*> m_selectedObjects;
+    mutable QHash<SceneObject*, int> m_selectedObjectSlots;
+    mutable int m_firstSelected;  // No live object before this slot
 
     // Edit mode
-    QVector<int> m_selectedVertices;
-    QVector<int> m_selectedEdges;
-    QVector<int> m_selectedFaces;
+    QSet<int> m_selectedVertices;
+    QSet<int> m_selectedEdges;
+    QSet<int> m_selectedFaces;
 };
 
 #endif // SELECTIONMANAGER_H
@@ -0,0 +1,110 @@
+#ifndef CONJUGATEGRADIENT_H
+#define CONJUGATEGRADIENT_H
+
+#include <QVector>
+#include <QString>
+#include <functional>
+#include <memory>
+
+class SparseMatrix;
+
+/**
+ * @brief Approximate inverse applied once per CG iteration
+ */
+class Preconditioner
+{
+public:
+    enum Type {
+        Jacobi,
+        IncompleteLU,
+        Multigrid  // AmgPreconditioner
+    };
+
+    virtual ~Preconditioner() = default;
+
+    static std::unique_ptr<Preconditioner> create(Type type, const SparseMatrix& matrix);
+
+    // z = M^-1 r
+    virtual void apply(const QVector<double>& r, QVector<double>& z) const = 0;
+
+    // Rebuild for a matrix with the same pattern and new values
+    virtual void updateValues(const SparseMatrix& matrix) = 0;
+
+    virtual QString name() const = 0;
+    virtual QString description() const { return name(); }
+};
+
+/**
+ * @brief Diagonal (Jacobi) preconditioner
+ */
+class JacobiPreconditioner : public Preconditioner
+{
+public:
+    explicit JacobiPreconditioner(const SparseMatrix& matrix);
+
+    void apply(const QVector<double>& r, QVector<double>& z) const override;
+    void updateValues(const SparseMatrix& matrix) override;
+    QString name() const override { return QStringLiteral("Jacobi"); }
+
+private:
+    QVector<double> m_inverseDiagonal;
+};
+
+/**
+ * @brief Incomplete LU factorisation without fill-in, ILU(0)
+ *
+ * L and U keep the pattern of the matrix. For a symmetric matrix U is
+ * D L^T, so the preconditioner is symmetric and usable with conjugate
+ * gradients. The triangular solves are sequential; it serves as a
+ * reference between Jacobi and AMG.
+ */
+class IncompleteLUPreconditioner : public Preconditioner
+{
+public:
+    explicit IncompleteLUPreconditioner(const SparseMatrix& matrix);
+
+    void apply(const QVector<double>& r, QVector<double>& z) const override;
+    void updateValues(const SparseMatrix& matrix) override;
+    QString name() const override { return QStringLiteral("ILU(0)"); }
+
+private:
+    QVector<int> m_rowStart;
+    QVector<int> m_columns;
+    QVector<int> m_diagonal;  // Position of each row's diagonal entry
+    QVector<double> m_values; // L (unit diagonal, not stored) and U together
+};
+
+/**
+ * @brief Preconditioned conjugate gradient for symmetric positive definite systems
+ *
+ * Stops when the residual norm drops below tolerance times the norm of
+ * the right-hand side. Vector operations and the matrix product run in
+ * parallel; the solve allocates four work vectors of the system size.
+ */
+class ConjugateGradient
+{
+public:
+    struct Settings {
+        double tolerance = 1e-8;   // Relative residual
+        int maxIterations = 20000;
+    };
+
+    struct Result {
+        int iterations = 0;
+        double relativeResidual = 0.0;
+        bool converged = false;
+        bool cancelled = false;
+    };
+
+    // Called every few iterations; return false to stop the solve
+    using Progress = std::function<bool(int iteration, double relativeResidual)>;
+
+    // Solve A x = b starting from x (resized and zeroed if it does not match)
+    static Result solve(const SparseMatrix& A, const QVector<double>& b, QVector<double>& x,
+                        const Preconditioner& preconditioner, const Settings& settings,
+                        const Progress& progress = Progress());
+
+    static constexpr int ProgressInterval = 25;
+};
+
+#endif // CONJUGATEGRADIENT_H
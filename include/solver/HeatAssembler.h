@@ -0,0 +1,104 @@
+#ifndef HEATASSEMBLER_H
+#define HEATASSEMBLER_H
+
+#include "solver/TetMesh.h"
+#include "solver/SparseMatrix.h"
+#include <QVector>
+
+class ThermalMaterials;
+
+/**
+ * @brief Assembles the linear-tetrahedron heat conduction system
+ *
+ * Builds the global conductivity matrix K (∫ λ ∇Ni·∇Nj dV per element,
+ * λ from the element's material) and adds surface convection on boundary
+ * faces: h ∫ Ni dA, lumped on the diagonal of K, and h T∞ ∫ Ni dA to the
+ * load vector. Fixed temperatures are applied afterwards by symmetric
+ * elimination, which keeps K symmetric positive definite for conjugate
+ * gradients.
+ *
+ * Boundary conditions are chosen per boundary side (outward direction of
+ * the face); a fixed temperature overrides convection on shared nodes.
+ *
+ * The sparsity pattern and an element colouring are computed once, in the
+ * constructor, and reused by every createMatrix() and assemble() call.
+ * Elements of one colour share no node, so each colour is assembled in
+ * parallel with plain stores into K; colours run one after another. The
+ * summation order per entry depends only on the colouring, so results are
+ * identical for any thread count.
+ */
+class HeatAssembler
+{
+public:
+    struct FixedTemperature {
+        TetMesh::Side side;
+        double temperature;  // °C
+    };
+
+    struct Convection {
+        TetMesh::Side side;
+        double ambientTemperature;  // °C; the annual mean if amplitude is set
+        double coefficient;         // Surface heat transfer coefficient h in W/(m²·K)
+        double amplitude = 0.0;     // Seasonal swing around the mean, °C (transient only)
+        double coldestDay = 15.0;   // Day of the year with the lowest ambient temperature
+    };
+
+    struct BoundaryConditions {
+        QVector<FixedTemperature> fixed;
+        QVector<Convection> convection;
+    };
+
+    HeatAssembler(const TetMesh& mesh, const ThermalMaterials& materials);
+
+    // Matrix with one row per node and an entry for every pair of nodes
+    // sharing an element; values zero. Matrices share the pattern.
+    SparseMatrix createMatrix() const;
+
+    int colourCount() const { return m_colourStart.size() - 1; }
+
+    // K and load vector without fixed temperatures. K must come from
+    // createMatrix(); its values and rhs are overwritten.
+    void assemble(const BoundaryConditions& conditions, SparseMatrix& K, QVector<double>& rhs) const;
+
+    // Convection load h T∞(t) ∫ Ni dA, t in seconds from 1 January.
+    // assemble() uses the mean ambient temperatures instead.
+    void assembleLoad(const BoundaryConditions& conditions, double time, QVector<double>& rhs) const;
+
+    // Heat capacity ρ c ∫ Ni dV per node, lumped (diagonal)
+    QVector<double> lumpedCapacity() const;
+
+    static double ambientTemperature(const Convection& convection, double time);
+
+    static constexpr double SecondsPerDay = 86400.0;
+    static constexpr double DaysPerYear = 365.25;
+
+    // Fixed temperature per node, NaN for free nodes
+    QVector<double> fixedTemperatures(const BoundaryConditions& conditions) const;
+
+    // Turn fixed nodes into identity rows holding their temperature and
+    // move their columns to the right-hand side
+    static void applyFixedTemperatures(const QVector<double>& fixed, SparseMatrix& K, QVector<double>& rhs);
+
+    // Conductivity matrix of one element; returns its volume
+    static double elementConductivity(const double (&p)[4][3], double conductivity, double (&ke)[4][4]);
+
+private:
+    void buildPattern();
+    void colourElements();
+    QVector<double> regionConductivity() const;
+    double faceArea(int face) const;
+    void addConvectionLoad(const double (&coefficient)[TetMesh::SideCount],
+                           const double (&ambient)[TetMesh::SideCount], QVector<double>& rhs) const;
+
+    const TetMesh& m_mesh;
+    const ThermalMaterials& m_materials;
+
+    QVector<int> m_rowStart;
+    QVector<int> m_columns;
+
+    // Elements grouped by colour; colour c is m_colourStart[c] .. [c + 1] - 1
+    QVector<int> m_colouredElements;
+    QVector<int> m_colourStart;
+};
+
+#endif // HEATASSEMBLER_H
@@ -0,0 +1,80 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <QVector>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtGlobal>
+
+/**
+ * Data-parallel loops for the solver, on Qt's global thread pool
+ *
+ * Ranges are split into a few chunks per pool thread; small ranges run
+ * inline on the calling thread. sum() adds the chunk results in chunk
+ * order, so it returns the same value for the same thread count.
+ */
+namespace Parallel {
+
+constexpr qint64 DefaultGrain = 8192;
+
+inline int threadCount()
+{
+    return qMax(1, QThreadPool::globalInstance()->maxThreadCount());
+}
+
+struct Chunk {
+    qint64 begin;
+    qint64 end;
+    double partial;
+};
+
+inline QVector<Chunk> chunks(qint64 begin, qint64 end, qint64 grain)
+{
+    const qint64 count = end - begin;
+    const qint64 wanted = qMin<qint64>(4 * threadCount(), (count + grain - 1) / qMax<qint64>(grain, 1));
+    const qint64 n = qMax<qint64>(1, wanted);
+    QVector<Chunk> result;
+    result.reserve(n);
+    for (qint64 i = 0; i < n; ++i) {
+        result.append({ begin + count * i / n, begin + count * (i + 1) / n, 0.0 });
+    }
+    return result;
+}
+
+// fn(chunkBegin, chunkEnd) for disjoint chunks covering [begin, end)
+template <typename Fn>
+void forRange(qint64 begin, qint64 end, Fn&& fn, qint64 grain = DefaultGrain)
+{
+    if (end <= begin) {
+        return;
+    }
+    if (end - begin <= grain || threadCount() == 1) {
+        fn(begin, end);
+        return;
+    }
+    QVector<Chunk> parts = chunks(begin, end, grain);
+    QtConcurrent::blockingMap(parts, [&fn](Chunk& chunk) { fn(chunk.begin, chunk.end); });
+}
+
+// Sum of fn(chunkBegin, chunkEnd) over chunks covering [begin, end)
+template <typename Fn>
+double sum(qint64 begin, qint64 end, Fn&& fn, qint64 grain = DefaultGrain)
+{
+    if (end <= begin) {
+        return 0.0;
+    }
+    if (end - begin <= grain || threadCount() == 1) {
+        return fn(begin, end);
+    }
+    QVector<Chunk> parts = chunks(begin, end, grain);
+    QtConcurrent::blockingMap(parts, [&fn](Chunk& chunk) { chunk.partial = fn(chunk.begin, chunk.end); });
+    double total = 0.0;
+    for (const Chunk& chunk : parts) {
+        total += chunk.partial;
+    }
+    return total;
+}
+
+} // namespace Parallel
+
+#endif // PARALLEL_H
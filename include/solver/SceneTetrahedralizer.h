@@ -0,0 +1,57 @@
+#ifndef SCENETETRAHEDRALIZER_H
+#define SCENETETRAHEDRALIZER_H
+
+#include "solver/TetMesh.h"
+#include "mesh/BoundingBox.h"
+#include <QVector>
+#include <QVector3D>
+
+class ObjectManager;
+class SceneObject;
+
+/**
+ * @brief Conforming tetrahedral mesh of the scene's solid objects
+ *
+ * Builds a rectilinear grid whose lines pass through every object's
+ * bounds and are at most the element size apart, assigns each grid cell
+ * to the last object containing its centre and splits occupied cells
+ * into six tetrahedra along the main diagonal (Kuhn split). Every cell is
+ * split the same way, so neighbouring cells - also of different
+ * materials - share their face triangulation and nodes; the mesh is
+ * conforming without merging.
+ *
+ * Unrotated boxes are filled exactly from their bounds. Other objects
+ * with a closed surface are filled by ray parity along grid rows, which
+ * staircases slanted and curved faces at the local cell size; open
+ * surfaces fall back to their bounds. An object's meshSize() refines the
+ * grid lines across its extent (the lines run through the whole model).
+ *
+ * snapshot() reads the scene on the calling thread; build() only touches
+ * the snapshot, can run on a worker thread and fills cells, numbers nodes
+ * and emits elements layer by layer in parallel. The output does not
+ * depend on the thread count.
+ */
+class SceneTetrahedralizer
+{
+public:
+    struct Block {
+        BoundingBox bounds;  // World space
+        int materialId = -1;
+        double elementSize = 0.0;      // Largest cell edge across the block; 0 uses the global size
+        QVector<QVector3D> triangles;  // Closed world-space surface, three corners each; empty fills the bounds
+    };
+
+    struct Settings {
+        double elementSize = 0.0;  // Largest cell edge; 0 picks one from the model size
+        int autoDivisions = 40;    // Cells along the longest side when automatic
+    };
+
+    static QVector<Block> snapshot(const ObjectManager& objectManager);
+    static TetMesh build(const QVector<Block>& blocks, const Settings& settings);
+
+private:
+    static QVector<double> gridLines(const QVector<Block>& blocks, int axis, double elementSize);
+    static QVector<QVector3D> closedSurface(const SceneObject& object);
+};
+
+#endif // SCENETETRAHEDRALIZER_H
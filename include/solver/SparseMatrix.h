@@ -0,0 +1,48 @@
+#ifndef SPARSEMATRIX_H
+#define SPARSEMATRIX_H
+
+#include <QVector>
+
+/**
+ * @brief Square sparse matrix in compressed sparse row (CSR) form
+ *
+ * Row r holds the entries rowStart[r] .. rowStart[r + 1] - 1, with column
+ * indices sorted ascending. The pattern is fixed once built; assembly only
+ * writes values. Products run in parallel over row blocks.
+ */
+class SparseMatrix
+{
+public:
+    SparseMatrix() = default;
+
+    // Adopt a pattern; values start at zero
+    SparseMatrix(int rows, QVector<int> rowStart, QVector<int> columns);
+
+    int rows() const { return m_rows; }
+    qint64 nonZeros() const { return m_columns.size(); }
+
+    const QVector<int>& rowStart() const { return m_rowStart; }
+    const QVector<int>& columns() const { return m_columns; }
+    const QVector<double>& values() const { return m_values; }
+    QVector<double>& values() { return m_values; }
+
+    // Position of (row, column) in values(), or -1 outside the pattern
+    int find(int row, int column) const;
+
+    void setZero();
+
+    // y = A x
+    void multiply(const QVector<double>& x, QVector<double>& y) const;
+
+    QVector<double> diagonal() const;
+
+    qint64 memoryBytes() const;
+
+private:
+    int m_rows = 0;
+    QVector<int> m_rowStart;
+    QVector<int> m_columns;
+    QVector<double> m_values;
+};
+
+#endif // SPARSEMATRIX_H
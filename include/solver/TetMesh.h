@@ -0,0 +1,59 @@
+#ifndef TETMESH_H
+#define TETMESH_H
+
+#include <QVector>
+#include <QVector3D>
+
+/**
+ * @brief Linear tetrahedral volume mesh in structure-of-arrays form
+ *
+ * Node coordinates are kept in separate arrays and elements as flat node
+ * index lists, so the solver streams through them without per-element
+ * objects. Elements sharing a node index share the node: meshes built for
+ * the solver are conforming, including across material interfaces.
+ *
+ * Boundary faces are the element faces not shared with another element,
+ * tagged with the axis direction their outward normal faces. Boundary
+ * conditions are applied per direction.
+ */
+struct TetMesh {
+    enum Side {
+        NegX,
+        PosX,
+        NegY,  // Bottom
+        PosY,  // Top
+        NegZ,
+        PosZ,
+        SideCount
+    };
+
+    QVector<double> x;
+    QVector<double> y;
+    QVector<double> z;
+
+    QVector<int> tets;                // Four node indices per element
+    QVector<quint16> elementRegion;   // Index into regionMaterial, per element
+    QVector<int> regionMaterial;      // SceneObject::materialId() per region
+
+    QVector<int> boundaryFaces;       // Three node indices per face
+    QVector<quint8> boundarySide;     // Side per boundary face
+
+    int nodeCount() const { return x.size(); }
+    int elementCount() const { return tets.size() / 4; }
+    int boundaryFaceCount() const { return boundarySide.size(); }
+
+    QVector3D node(int index) const { return QVector3D(float(x[index]), float(y[index]), float(z[index])); }
+
+    // Approximate heap size, for reporting
+    qint64 memoryBytes() const
+    {
+        return qint64(x.size() + y.size() + z.size()) * sizeof(double)
+             + qint64(tets.size() + regionMaterial.size() + boundaryFaces.size()) * sizeof(int)
+             + qint64(elementRegion.size()) * sizeof(quint16)
+             + qint64(boundarySide.size()) * sizeof(quint8);
+    }
+
+    void clear() { *this = TetMesh(); }
+};
+
+#endif // TETMESH_H
@@ -0,0 +1,43 @@
+#ifndef THERMALMATERIALS_H
+#define THERMALMATERIALS_H
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief Thermal properties of a building material
+ */
+struct ThermalMaterial {
+    QString name;
+    double conductivity = 1.0;     // λ in W/(m·K)
+    double density = 2000.0;       // ρ in kg/m³
+    double specificHeat = 1000.0;  // c in J/(kg·K)
+
+    double volumetricHeatCapacity() const { return density * specificHeat; }
+};
+
+/**
+ * @brief Material library indexed by SceneObject::materialId()
+ *
+ * Holds the materials listed in the Materials dock. Objects without a
+ * material (id -1) or with an unknown id are treated as the default
+ * material, concrete.
+ */
+class ThermalMaterials
+{
+public:
+    ThermalMaterials();
+
+    static constexpr int DefaultMaterial = 0;
+
+    int count() const { return m_materials.size(); }
+    const ThermalMaterial& material(int materialId) const;
+    const QVector<ThermalMaterial>& all() const { return m_materials; }
+
+    int add(const ThermalMaterial& material);
+
+private:
+    QVector<ThermalMaterial> m_materials;
+};
+
+#endif // THERMALMATERIALS_H
@@ -0,0 +1,112 @@
+#ifndef THERMALSOLVER_H
+#define THERMALSOLVER_H
+
+#include "solver/TetMesh.h"
+#include "solver/HeatAssembler.h"
+#include "solver/ConjugateGradient.h"
+#include "solver/SceneTetrahedralizer.h"
+#include "solver/ThermalMaterials.h"
+#include "solver/TransientIntegrator.h"
+
+#include <QObject>
+#include <QFuture>
+#include <QVector>
+#include <QString>
+#include <atomic>
+#include <memory>
+
+class ObjectManager;
+
+/**
+ * @brief Steady-state heat conduction on the scene geometry
+ *
+ * solveSteadyState() snapshots the scene on the calling thread, then on a
+ * worker thread tetrahedralises it, assembles the conductivity system
+ * (HeatAssembler) and solves it with preconditioned conjugate gradients,
+ * AMG by default. Progress messages and finished() arrive on the caller's
+ * thread; the result holds the mesh and one temperature per node.
+ *
+ * solveTransient() continues from that steady state (with the mean
+ * ambient temperatures) through TransientIntegrator, streaming steps and
+ * output frames to a directory (TransientWriter); the result then holds
+ * the temperatures at the end of the simulated period.
+ *
+ * Memory grows linearly with the node count, about 400 bytes per node
+ * (mesh with ~6 elements per node, CSR matrix with ~15 entries per row,
+ * CG vectors) plus about 40% of the matrix for the AMG hierarchy, so a
+ * 5M-node model needs roughly 2.5 GB.
+ */
+class ThermalSolver : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Settings {
+        SceneTetrahedralizer::Settings mesh;
+        HeatAssembler::BoundaryConditions boundaryConditions;
+        ConjugateGradient::Settings solver;
+        Preconditioner::Type preconditioner = Preconditioner::Multigrid;
+        TransientIntegrator::Settings transient;
+    };
+
+    struct Result {
+        bool ok = false;
+        QString error;
+        TetMesh mesh;
+        QVector<double> temperatures;  // Per mesh node, °C
+        double minTemperature = 0.0;
+        double maxTemperature = 0.0;
+        ConjugateGradient::Result solve;
+        double meshSeconds = 0.0;
+        double assemblySeconds = 0.0;
+        double preconditionerSeconds = 0.0;
+        double solveSeconds = 0.0;
+        qint64 matrixBytes = 0;
+        TransientIntegrator::Result transient;  // Empty for steady-state solves
+        double transientSeconds = 0.0;
+        int frameCount = 0;
+    };
+
+    explicit ThermalSolver(QObject* parent = nullptr);
+    ~ThermalSolver();
+
+    ThermalMaterials& materials() { return m_materials; }
+    const ThermalMaterials& materials() const { return m_materials; }
+
+    // Ground below at 10 °C, top surfaces exposed to 20 °C air
+    // (h = 7.7 W/m²K, Rsi = 0.13 m²K/W), other sides adiabatic
+    static Settings defaultSettings();
+    // Ground below at 10 °C, top surfaces exposed to outdoor air swinging
+    // 1..19 °C over the year (coldest mid-January, h = 25 W/m²K,
+    // Rse = 0.04 m²K/W), one year of backward Euler steps
+    static Settings defaultTransientSettings();
+
+    // Start a solve; false if one is running or the scene is empty
+    bool solveSteadyState(const ObjectManager& objectManager, const Settings& settings);
+    bool solveTransient(const ObjectManager& objectManager, const Settings& settings, const QString& outputDirectory);
+    bool isRunning() const;
+    void cancel();
+
+    std::shared_ptr<const Result> lastResult() const { return m_result; }
+
+    // x, y, z, temperature per node
+    static bool writeNodeCsv(const Result& result, const QString& filePath);
+
+signals:
+    void progress(const QString& message);
+    void finished(bool ok);
+
+private:
+    bool start(const ObjectManager& objectManager, const Settings& settings, const QString& outputDirectory);
+    std::shared_ptr<Result> run(const QVector<SceneTetrahedralizer::Block>& blocks, const Settings& settings);
+    void runTransient(Result& result, const Settings& settings, const QString& outputDirectory);
+    void report(const QString& message);
+
+    ThermalMaterials m_materials;
+    QFuture<std::shared_ptr<Result>> m_future;
+    bool m_running;
+    std::shared_ptr<const Result> m_result;
+    std::atomic<bool> m_cancel;
+};
+
+#endif // THERMALSOLVER_H
@@ -0,0 +1,96 @@
+#ifndef TRANSIENTINTEGRATOR_H
+#define TRANSIENTINTEGRATOR_H
+
+#include "solver/TetMesh.h"
+#include "solver/HeatAssembler.h"
+#include "solver/ConjugateGradient.h"
+#include <QVector>
+#include <QString>
+#include <functional>
+
+class ThermalMaterials;
+
+/**
+ * @brief Implicit time stepping of transient heat conduction
+ *
+ * Integrates C dT/dt + K T = f(t) with the theta method: backward Euler
+ * (theta = 1) or Crank-Nicolson (theta = 0.5). C is the lumped heat
+ * capacity, K the conductivity matrix with convection, f the convection
+ * load with seasonally varying ambient temperatures. Each step solves
+ *
+ *   (C / dt + theta K) dT = theta f(t + dt) + (1 - theta) f(t) - K T
+ *
+ * for the increment dT, which is zero at fixed temperatures, so the
+ * eliminated system matrix only changes with the step size.
+ *
+ * Step sizes are initialStep * 2^k. The local error is estimated by
+ * comparing dT with its linear extrapolation from the previous step
+ * (Milne's device; first order, so conservative for Crank-Nicolson).
+ * Steps above tolerance are halved and repeated; after a few steps well
+ * below it the size doubles. The last step may end past the duration.
+ * The preconditioner is built once and refreshed with updateValues()
+ * when the step size changes, which only happens on doubling or halving.
+ *
+ * Memory does not depend on the simulated period: the callback sees
+ * every accepted step and streams out what it needs (TransientWriter).
+ */
+class TransientIntegrator
+{
+public:
+    struct Settings {
+        double theta = 1.0;                   // 1 backward Euler, 0.5 Crank-Nicolson
+        double duration = 365.25 * 86400.0;   // s
+        double initialStep = 3600.0;          // s
+        double minStep = 3600.0;              // s
+        double maxStep = 7 * 86400.0;         // s
+        double tolerance = 0.05;              // Largest local error per step, K
+        double outputInterval = 7 * 86400.0;  // s between output frames
+        ConjugateGradient::Settings solver;
+        Preconditioner::Type preconditioner = Preconditioner::Multigrid;
+    };
+
+    struct Step {
+        int index = 0;
+        double time = 0.0;         // s, at the end of the step
+        double size = 0.0;         // s
+        double errorEstimate = 0.0;
+        int iterations = 0;
+        double minTemperature = 0.0;
+        double maxTemperature = 0.0;
+        bool output = false;       // An output interval ended with this step
+    };
+
+    struct Result {
+        bool completed = false;
+        bool cancelled = false;
+        QString error;
+        int steps = 0;
+        int rejectedSteps = 0;
+        int preconditionerUpdates = 0;
+        qint64 iterations = 0;
+    };
+
+    // Called after every accepted step with the new temperatures; return
+    // false to stop
+    using StepCallback = std::function<bool(const Step& step, const QVector<double>& temperatures)>;
+
+    TransientIntegrator(const TetMesh& mesh, const ThermalMaterials& materials,
+                        const HeatAssembler::BoundaryConditions& conditions);
+
+    // Advance temperatures (initial field in, final field out) over the
+    // settings' duration from time 0
+    Result run(QVector<double>& temperatures, const Settings& settings, const StepCallback& callback);
+
+private:
+    void buildSystem(double step, double theta, SparseMatrix& A) const;
+
+    const TetMesh& m_mesh;
+    const HeatAssembler::BoundaryConditions m_conditions;
+    HeatAssembler m_assembler;
+    SparseMatrix m_K;
+    QVector<double> m_capacity;
+    QVector<int> m_diagonal;  // Position of each row's diagonal in the matrix values
+    QVector<double> m_fixed;  // 0 at fixed temperatures, NaN elsewhere
+};
+
+#endif // TRANSIENTINTEGRATOR_H
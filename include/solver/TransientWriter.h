@@ -0,0 +1,52 @@
+#ifndef TRANSIENTWRITER_H
+#define TRANSIENTWRITER_H
+
+#include "solver/TetMesh.h"
+#include "solver/TransientIntegrator.h"
+#include <QFile>
+#include <QTextStream>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+/**
+ * @brief Streams a transient simulation to disk as it runs
+ *
+ * Writes into one directory:
+ *  - nodes.csv: node, x, y, z
+ *  - steps.csv: one row per accepted step (time, step size, error
+ *    estimate, CG iterations, temperature range)
+ *  - temperatures.bin: little-endian; "DFDT", uint32 version, uint32
+ *    node count, then per output frame a float64 time in seconds and one
+ *    float32 temperature per node
+ *
+ * Only the current step is held in memory, so decades of simulated time
+ * cost disk space, not RAM.
+ */
+class TransientWriter
+{
+public:
+    static constexpr quint32 FormatVersion = 1;
+
+    ~TransientWriter();
+
+    // Create the files; false (and a warning) if the directory is not writable
+    bool open(const QString& directory, const TetMesh& mesh, const QVector<double>& initialTemperatures);
+    // Log the step and append a frame if it is an output step
+    bool write(const TransientIntegrator::Step& step, const QVector<double>& temperatures);
+    void close();
+
+    bool isOpen() const { return m_frames != nullptr; }
+    int frameCount() const { return m_frameCount; }
+
+private:
+    bool writeFrame(double time, const QVector<double>& temperatures);
+
+    std::unique_ptr<QFile> m_frames;
+    std::unique_ptr<QFile> m_log;
+    QTextStream m_logStream;
+    QVector<float> m_buffer;
+    int m_frameCount = 0;
+};
+
+#endif // TRANSIENTWRITER_H
@@ -18,6 +18,7 @@ class Viewport3D;
 class AuthManager;
 class PropertiesPanel;
 class SceneHierarchyPanel;
+class ThermalSolver;
 
 class MainWindow : public QMainWindow
 {
@@ -35,6 +36,10 @@ private slots:
     void showAbout();
     void showAuthDialog();
     void onAuthStatusChanged(bool authenticated);
+    void solveSteadyState();
+    void solveTransient();
+    void onSolverFinished(bool ok);
+    void exportResults();
 
 private:
     void createActions();
@@ -88,6 +93,9 @@ private:
     // Auth
     std::unique_ptr<AuthManager> m_authManager;
 
+    // Analysis
+    std::unique_ptr<ThermalSolver> m_thermalSolver;
+
     QString m_currentProjectPath;
 };
 
@@ -13,7 +13,8 @@ class SceneObject;
  * @brief Property panel for displaying and editing object properties
  *
  * Shows transform properties (location, rotation, scale, dimensions)
- * and object properties (name, visible, locked) for the selected object.
+ * and object properties (name, visible, locked, solver mesh size) for the
+ * selected object.
  */
 class PropertiesPanel : public QWidget
 {
@@ -34,6 +35,7 @@ private slots:
     void onDimensionsChanged();
     void onVisibleChanged(int state);
     void onLockedChanged(int state);
+    void onMeshSizeChanged(double size);
 
     // Update UI when object changes
     void onObjectTransformChanged();
@@ -67,6 +69,7 @@ private:
 
     QCheckBox* m_visibleCheck;
     QCheckBox* m_lockedCheck;
+    QDoubleSpinBox* m_meshSize;
 
     QLabel* m_uuidLabel;
 };
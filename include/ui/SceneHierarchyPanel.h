@@ -3,8 +3,10 @@
 
 #include <QWidget>
 #include <QTreeView>
-#include <QStandardItemModel>
+#include <QAbstractItemModel>
+#include <QHash>
 #include <QStyledItemDelegate>
+#include <QVector>
 
 class ObjectManager;
 class SelectionManager;
@@ -36,16 +38,58 @@ signals:
 };
 
 /**
- * @brief Custom model for drag & drop support with UUID-based serialization
+ * @brief Item model over the Collection tree
+ *
+ * Rows under a collection are its child collections followed by its
+ * objects; the only top-level row is the scene collection. Indexes point
+ * at their parent collection, so no per-row items are allocated.
+ *
+ * All structural changes go through the model so rows are inserted, moved
+ * and removed incrementally. Objects are fetched lazily in batches when a
+ * collection is expanded or scrolled. Drag & drop is serialized by UUID.
  */
-class SceneHierarchyModel : public QStandardItemModel
+class SceneHierarchyModel : public QAbstractItemModel
 {
     Q_OBJECT
 
 public:
     explicit SceneHierarchyModel(QObject* parent = nullptr);
 
-    // Override drag & drop methods to use UUIDs instead of serializing void*
+    void setRootCollection(Collection* root);
+    Collection* rootCollection() const { return m_root; }
+
+    // Index <-> scene data
+    Collection* collectionAt(const QModelIndex& index) const;
+    SceneObject* objectAt(const QModelIndex& index) const;
+    QModelIndex indexOfCollection(Collection* collection, int column = 0) const;
+    QModelIndex indexOfObject(SceneObject* object, int column = 0) const;
+    Collection* collectionOf(SceneObject* object) const { return m_objectCollection.value(object); }
+
+    // Structural edits
+    void addObjects(Collection* collection, const QVector<SceneObject*>& objects);
+    void removeObjects(const QVector<SceneObject*>& objects);
+    void moveObject(SceneObject* object, Collection* target);
+    void addCollection(Collection* collection, Collection* parent);
+    void removeCollection(Collection* collection);
+    void moveCollection(Collection* collection, Collection* target);
+
+    // Refresh displayed name/visibility
+    void notifyObjectChanged(SceneObject* object);
+    void notifyVisibilityChanged(Collection* collection);  // Collection and everything below it
+
+    // QAbstractItemModel
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& index) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+    // Drag & drop by UUID instead of serializing void*
     QStringList mimeTypes() const override;
     QMimeData* mimeData(const QModelIndexList& indexes) const override;
     bool dropMimeData(const QMimeData* data, Qt::DropAction action,
@@ -54,6 +98,21 @@ public:
 
 signals:
     void itemDropped(const QString& itemUuid, const QString& targetCollectionUuid, int itemType);
+
+private:
+    // Objects of a collection currently exposed as rows
+    int fetchedObjects(Collection* collection) const { return m_fetched.value(collection, 0); }
+    int objectSlot(Collection* collection, SceneObject* object) const;
+    int objectRow(Collection* collection, SceneObject* object) const;
+    void insertObjectRow(Collection* collection, SceneObject* object);
+    void removeObjectRow(Collection* collection, SceneObject* object);
+    void forgetCollection(Collection* collection);
+    void notifyVisibilityRecursive(Collection* collection);
+
+    Collection* m_root;
+    QHash<Collection*, int> m_fetched;
+    QHash<SceneObject*, Collection*> m_objectCollection;
+    mutable QHash<Collection*, QHash<SceneObject*, int>> m_objectSlots;  // Lazy slot index per collection
 };
 
 /**
@@ -74,7 +133,7 @@ public:
     Collection* createCollection(const QString& name, Collection* parent = nullptr);
     void deleteCollection(Collection* collection);
 
-    // Tree refresh
+    // Full model reset (structural edits update the tree incrementally)
     void rebuildTree();
 
 signals:
@@ -90,25 +149,17 @@ private slots:
     void onItemDropped(const QString& itemUuid, const QString& targetCollectionUuid, int itemType);
 
     // ObjectManager signals
-    void onObjectAdded(SceneObject* object);
-    void onObjectRemoved(SceneObject* object);
+    void onObjectsAdded(const QVector<SceneObject*>& objects);
+    void onObjectsRemoved(const QVector<SceneObject*>& objects);
 
 private:
     void setupUI();
     void setupConnections();
     void createContextMenu(const QPoint& pos);
 
-    // Tree building
-    void addCollectionToTree(Collection* collection, QStandardItem* parentItem);
-    void addObjectToTree(SceneObject* object, QStandardItem* parentItem);
-
-    QStandardItem* findItemByObject(SceneObject* object);
-    QStandardItem* findItemByCollection(Collection* collection);
-
     // UUID lookup helpers
     Collection* findCollectionByUuid(const QString& uuidStr, Collection* root = nullptr);
     SceneObject* findObjectByUuid(const QString& uuidStr);
-    void removeObjectFromAllCollections(SceneObject* object, Collection* root);
     bool isDescendantOf(Collection* potential, Collection* ancestor);
 
     // UI components
@@ -7,6 +7,7 @@
 #include <QWheelEvent>
 #include <QKeyEvent>
 #include <QVector3D>
+#include <QRect>
 
 class Custom3DWindow : public Qt3DExtras::Qt3DWindow
 {
@@ -29,6 +30,9 @@ signals:
     void keyReleased(int key);
     void mouseLookRequested(int deltaX, int deltaY);
     void flyModeToggleRequested();
+    void leftClicked(const QPoint& pos, Qt::KeyboardModifiers modifiers);  // Selection click
+    void rectangleSelected(const QRect& rect, Qt::KeyboardModifiers modifiers);  // Left-button drag
+    void pointerPressed(const QPoint& pos);  // Any button or wheel; before the signals above
 
 protected:
     void mousePressEvent(QMouseEvent *event) override;
@@ -46,6 +50,11 @@ private:
     bool m_orbiting;
     bool m_panning;
     bool m_flyMode;  // Track if fly mode is active for mouse capture
+
+    // Left button: click, or rectangle once dragged past the drag distance
+    bool m_leftPressed;
+    bool m_rectDragging;
+    QPoint m_leftPressPos;
 };
 
 #endif // CUSTOM3DWINDOW_H
\ No newline at end of file
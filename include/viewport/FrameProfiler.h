@@ -0,0 +1,107 @@
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <memory>
+
+class ViewCuller;
+
+namespace Qt3DCore {
+    class QEntity;
+}
+
+namespace Qt3DLogic {
+    class QFrameAction;
+}
+
+/**
+ * @brief Per-frame viewport statistics and CSV tracing
+ *
+ * Samples once per Qt3D frame (QFrameAction) while running: frame interval
+ * and smoothed FPS, CPU time of the main (frontend) thread during the
+ * frame, drawn objects and triangles as estimated by the ViewCuller,
+ * bytes handed to Qt3D buffers (RenderCounters) and the number of
+ * entities in the scene graph.
+ *
+ * With the on-demand render policy most Qt3D frames draw nothing, so
+ * while the profiler runs the viewport renders continuously (see
+ * runningChanged()) and every sample is a rendered frame.
+ *
+ * The CPU time is the main thread's own CPU clock, so Qt3D's render and
+ * job threads and solver runs do not count. GPU time is not reported:
+ * Qt3D submits on its render thread and exposes no timer queries. The
+ * object and triangle counts are the culler's bookkeeping (levels of
+ * detail, one draw per view), not what Qt3D actually submitted.
+ *
+ * Inactive by default; the frame action is disabled then and the profiler
+ * costs nothing. A running trace keeps it running.
+ */
+class FrameProfiler : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Sample {
+        qint64 frame = 0;
+        double timeMs = 0.0;        // Since profiling started
+        double frameMs = 0.0;       // Interval since the previous frame
+        double fps = 0.0;           // Smoothed
+        double cpuMs = 0.0;         // Main-thread CPU time since the previous frame
+        int estimatedObjects = 0;   // Drawn objects per view (ViewCuller estimate)
+        qint64 estimatedTriangles = 0;
+        qint64 uploadedBytes = 0;
+        int entityCount = 0;
+    };
+
+    // viewCuller may be null (no object or triangle estimates)
+    FrameProfiler(Qt3DCore::QEntity* rootEntity, ViewCuller* viewCuller, QObject* parent = nullptr);
+    ~FrameProfiler();
+
+    void setActive(bool active);
+    bool isActive() const { return m_active; }
+
+    // Sampling frames: active or tracing
+    bool isRunning() const { return m_active || isTracing(); }
+
+    const Sample& lastSample() const { return m_sample; }
+
+    // Write one CSV row per frame until stopTrace(); false if the file
+    // cannot be opened
+    bool startTrace(const QString& filePath);
+    void stopTrace();
+    bool isTracing() const { return m_traceFile != nullptr; }
+
+    static QString csvHeader();
+    static QString toCsv(const Sample& sample);
+
+signals:
+    void sampleReady(const FrameProfiler::Sample& sample);
+
+    // The viewport should render every frame while running
+    void runningChanged(bool running);
+
+private:
+    void onFrame();
+    void updateFrameAction();
+    void resetTiming();
+
+    Qt3DCore::QEntity* m_rootEntity;
+    ViewCuller* m_viewCuller;
+    Qt3DCore::QEntity* m_frameEntity;
+    Qt3DLogic::QFrameAction* m_frameAction;
+
+    bool m_active;
+    Sample m_sample;
+    QElapsedTimer m_clock;      // Since profiling started
+    qint64 m_lastFrameNs;
+    qint64 m_lastCpuNs;         // Main-thread CPU clock at the previous frame
+    qint64 m_lastEntityCountNs;
+
+    std::unique_ptr<QFile> m_traceFile;
+    QTextStream m_traceStream;
+};
+
+#endif // FRAMEPROFILER_H
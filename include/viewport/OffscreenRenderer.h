@@ -0,0 +1,117 @@
+#ifndef OFFSCREENRENDERER_H
+#define OFFSCREENRENDERER_H
+
+#include <QObject>
+#include <QVector>
+#include <QColor>
+#include <QSize>
+#include <QString>
+#include <QImage>
+#include <memory>
+
+class ObjectManager;
+class ViewportController;
+class QOffscreenSurface;
+
+namespace Qt3DCore {
+    class QAspectEngine;
+    class QEntity;
+}
+
+namespace Qt3DRender {
+    class QCamera;
+    class QClearBuffers;
+    class QRenderCapture;
+    class QRenderCaptureReply;
+    class QRenderSurfaceSelector;
+    class QTexture2D;
+}
+
+/**
+ * @brief Renders a scene to images without a window
+ *
+ * Owns its own Qt3D aspect engine, an offscreen surface and a frame graph
+ * that draws the forward techniques into a texture target and captures
+ * it. Works under the offscreen QPA platform or Xvfb, so it runs on CI
+ * machines and servers.
+ *
+ * Populate the scene through objectManager(), then queue jobs. Each job
+ * sets a camera preset framed on the scene bounds and a resolution. Jobs
+ * render one after another on the engine's render thread while finished
+ * images are encoded and written on the thread pool, overlapping I/O with
+ * the next render. Independent renderers (each with its own scene) run
+ * fully in parallel.
+ */
+class OffscreenRenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum View {
+        Isometric,
+        Front,
+        Back,
+        Left,
+        Right,
+        Top,
+        Bottom
+    };
+
+    struct Job {
+        View view = Isometric;
+        QSize size = QSize(1024, 768);
+        QString filePath;  // Empty: only emit imageReady()
+    };
+
+    explicit OffscreenRenderer(QObject* parent = nullptr);
+    ~OffscreenRenderer();
+
+    ObjectManager* objectManager() const { return m_objectManager.get(); }
+    ViewportController* controller() const { return m_controller.get(); }
+    Qt3DRender::QCamera* camera() const { return m_camera; }
+
+    void setBackgroundColor(const QColor& color);
+
+    // Queue jobs; finished() follows once all queued images are written
+    void render(const QVector<Job>& jobs);
+    bool isBusy() const { return m_busy; }
+
+    // One job per view, written as <directory>/<baseName>_<view>.png
+    static QVector<Job> viewJobs(const QString& directory, const QString& baseName,
+                                 const QVector<View>& views, const QSize& size);
+    static QString viewName(View view);
+    static bool viewFromName(const QString& name, View* view);
+
+signals:
+    void imageReady(const OffscreenRenderer::Job& job, const QImage& image);
+    void jobFinished(const OffscreenRenderer::Job& job, bool written);
+    void finished();
+
+private:
+    void buildFrameGraph(Qt3DCore::QEntity* root);
+    void setupLighting(Qt3DCore::QEntity* root);
+    void startNextJob();
+    void onCaptureCompleted(Qt3DRender::QRenderCaptureReply* reply);
+    void onJobWritten(const Job& job, bool written);
+
+    std::unique_ptr<QOffscreenSurface> m_surface;
+    std::unique_ptr<Qt3DCore::QAspectEngine> m_engine;
+    Qt3DCore::QEntity* m_root;  // Owned by the engine
+    Qt3DCore::QEntity* m_sceneRoot;
+    Qt3DRender::QCamera* m_camera;
+    std::unique_ptr<ViewportController> m_controller;
+    std::unique_ptr<ObjectManager> m_objectManager;
+
+    Qt3DRender::QRenderSurfaceSelector* m_surfaceSelector;
+    Qt3DRender::QClearBuffers* m_clearBuffers;
+    Qt3DRender::QRenderCapture* m_capture;
+    Qt3DRender::QTexture2D* m_colorTexture;
+    Qt3DRender::QTexture2D* m_depthTexture;
+
+    QVector<Job> m_queue;
+    Job m_currentJob;
+    bool m_busy;
+    int m_pendingWrites;
+};
+
+#endif // OFFSCREENRENDERER_H
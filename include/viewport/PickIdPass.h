@@ -0,0 +1,133 @@
+#ifndef PICKIDPASS_H
+#define PICKIDPASS_H
+
+#include <QObject>
+#include <QVector>
+#include <QHash>
+#include <QRect>
+#include <QSize>
+#include <QPointer>
+
+class SceneObject;
+class ObjectManager;
+
+namespace Qt3DCore {
+    class QEntity;
+}
+
+namespace Qt3DRender {
+    class QCamera;
+    class QCameraSelector;
+    class QEffect;
+    class QFrameGraphNode;
+    class QGeometryRenderer;
+    class QMaterial;
+    class QParameter;
+    class QRenderCapture;
+    class QRenderCaptureReply;
+    class QScissorTest;
+    class QTexture2D;
+    class QViewport;
+}
+
+namespace Qt3DExtras {
+    class Qt3DWindow;
+}
+
+/**
+ * @brief GPU picking through an offscreen ID render pass
+ *
+ * Adds a frame graph branch that renders the scene into an offscreen
+ * RGBA8 target using techniques tagged renderingStyle=pickId. Each pixel
+ * holds the 24-bit SceneObject::pickId() of the front-most object. While
+ * an Edit Mode object is set, that object writes its triangle index + 1
+ * instead and every other object writes 0, so faces can be picked.
+ *
+ * A request renders only the requested region (scissored) and reads back
+ * just that region with QRenderCapture. The result arrives asynchronously
+ * through pickCompleted(). The branch is disabled while no request is
+ * pending, so it costs nothing between clicks.
+ *
+ * Objects with their own renderer get a hidden child entity that shares
+ * the renderer and carries the ID material. Attached instances are drawn
+ * by their InstancedObject's pickId technique from the instance buffer.
+ */
+class PickIdPass : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Result {
+        QRect rect;                          // Window coordinates, as requested
+        QVector<SceneObject*> objects;       // Distinct objects, nearest to the centre first
+        QPointer<SceneObject> editObject;    // Object whose faces were picked (Edit Mode)
+        QVector<int> faces;                  // Distinct stable face indices of editObject
+    };
+
+    PickIdPass(Qt3DExtras::Qt3DWindow* window, ObjectManager* objectManager, QObject *parent = nullptr);
+    ~PickIdPass();
+
+    // Queue a pick of a window-space region; returns a request id for
+    // pickCompleted(), or -1 if the region is outside the window
+    int requestPick(const QRect& windowRect);
+
+    // Camera and window area (normalized, as QViewport) picks are rendered
+    // from; the whole window with the window's camera by default
+    void setView(Qt3DRender::QCamera* camera, const QRectF& normalizedRect);
+
+    // Object picked for faces (Edit Mode), nullptr to pick objects
+    void setEditObject(SceneObject* object);
+    SceneObject* editObject() const { return m_editObject; }
+
+signals:
+    void pickCompleted(int requestId, const PickIdPass::Result& result);
+
+private slots:
+    void onObjectsAdded(const QVector<SceneObject*>& objects);
+    void onObjectsRemoved(const QVector<SceneObject*>& objects);
+    void updateTargetSize();
+
+private:
+    struct Request {
+        int id;
+        QRect rect;    // Window coordinates
+        QRect glRect;  // Target pixels, origin bottom-left
+        bool pickFaces;
+        QPointer<SceneObject> editObject;
+    };
+
+    // Hidden entity drawing an object into the ID target
+    struct IdEntity {
+        Qt3DCore::QEntity* entity = nullptr;
+        QPointer<Qt3DRender::QGeometryRenderer> renderer;  // Shared renderers may go away first
+    };
+
+    void buildFrameGraph();
+    void syncIdEntity(SceneObject* object);
+    void onCaptureCompleted(Qt3DRender::QRenderCaptureReply* reply);
+    void updateScissor();
+
+    Qt3DExtras::Qt3DWindow* m_window;
+    ObjectManager* m_objectManager;
+
+    // Frame graph branch and its offscreen target
+    Qt3DRender::QFrameGraphNode* m_branch;
+    Qt3DRender::QViewport* m_viewport;
+    Qt3DRender::QCameraSelector* m_cameraSelector;
+    Qt3DRender::QRenderCapture* m_capture;
+    Qt3DRender::QScissorTest* m_scissor;
+    Qt3DRender::QTexture2D* m_colorTexture;
+    Qt3DRender::QTexture2D* m_depthTexture;
+    Qt3DRender::QParameter* m_editObjectParameter;
+    Qt3DRender::QEffect* m_idEffect;
+    QSize m_targetSize;
+
+    QHash<quint32, SceneObject*> m_objectsByPickId;
+    QHash<SceneObject*, IdEntity> m_idEntities;
+    QPointer<SceneObject> m_editObject;
+
+    QHash<Qt3DRender::QRenderCaptureReply*, Request> m_pending;
+    int m_nextRequestId;
+};
+
+#endif // PICKIDPASS_H
@@ -0,0 +1,94 @@
+#ifndef VIEWCULLER_H
+#define VIEWCULLER_H
+
+#include <QObject>
+#include <QSize>
+#include <QVector>
+#include <QPointer>
+
+class SceneObject;
+class ObjectManager;
+class BoundingBox;
+
+namespace Qt3DRender {
+    class QCamera;
+}
+
+/**
+ * @brief Frustum culling and level-of-detail selection for scene objects
+ *
+ * After a camera, a viewport or an object's bounds change, tests the
+ * cached world bounds of every object drawn by its own renderer against
+ * the frustum of each view and disables the ones outside all of them
+ * (SceneObject::setCulled), so Qt3D does not process them at all. Views
+ * share the scene's entities, so visible objects get the coarsest level
+ * of detail whose geometric error projects to at most lodPixelError
+ * pixels in every view that sees them; large meshes have their LOD chain
+ * requested on first sight.
+ *
+ * Updates are coalesced: any number of changes in one event loop pass
+ * cost one culling pass. Instances drawn by an InstancedObject are left
+ * to the group and counted as drawn.
+ */
+class ViewCuller : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        int drawnObjects = 0;
+        int culledObjects = 0;
+        qint64 drawnTriangles = 0;       // At the selected levels of detail, per view
+        qint64 fullDetailTriangles = 0;  // Drawn objects at full detail
+        qint64 culledTriangles = 0;      // At full detail
+    };
+
+    // A camera rendering the scene into a viewport of the given pixel size
+    struct View {
+        Qt3DRender::QCamera* camera = nullptr;
+        QSize viewportSize;
+    };
+
+    explicit ViewCuller(ObjectManager* objectManager, QObject* parent = nullptr);
+
+    // Views currently drawn; objects outside every view are culled
+    void setViews(const QVector<View>& views);
+    const QVector<View>& views() const { return m_views; }
+
+    // Disabled: every object is drawn at full detail
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    // Largest projected geometric error allowed for a simplified level
+    void setLodPixelError(float pixels);
+    float lodPixelError() const { return m_lodPixelError; }
+
+    // Object being edited: always drawn at full detail, never simplified
+    void setEditObject(SceneObject* object);
+
+    const Stats& stats() const { return m_stats; }
+
+public slots:
+    void scheduleUpdate();
+
+signals:
+    void statsChanged(const ViewCuller::Stats& stats);
+
+private slots:
+    void onObjectsAdded(const QVector<SceneObject*>& objects);
+    void onObjectsRemoved(const QVector<SceneObject*>& objects);
+
+private:
+    void update();
+    int selectLod(const SceneObject* object, const BoundingBox& bounds, const View& view) const;
+
+    ObjectManager* m_objectManager;
+    QPointer<SceneObject> m_editObject;
+    QVector<View> m_views;
+    bool m_enabled;
+    float m_lodPixelError;
+    bool m_updatePending;
+    Stats m_stats;
+};
+
+#endif // VIEWCULLER_H
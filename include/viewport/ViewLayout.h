@@ -0,0 +1,111 @@
+#ifndef VIEWLAYOUT_H
+#define VIEWLAYOUT_H
+
+#include <QObject>
+#include <QColor>
+#include <QPoint>
+#include <QRect>
+#include <memory>
+#include <vector>
+
+class ViewportController;
+
+namespace Qt3DCore {
+    class QEntity;
+}
+
+namespace Qt3DRender {
+    class QCamera;
+    class QClearBuffers;
+    class QFrameGraphNode;
+    class QLayer;
+    class QViewport;
+}
+
+namespace Qt3DExtras {
+    class Qt3DWindow;
+}
+
+/**
+ * @brief Single, split and quad views of one scene in one window
+ *
+ * Replaces the window's default forward renderer with a frame graph that
+ * clears once and then draws the scene graph once per pane, each through
+ * its own viewport rectangle and camera. All panes render the same
+ * entities in the same aspect engine, so geometry buffers, materials and
+ * shaders exist once however many views are shown; a pane costs a camera,
+ * a ViewportController and a few frame graph nodes.
+ *
+ * Every pane has an overlay layer. Entities tagged with it (crosshairs,
+ * HUD helpers) are drawn only in that pane: the other panes' branches
+ * discard the layer.
+ *
+ * All MaxPanes panes exist from the start, so cameras keep their position
+ * when the layout changes; panes not in the layout have their branch
+ * disabled. The active pane receives navigation input.
+ */
+class ViewLayout : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Layout {
+        Single,      // Pane 0 fills the window
+        SideBySide,  // Panes 0 | 1
+        Stacked,     // Pane 0 above pane 1
+        Quad         // Panes 0 1 / 2 3
+    };
+
+    static constexpr int MaxPanes = 4;
+
+    ViewLayout(Qt3DExtras::Qt3DWindow* window, Qt3DCore::QEntity* rootEntity, QObject* parent = nullptr);
+    ~ViewLayout();
+
+    void setLayout(Layout layout);
+    Layout layout() const { return m_layout; }
+    int paneCount() const;  // Panes shown by the current layout
+
+    void setActivePane(int index);
+    int activePane() const { return m_activePane; }
+
+    // Shown pane under a window position, or -1
+    int paneAt(const QPoint& windowPos) const;
+
+    // Pane area in window coordinates, and normalized as for QViewport
+    QRect paneRect(int index) const;
+    QRectF normalizedPaneRect(int index) const;
+
+    Qt3DRender::QCamera* camera(int index) const;
+    ViewportController* controller(int index) const;
+    Qt3DRender::QLayer* overlayLayer(int index) const;
+
+    Qt3DRender::QCamera* activeCamera() const { return camera(m_activePane); }
+    ViewportController* activeController() const { return controller(m_activePane); }
+
+    void setClearColor(const QColor& color);
+
+signals:
+    void layoutChanged(ViewLayout::Layout layout);
+    void activePaneChanged(int index);
+    void paneGeometryChanged();  // Pane rectangles or sizes changed
+
+private:
+    struct Pane {
+        Qt3DRender::QCamera* camera = nullptr;
+        std::unique_ptr<ViewportController> controller;
+        Qt3DRender::QLayer* overlayLayer = nullptr;
+        Qt3DRender::QViewport* viewport = nullptr;
+    };
+
+    void buildFrameGraph();
+    void updateGeometry();
+
+    Qt3DExtras::Qt3DWindow* m_window;
+    Qt3DCore::QEntity* m_rootEntity;
+    Qt3DRender::QClearBuffers* m_clearBuffers;
+    std::vector<Pane> m_panes;
+    Layout m_layout;
+    int m_activePane;
+};
+
+#endif // VIEWLAYOUT_H
@@ -2,8 +2,12 @@
 #define VIEWPORT3D_H
 
 #include <QWidget>
+#include <QVector>
+#include <QHash>
 #include <Qt3DCore/QEntity>
 #include <memory>
+#include "viewport/PickIdPass.h"
+#include "viewport/ViewLayout.h"
 
 namespace Qt3DRender {
     class QCamera;
@@ -17,6 +21,10 @@ class AxisEntity;
 class ModeManager;
 class ObjectManager;
 class SelectionManager;
+class ScenePicker;
+class ViewCuller;
+class FrameProfiler;
+class RenderStatsOverlay;
 class SceneObject;
 class CrosshairsOverlay;
 class CrosshairsEntity3D;
@@ -30,19 +38,36 @@ public:
     ~Viewport3D();
 
     Qt3DCore::QEntity* rootEntity() const { return m_rootEntity; }
+    // Camera and controller of the active view
     Qt3DRender::QCamera* camera() const;
-    ViewportController* controller() const { return m_controller.get(); }
+    ViewportController* controller() const;
     ViewportSettings* settings() const;
 
+    // Single, split or quad views of the scene
+    ViewLayout* viewLayout() const { return m_layout.get(); }
+    void setViewLayout(ViewLayout::Layout layout);
+
     // Object system access
     ModeManager* modeManager() const { return m_modeManager.get(); }
     ObjectManager* objectManager() const { return m_objectManager.get(); }
     SelectionManager* selectionManager() const { return m_selectionManager.get(); }
+    ScenePicker* picker() const { return m_picker.get(); }
+    PickIdPass* pickIdPass() const { return m_pickIdPass.get(); }
+    ViewCuller* viewCuller() const { return m_viewCuller.get(); }
+    FrameProfiler* frameProfiler() const { return m_frameProfiler.get(); }
+
+    // FPS / frame time / draw call readout (profiles only while shown)
+    void setStatsOverlayVisible(bool visible);
+    bool isStatsOverlayVisible() const;
 
     // Convenience methods
     void createBox();
     void deleteSelected();
 
+    // Fit the camera to cached scene / selection bounds (Home, numpad .)
+    void frameAll();
+    void frameSelected();
+
 signals:
     void entitySelected(Qt3DCore::QEntity *entity);
     void faceSelected(int faceIndex);
@@ -55,9 +80,15 @@ private slots:
     void onOrbitRequested(int deltaX, int deltaY);
     void onPanRequested(int deltaX, int deltaY);
     void onZoomRequested(float delta);
-    void onObjectClicked(SceneObject* object);
-    void onObjectAdded(SceneObject* object);
-    void onFlyModeToggled(bool active);
+    void onViewportClicked(const QPoint& pos, Qt::KeyboardModifiers modifiers);
+    void onRectangleSelected(const QRect& rect, Qt::KeyboardModifiers modifiers);
+    void onPickCompleted(int requestId, const PickIdPass::Result& result);
+    void updatePickEditObject();
+    void onKeyPressed(int key);
+    void onPointerPressed(const QPoint& pos);
+    void onActivePaneChanged(int index);
+    void updateViews();
+    void applyRenderPolicy();
 
 private:
     void setupScene();
@@ -67,19 +98,36 @@ private:
     void setupGrid();
     void setupAxis();
     void setupCrosshairs();
+    void onFlyModeToggled(int pane, bool active);
+
+    // Edit Mode: turn picked faces into the current element selection
+    void selectPickedElements(const PickIdPass::Result& result, bool isRectangle, bool extend);
+    QPointF projectToView(const QVector3D& worldPos) const;
+
+    // GPU picks in flight: request id -> how to apply the result
+    struct PendingPick {
+        bool isRectangle;
+        Qt::KeyboardModifiers modifiers;
+    };
+    QHash<int, PendingPick> m_pendingPicks;
 
     Custom3DWindow *m_view;
     Qt3DCore::QEntity *m_rootEntity;
 
-    std::unique_ptr<ViewportController> m_controller;
+    std::unique_ptr<ViewLayout> m_layout;
     std::unique_ptr<ModeManager> m_modeManager;
     std::unique_ptr<ObjectManager> m_objectManager;
     std::unique_ptr<SelectionManager> m_selectionManager;
+    std::unique_ptr<ScenePicker> m_picker;
+    std::unique_ptr<PickIdPass> m_pickIdPass;
+    std::unique_ptr<ViewCuller> m_viewCuller;
+    std::unique_ptr<FrameProfiler> m_frameProfiler;
 
     GridEntity *m_grid;
     AxisEntity *m_axis;
     CrosshairsOverlay *m_crosshairs;  // Old widget-based (doesn't work with createWindowContainer)
-    CrosshairsEntity3D *m_crosshairs3D;  // New Qt3D-based crosshairs
+    QVector<CrosshairsEntity3D*> m_crosshairs3D;  // New Qt3D-based crosshairs, one per view
+    RenderStatsOverlay *m_statsOverlay;
 };
 
 #endif // VIEWPORT3D_H
\ No newline at end of file
@@ -4,8 +4,10 @@
 #include <QObject>
 #include <QVector3D>
 #include <QPoint>
+#include <QSize>
 #include <QSet>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <memory>
 
 namespace Qt3DRender {
@@ -20,6 +22,8 @@ namespace Qt3DInput {
 }
 
 class ViewportSettings;
+class ScenePicker;
+class BoundingBox;
 
 class ViewportController : public QObject
 {
@@ -47,7 +51,10 @@ public:
     void pan(const QPoint &pos);
     void zoom(float delta);
     void focusOnPoint(const QVector3D &point);
-    void frameAll();
+
+    // Orbit around the centre of bounds at the distance that fits them in
+    // view; empty bounds reset to the origin
+    void frameBounds(const BoundingBox &bounds);
 
     // Camera presets (numpad views like Blender)
     void viewFront();  // Numpad 1
@@ -56,9 +63,17 @@ public:
     void viewBack();   // Ctrl+Numpad 1
     void viewLeft();   // Ctrl+Numpad 3
     void viewBottom(); // Ctrl+Numpad 7
+    void viewIsometric(); // Startup view, from (+X, +Y, +Z)
 
     ViewportSettings* settings() const { return m_settings.get(); }
 
+    // World point under a widget position: the nearest picked surface,
+    // else the ground plane (y = 0), else the plane through the orbit
+    // target facing the camera
+    QVector3D screenToWorld(const QPoint &screenPos) const;
+    void setPicker(ScenePicker *picker) { m_picker = picker; }
+    void setViewportSize(const QSize &size) { m_viewportSize = size; }
+
     // Fly mode controls
     void toggleFlyMode();
     bool isFlyModeActive() const { return m_flyModeActive; }
@@ -76,12 +91,14 @@ public:
 
 private:
     void updateCameraPosition();
-    void updateFlyCamera();  // Update camera for fly mode
-    void updateFlyCameraOrientation();  // Update camera orientation immediately (for mouse look)
-    QVector3D screenToWorld(const QPoint &screenPos);
+    void updateFlyCamera();  // Apply coalesced look/move input for one frame
+    void scheduleFlyUpdate();  // Run updateFlyCamera once on the next event loop pass
+    bool hasFlyMovementKeys() const;
 
     Qt3DRender::QCamera *m_camera;
     std::unique_ptr<ViewportSettings> m_settings;
+    ScenePicker *m_picker;  // Not owned; may be null
+    QSize m_viewportSize;
 
     NavigationMode m_navigationMode;
 
@@ -104,7 +121,10 @@ private:
     // Fly mode state
     bool m_flyModeActive;
     QSet<int> m_pressedKeys;  // Track currently pressed keys
-    QTimer *m_flyModeTimer;   // Timer for continuous movement
+    QTimer *m_flyModeTimer;   // Paces movement while keys are held
+    QElapsedTimer m_flyClock; // Real time since the last fly update
+    QPoint m_pendingLook;     // Mouse-look delta not yet applied
+    bool m_flyUpdatePending;
     float m_flySpeed;         // Movement speed in units/second
     float m_flyMouseSensitivity; // Mouse look sensitivity
 
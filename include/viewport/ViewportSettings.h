@@ -13,8 +13,15 @@ class ViewportSettings : public QObject
     Q_PROPERTY(float gridSize READ gridSize WRITE setGridSize NOTIFY gridSizeChanged)
     Q_PROPERTY(int gridDivisions READ gridDivisions WRITE setGridDivisions NOTIFY gridDivisionsChanged)
     Q_PROPERTY(float axisLength READ axisLength WRITE setAxisLength NOTIFY axisLengthChanged)
+    Q_PROPERTY(RenderPolicy renderPolicy READ renderPolicy WRITE setRenderPolicy NOTIFY renderPolicyChanged)
 
 public:
+    enum RenderPolicy {
+        Continuous,  // Render every frame (vsync-limited)
+        OnDemand     // Render only when the scene, camera or selection changes
+    };
+    Q_ENUM(RenderPolicy)
+
     explicit ViewportSettings(QObject *parent = nullptr);
 
     // Grid settings
@@ -56,6 +63,17 @@ public:
     float zoomSensitivity() const { return m_zoomSensitivity; }
     void setZoomSensitivity(float sensitivity) { m_zoomSensitivity = sensitivity; }
 
+    // Rendering
+    RenderPolicy renderPolicy() const { return m_renderPolicy; }
+    void setRenderPolicy(RenderPolicy policy);
+
+    // Frustum culling and LOD (see ViewCuller)
+    bool viewCulling() const { return m_viewCulling; }
+    void setViewCulling(bool enabled) { m_viewCulling = enabled; }
+
+    float lodPixelError() const { return m_lodPixelError; }
+    void setLodPixelError(float pixels) { m_lodPixelError = pixels; }
+
     // Background
     QColor backgroundColor() const { return m_backgroundColor; }
     void setBackgroundColor(const QColor &color);
@@ -77,6 +95,7 @@ signals:
     void gridDivisionsChanged();
     void axisLengthChanged();
     void backgroundColorChanged();
+    void renderPolicyChanged();
 
 private:
     // Grid
@@ -97,6 +116,11 @@ private:
     float m_orbitSensitivity;
     float m_zoomSensitivity;
 
+    // Rendering
+    RenderPolicy m_renderPolicy;
+    bool m_viewCulling;
+    float m_lodPixelError;  // Max projected error of a simplified level
+
     // Background
     QColor m_backgroundColor;
 
@@ -0,0 +1,653 @@
+#include "core/BenchmarkCommand.h"
+#include "solver/SceneTetrahedralizer.h"
+#include "solver/HeatAssembler.h"
+#include "solver/ThermalMaterials.h"
+#include "solver/ThermalSolver.h"
+#include "solver/ConjugateGradient.h"
+#include "scene/ObjectManager.h"
+#include "scene/BoxObject.h"
+#include "scene/ScenePicker.h"
+#include "mesh/MeshData.h"
+#include "mesh/MeshBVH.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QThread>
+#include <QTextStream>
+#include <QLoggingCategory>
+#include <QDebug>
+#include <Qt3DCore/QEntity>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+
+namespace {
+
+enum Material { Concrete = 0, Brick = 1, Insulation = 2, Soil = 3 };
+
+SceneTetrahedralizer::Block block(float x0, float y0, float z0, float x1, float y1, float z1, int materialId)
+{
+    return { BoundingBox(QVector3D(x0, y0, z0), QVector3D(x1, y1, z1)), materialId };
+}
+
+// A 10 x 8 m single-storey house on 2 m of soil: slab, brick walls with
+// exterior insulation, and a concrete roof
+QVector<SceneTetrahedralizer::Block> houseBlocks()
+{
+    const float w = 10.0f, d = 8.0f, h = 3.0f;
+    const float wall = 0.3f, insulation = 0.15f, slab = 0.25f;
+    const float ground = 2.0f, margin = 1.0f;
+    return {
+        block(-margin, -ground, -margin, w + margin, 0, d + margin, Soil),
+        block(0, 0, 0, w, slab, d, Concrete),
+        block(0, slab, 0, w, slab + h, wall, Brick),
+        block(0, slab, d - wall, w, slab + h, d, Brick),
+        block(0, slab, wall, wall, slab + h, d - wall, Brick),
+        block(w - wall, slab, wall, w, slab + h, d - wall, Brick),
+        block(-insulation, 0, -insulation, w + insulation, slab + h, 0, Insulation),
+        block(-insulation, 0, d, w + insulation, slab + h, d + insulation, Insulation),
+        block(-insulation, 0, 0, 0, slab + h, d, Insulation),
+        block(w, 0, 0, w + insulation, slab + h, d, Insulation),
+        block(-insulation, slab + h, -insulation, w + insulation, slab + h + slab, d + insulation, Concrete),
+    };
+}
+
+// A box turned about the vertical axis, as a closed triangle surface
+SceneTetrahedralizer::Block rotatedBox(const QVector3D& centre, const QVector3D& size, double degrees,
+                                       int materialId)
+{
+    const double c = std::cos(degrees * 3.14159265358979323846 / 180.0);
+    const double s = std::sin(degrees * 3.14159265358979323846 / 180.0);
+    QVector3D corners[8];
+    SceneTetrahedralizer::Block result;
+    for (int corner = 0; corner < 8; ++corner) {
+        const QVector3D local(((corner & 1) ? 0.5f : -0.5f) * size.x(), ((corner & 2) ? 0.5f : -0.5f) * size.y(),
+                              ((corner & 4) ? 0.5f : -0.5f) * size.z());
+        corners[corner] = centre + QVector3D(float(c * local.x() + s * local.z()), local.y(),
+                                             float(-s * local.x() + c * local.z()));
+        result.bounds.expand(corners[corner]);
+    }
+    // Two triangles per side, corner bits as in the Kuhn split
+    const int quads[6][4] = { { 0, 2, 6, 4 }, { 1, 5, 7, 3 }, { 0, 4, 5, 1 },
+                              { 2, 3, 7, 6 }, { 0, 1, 3, 2 }, { 4, 6, 7, 5 } };
+    for (const auto& quad : quads) {
+        for (int i : { 0, 1, 2, 0, 2, 3 }) {
+            result.triangles.append(corners[quad[i]]);
+        }
+    }
+    result.materialId = materialId;
+    return result;
+}
+
+// A UV sphere with the given number of segments around and rings from
+// pole to pole
+SceneTetrahedralizer::Block sphere(const QVector3D& centre, double radius, int segments, int rings,
+                                   int materialId)
+{
+    auto point = [&](int ring, int segment) {
+        const double polar = 3.14159265358979323846 * ring / rings;
+        const double azimuth = 2.0 * 3.14159265358979323846 * segment / segments;
+        return centre + QVector3D(float(radius * std::sin(polar) * std::cos(azimuth)), float(radius * std::cos(polar)),
+                                  float(radius * std::sin(polar) * std::sin(azimuth)));
+    };
+    SceneTetrahedralizer::Block result;
+    for (int ring = 0; ring < rings; ++ring) {
+        for (int segment = 0; segment < segments; ++segment) {
+            const QVector3D a = point(ring, segment), b = point(ring, segment + 1);
+            const QVector3D c = point(ring + 1, segment + 1), d = point(ring + 1, segment);
+            // The pole rings collapse to one triangle per segment
+            if (ring > 0) {
+                result.triangles << a << b << c;
+            }
+            if (ring < rings - 1) {
+                result.triangles << a << c << d;
+            }
+        }
+    }
+    for (const QVector3D& corner : std::as_const(result.triangles)) {
+        result.bounds.expand(corner);
+    }
+    result.materialId = materialId;
+    return result;
+}
+
+// Comma-separated positive integers; empty on any invalid entry
+QVector<int> positiveCounts(const QString& text)
+{
+    QVector<int> counts;
+    for (const QString& part : text.split(',', Qt::SkipEmptyParts)) {
+        const int n = part.trimmed().toInt();
+        if (n <= 0) {
+            return {};
+        }
+        counts.append(n);
+    }
+    return counts;
+}
+
+QVector<int> threadCounts(const QString& text)
+{
+    QVector<int> counts;
+    if (text.isEmpty()) {
+        // Powers of two up to the core count, and the core count itself
+        const int cores = QThread::idealThreadCount();
+        for (int n = 1; n < cores; n *= 2) {
+            counts.append(n);
+        }
+        counts.append(cores);
+        return counts;
+    }
+    return positiveCounts(text);
+}
+
+bool parsePreconditioners(const QString& text, QVector<Preconditioner::Type>* types)
+{
+    for (const QString& part : text.split(',', Qt::SkipEmptyParts)) {
+        const QString name = part.trimmed().toLower();
+        if (name == "jacobi") {
+            types->append(Preconditioner::Jacobi);
+        } else if (name == "ilu") {
+            types->append(Preconditioner::IncompleteLU);
+        } else if (name == "amg") {
+            types->append(Preconditioner::Multigrid);
+        } else {
+            return false;
+        }
+    }
+    return !types->isEmpty();
+}
+
+// Two load cases on one matrix: the default winter conditions, and a
+// summer case with new ambient temperatures (same K, new right-hand side)
+int benchmarkSolver(const TetMesh& mesh, const QVector<Preconditioner::Type>& types, QTextStream& out)
+{
+    const ThermalMaterials materials;
+    HeatAssembler::BoundaryConditions winter = ThermalSolver::defaultSettings().boundaryConditions;
+    winter.convection.append({ TetMesh::NegX, -10.0, 25.0 });
+    winter.convection.append({ TetMesh::PosX, -10.0, 25.0 });
+    HeatAssembler::BoundaryConditions summer = winter;
+    for (HeatAssembler::Convection& convection : summer.convection) {
+        convection.ambientTemperature += 40.0;
+    }
+
+    const HeatAssembler assembler(mesh, materials);
+    SparseMatrix K = assembler.createMatrix();
+    QVector<double> winterLoad;
+    QVector<double> summerLoad;
+    assembler.assemble(summer, K, summerLoad);
+    assembler.assemble(winter, K, winterLoad);
+    const QVector<double> fixed = assembler.fixedTemperatures(winter);
+    // Fixed temperatures are eliminated in place, once per load vector;
+    // both copies of K end up equal
+    SparseMatrix summerK = K;
+    HeatAssembler::applyFixedTemperatures(fixed, summerK, summerLoad);
+    HeatAssembler::applyFixedTemperatures(fixed, K, winterLoad);
+    out << QString("Matrix: %1 nonzeros, %2 MB\n").arg(K.nonZeros()).arg(K.memoryBytes() / (1024.0 * 1024.0), 0, 'f', 1);
+
+    ConjugateGradient::Settings settings;
+    settings.maxIterations = 100000;
+    out << "preconditioner  setup [s]  iterations  solve [s]  2nd case it.  2nd case [s]\n";
+    int status = 0;
+    for (Preconditioner::Type type : types) {
+        QElapsedTimer timer;
+        timer.start();
+        const std::unique_ptr<Preconditioner> preconditioner = Preconditioner::create(type, K);
+        const double setupSeconds = timer.nsecsElapsed() / 1e9;
+
+        // The second load case reuses the preconditioner as built
+        QVector<double> temperatures;
+        timer.restart();
+        const ConjugateGradient::Result first =
+            ConjugateGradient::solve(K, winterLoad, temperatures, *preconditioner, settings);
+        const double firstSeconds = timer.nsecsElapsed() / 1e9;
+        temperatures.clear();
+        timer.restart();
+        const ConjugateGradient::Result second =
+            ConjugateGradient::solve(summerK, summerLoad, temperatures, *preconditioner, settings);
+        const double secondSeconds = timer.nsecsElapsed() / 1e9;
+
+        out << QString("%1  %2  %3  %4  %5  %6\n")
+                   .arg(preconditioner->name(), -14).arg(setupSeconds, 9, 'f', 3)
+                   .arg(first.iterations, 10).arg(firstSeconds, 9, 'f', 3)
+                   .arg(second.iterations, 12).arg(secondSeconds, 12, 'f', 3);
+        if (type == Preconditioner::Multigrid) {
+            out << "  " << preconditioner->description() << "\n";
+        }
+        out.flush();
+        if (!first.converged || !second.converged) {
+            out << "  WARNING: not converged\n";
+            status = 2;
+        }
+    }
+    return status;
+}
+
+int benchmarkMeshing(const SceneTetrahedralizer::Settings& settings, const QVector<int>& threads, int repeat,
+                     QTextStream& out)
+{
+    // The house plus objects filled from their surface: a chimney turned
+    // 30 degrees on the roof and a spherical tank in the soil, meshed at
+    // half the element size
+    QVector<SceneTetrahedralizer::Block> blocks = houseBlocks();
+    blocks.append(rotatedBox(QVector3D(7.0f, 4.25f, 2.0f), QVector3D(0.6f, 1.5f, 0.6f), 30.0, Brick));
+    SceneTetrahedralizer::Block tank = sphere(QVector3D(10.0f, -1.0f, 4.0f), 0.8, 32, 16, Concrete);
+    tank.elementSize = 0.5 * settings.elementSize;
+    blocks.append(tank);
+
+    out << "threads  nodes  tetrahedra  mesh [s]  speedup  efficiency\n";
+    TetMesh reference;
+    double baseSeconds = 0.0;
+    int baseThreads = 1;
+    bool identical = true;
+
+    for (int threadCount : threads) {
+        QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+
+        double seconds = std::numeric_limits<double>::max();
+        TetMesh mesh;
+        for (int r = 0; r < repeat; ++r) {
+            QElapsedTimer timer;
+            timer.start();
+            mesh = SceneTetrahedralizer::build(blocks, settings);
+            seconds = qMin(seconds, timer.nsecsElapsed() / 1e9);
+        }
+
+        if (reference.nodeCount() == 0) {
+            reference = mesh;
+            baseSeconds = seconds;
+            baseThreads = threadCount;
+        } else if (mesh.tets != reference.tets || mesh.x != reference.x || mesh.y != reference.y ||
+                   mesh.z != reference.z || mesh.elementRegion != reference.elementRegion ||
+                   mesh.boundaryFaces != reference.boundaryFaces || mesh.boundarySide != reference.boundarySide) {
+            identical = false;
+        }
+        const double speedup = baseSeconds / seconds;
+        out << QString("%1  %2  %3  %4  %5  %6%\n")
+                   .arg(threadCount, 7).arg(mesh.nodeCount(), 5).arg(mesh.elementCount(), 10)
+                   .arg(seconds, 8, 'f', 3).arg(speedup, 7, 'f', 2)
+                   .arg(100.0 * speedup * baseThreads / threadCount, 9, 'f', 0);
+        out.flush();
+    }
+
+    out << (identical ? "Meshes identical for all thread counts\n"
+                      : "WARNING: meshes differ between thread counts\n");
+    return identical ? 0 : 2;
+}
+
+int benchmarkAssembly(const TetMesh& mesh, const QVector<int>& threads, int repeat, QTextStream& out)
+{
+    const ThermalMaterials materials;
+    const HeatAssembler::BoundaryConditions conditions = ThermalSolver::defaultSettings().boundaryConditions;
+
+    out << "threads  colours  pattern [s]  assembly [s]  speedup  efficiency\n";
+    // Speedup is relative to the first thread count
+    QVector<double> reference;
+    double baseSeconds = 0.0;
+    int baseThreads = 1;
+    bool identical = true;
+
+    for (int threadCount : threads) {
+        QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+
+        // Best of repeat runs for each stage
+        double patternSeconds = std::numeric_limits<double>::max();
+        double assemblySeconds = std::numeric_limits<double>::max();
+        int colours = 0;
+        QVector<double> values;
+        for (int r = 0; r < repeat; ++r) {
+            QElapsedTimer timer;
+            timer.start();
+            const HeatAssembler assembler(mesh, materials);
+            patternSeconds = qMin(patternSeconds, timer.nsecsElapsed() / 1e9);
+            colours = assembler.colourCount();
+
+            SparseMatrix K = assembler.createMatrix();
+            QVector<double> rhs;
+            timer.restart();
+            assembler.assemble(conditions, K, rhs);
+            assemblySeconds = qMin(assemblySeconds, timer.nsecsElapsed() / 1e9);
+            values = K.values();
+        }
+
+        if (reference.isEmpty()) {
+            reference = values;
+            baseSeconds = assemblySeconds;
+            baseThreads = threadCount;
+        } else if (values != reference) {
+            identical = false;
+        }
+        const double speedup = baseSeconds / assemblySeconds;
+        out << QString("%1  %2  %3  %4  %5  %6%\n")
+                   .arg(threadCount, 7).arg(colours, 7)
+                   .arg(patternSeconds, 11, 'f', 3).arg(assemblySeconds, 12, 'f', 3)
+                   .arg(speedup, 7, 'f', 2).arg(100.0 * speedup * baseThreads / threadCount, 9, 'f', 0);
+        out.flush();
+    }
+
+    out << (identical ? "Matrices identical for all thread counts\n"
+                      : "WARNING: matrices differ between thread counts\n");
+    return identical ? 0 : 2;
+}
+
+// MeshData construction at growing mesh sizes: quad grids of about count
+// faces, one addFace at a time (each creates or finds its four edges),
+// then findEdge over every grid edge. Times are per face / per edge.
+int benchmarkFaces(const QVector<int>& counts, QTextStream& out)
+{
+    out << "faces  edges  add face [us]  find edge [us]\n";
+    int status = 0;
+    for (int count : counts) {
+        const int side = qMax(1, int(std::ceil(std::sqrt(double(count)))));
+        MeshData mesh;
+        QVector<int> vertices;
+        vertices.reserve((side + 1) * (side + 1));
+        for (int j = 0; j <= side; ++j) {
+            for (int i = 0; i <= side; ++i) {
+                vertices.append(mesh.addVertex(QVector3D(i, 0, j)));
+            }
+        }
+        auto vertex = [&](int i, int j) { return vertices[j * (side + 1) + i]; };
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int j = 0; j < side; ++j) {
+            for (int i = 0; i < side; ++i) {
+                mesh.addFace({ vertex(i, j), vertex(i, j + 1), vertex(i + 1, j + 1), vertex(i + 1, j) });
+            }
+        }
+        const double addSeconds = timer.nsecsElapsed() / 1e9;
+
+        int found = 0;
+        timer.restart();
+        for (int j = 0; j <= side; ++j) {
+            for (int i = 0; i < side; ++i) {
+                found += mesh.findEdge(vertex(i, j), vertex(i + 1, j)) >= 0 ? 1 : 0;
+                found += mesh.findEdge(vertex(j, i + 1), vertex(j, i)) >= 0 ? 1 : 0;
+            }
+        }
+        const double findSeconds = timer.nsecsElapsed() / 1e9;
+
+        out << QString("%1  %2  %3  %4\n")
+                   .arg(mesh.faceCount(), 7).arg(mesh.edgeCount(), 7)
+                   .arg(1e6 * addSeconds / mesh.faceCount(), 13, 'f', 3)
+                   .arg(1e6 * findSeconds / mesh.edgeCount(), 14, 'f', 3);
+        out.flush();
+        if (found != mesh.edgeCount() || mesh.edgeCount() != 2 * side * (side + 1)) {
+            out << "  WARNING: edges missing or duplicated\n";
+            status = 2;
+        }
+    }
+    return status;
+}
+
+// ObjectManager registry at growing scene sizes: one-by-one adds, UUID
+// lookups and removals in random order. Times are per operation, so flat
+// columns mean constant cost.
+int benchmarkObjects(const QVector<int>& counts, QTextStream& out)
+{
+    // Objects log their construction and destruction
+    QLoggingCategory::setFilterRules("default.debug=false");
+
+    out << "objects  add [us]  lookup [us]  remove [us]\n";
+    std::mt19937 random(1);
+    int status = 0;
+    for (int count : counts) {
+        Qt3DCore::QEntity root;
+        ObjectManager manager(&root);
+        QVector<SceneObject*> objects;
+        QVector<QUuid> uuids;
+        objects.reserve(count);
+        uuids.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            objects.append(new BoxObject(QVector3D(1, 1, 1), manager.geometryCache(), &root));
+            uuids.append(objects.last()->uuid());
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        for (SceneObject* object : std::as_const(objects)) {
+            manager.addObject(object);
+        }
+        const double addSeconds = timer.nsecsElapsed() / 1e9;
+
+        std::shuffle(uuids.begin(), uuids.end(), random);
+        int found = 0;
+        timer.restart();
+        for (const QUuid& uuid : std::as_const(uuids)) {
+            found += manager.findByUuid(uuid) ? 1 : 0;
+        }
+        const double lookupSeconds = timer.nsecsElapsed() / 1e9;
+
+        std::shuffle(objects.begin(), objects.end(), random);
+        timer.restart();
+        for (SceneObject* object : std::as_const(objects)) {
+            manager.removeObject(object);
+        }
+        const double removeSeconds = timer.nsecsElapsed() / 1e9;
+        // Removed objects are deleted later
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+
+        out << QString("%1  %2  %3  %4\n")
+                   .arg(count, 7).arg(1e6 * addSeconds / count, 8, 'f', 3)
+                   .arg(1e6 * lookupSeconds / count, 11, 'f', 3).arg(1e6 * removeSeconds / count, 11, 'f', 3);
+        out.flush();
+        if (found != count || manager.objectCount() != 0) {
+            out << "  WARNING: lookups or removals failed\n";
+            status = 2;
+        }
+    }
+    return status;
+}
+
+// Nearest hit by testing every object: the reference for ScenePicker
+SceneObject* pickByScan(const QVector<SceneObject*>& objects, const Ray& ray)
+{
+    SceneObject* nearest = nullptr;
+    float distance = std::numeric_limits<float>::max();
+    for (SceneObject* object : objects) {
+        if (!object->worldBounds().intersects(ray, 0.0f, distance)) {
+            continue;
+        }
+        bool invertible = false;
+        const QMatrix4x4 toLocal = object->transformMatrix().inverted(&invertible);
+        MeshBVH::Hit hit;
+        if (invertible && object->meshData()->triangleBVH()->raycast(ray.transformed(toLocal), &hit, distance)) {
+            nearest = object;
+            distance = hit.t;
+        }
+    }
+    return nearest;
+}
+
+// ScenePicker on a grid of boxes of random height, with rays from above one
+// side of the grid. Reports the tree build on the first pick, pick times
+// over many rays, and a pick after one object moved (tree refit). The first
+// rays are checked against a scan over all objects.
+int benchmarkPicking(const QVector<int>& counts, QTextStream& out)
+{
+    const int rayCount = 1000;
+    const int checkedRays = 100;
+    const double budgetMs = 1.0;  // Mean pick time for interactive clicks
+
+    QLoggingCategory::setFilterRules("default.debug=false");
+
+    out << "objects  build [ms]  pick mean [ms]  pick max [ms]  refit + pick [ms]\n";
+    std::mt19937 random(1);
+    int status = 0;
+    for (int count : counts) {
+        Qt3DCore::QEntity root;
+        ObjectManager manager(&root);
+        ScenePicker picker(&manager);
+
+        const int side = qMax(1, int(std::ceil(std::sqrt(double(count)))));
+        std::uniform_real_distribution<float> height(1.0f, 4.0f);
+        QVector<SceneObject*> objects;
+        objects.reserve(count);
+        for (int n = 0; n < count; ++n) {
+            auto* box = new BoxObject(QVector3D(1.0f, height(random), 1.0f), manager.geometryCache(), &root);
+            box->setLocation(QVector3D(2.0f * (n % side), 0.0f, 2.0f * (n / side)));
+            // Mesh trees are built on first use; a live scene has them
+            box->meshData()->triangleBVH();
+            objects.append(box);
+        }
+        manager.addObjects(objects);
+
+        const float extent = 2.0f * side;
+        std::uniform_real_distribution<float> across(0.0f, extent);
+        QVector<Ray> rays;
+        rays.reserve(rayCount);
+        for (int r = 0; r < rayCount; ++r) {
+            const QVector3D origin(across(random), 0.5f * extent + 10.0f, -0.5f * extent - 10.0f);
+            const QVector3D target(across(random), 0.0f, across(random));
+            rays.append(Ray(origin, target - origin));
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        picker.pick(rays.first());
+        const double buildMs = timer.nsecsElapsed() / 1e6;
+
+        QVector<SceneObject*> picked;
+        picked.reserve(rayCount);
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+        for (const Ray& ray : std::as_const(rays)) {
+            timer.restart();
+            picked.append(picker.pick(ray).object);
+            const double ms = timer.nsecsElapsed() / 1e6;
+            totalMs += ms;
+            maxMs = qMax(maxMs, ms);
+        }
+        const double meanMs = totalMs / rayCount;
+
+        int mismatches = 0;
+        for (int r = 0; r < qMin(checkedRays, rayCount); ++r) {
+            mismatches += pickByScan(objects, rays[r]) != picked[r] ? 1 : 0;
+        }
+
+        SceneObject* moved = objects[count / 2];
+        moved->setLocation(moved->location() + QVector3D(0.0f, 0.5f, 0.0f));
+        timer.restart();
+        picker.pick(rays.first());
+        const double refitMs = timer.nsecsElapsed() / 1e6;
+
+        out << QString("%1  %2  %3  %4  %5\n")
+                   .arg(count, 7).arg(buildMs, 10, 'f', 3).arg(meanMs, 14, 'f', 4)
+                   .arg(maxMs, 13, 'f', 4).arg(refitMs, 17, 'f', 3);
+        out.flush();
+        if (mismatches > 0) {
+            out << QString("  WARNING: %1 of %2 picks differ from a full scan\n").arg(mismatches).arg(checkedRays);
+            status = 2;
+        }
+        if (meanMs > budgetMs) {
+            out << QString("  WARNING: mean pick time above %1 ms\n").arg(budgetMs);
+            status = 2;
+        }
+    }
+    return status;
+}
+
+} // namespace
+
+namespace BenchmarkCommand {
+
+bool isRequested(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--benchmark") == 0 || std::strncmp(argv[i], "--benchmark=", 12) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int run(QCoreApplication& app)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measure scene and solver performance on built-in models");
+    parser.addHelpOption();
+    const QCommandLineOption benchmarkOption("benchmark", "Stage to measure: faces, objects, pick, mesh, assembly or solver.",
+                                             "stage");
+    const QCommandLineOption elementSizeOption("element-size", "Largest element edge in m, default 0.1.",
+                                               "h", "0.1");
+    const QCommandLineOption threadsOption("threads", "Comma-separated thread counts, default 1, 2, 4, ... cores.",
+                                           "list");
+    const QCommandLineOption repeatOption("repeat", "Runs per thread count; the best is reported. Default 3.",
+                                          "N", "3");
+    const QCommandLineOption preconditionersOption("preconditioners",
+        "Comma-separated preconditioners for the solver stage: jacobi, ilu, amg. Default all.",
+        "list", "jacobi,ilu,amg");
+    const QCommandLineOption countsOption("counts",
+        "Comma-separated face or object counts for the faces, objects and pick stages. "
+        "Default 1000,10000,100000.",
+        "list", "1000,10000,100000");
+    parser.addOptions({ benchmarkOption, elementSizeOption, threadsOption, repeatOption, preconditionersOption,
+                        countsOption });
+    parser.process(app);
+
+    const QString stage = parser.value(benchmarkOption);
+    const QStringList stages = { "faces", "objects", "pick", "mesh", "assembly", "solver" };
+    if (!stages.contains(stage)) {
+        qWarning() << "Unknown benchmark" << stage;
+        return 1;
+    }
+    const double elementSize = parser.value(elementSizeOption).toDouble();
+    if (elementSize <= 0.0) {
+        qWarning() << "Invalid --element-size" << parser.value(elementSizeOption);
+        return 1;
+    }
+    const QVector<int> threads = threadCounts(parser.value(threadsOption));
+    if (threads.isEmpty()) {
+        qWarning() << "Invalid --threads" << parser.value(threadsOption);
+        return 1;
+    }
+    const int repeat = qMax(1, parser.value(repeatOption).toInt());
+    QVector<Preconditioner::Type> preconditioners;
+    if (!parsePreconditioners(parser.value(preconditionersOption), &preconditioners)) {
+        qWarning() << "Invalid --preconditioners" << parser.value(preconditionersOption);
+        return 1;
+    }
+
+    const QVector<int> counts = positiveCounts(parser.value(countsOption));
+    if (counts.isEmpty()) {
+        qWarning() << "Invalid --counts" << parser.value(countsOption);
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    if (stage == "faces") {
+        return benchmarkFaces(counts, out);
+    }
+    if (stage == "objects") {
+        return benchmarkObjects(counts, out);
+    }
+    if (stage == "pick") {
+        return benchmarkPicking(counts, out);
+    }
+
+    SceneTetrahedralizer::Settings meshSettings;
+    meshSettings.elementSize = elementSize;
+    if (stage == "mesh") {
+        return benchmarkMeshing(meshSettings, threads, repeat, out);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const TetMesh mesh = SceneTetrahedralizer::build(houseBlocks(), meshSettings);
+    out << QString("Mesh: %1 nodes, %2 tetrahedra, %3 MB (%4 s)\n")
+               .arg(mesh.nodeCount()).arg(mesh.elementCount())
+               .arg(mesh.memoryBytes() / (1024.0 * 1024.0), 0, 'f', 1)
+               .arg(timer.elapsed() / 1000.0, 0, 'f', 2);
+
+    if (stage == "solver") {
+        return benchmarkSolver(mesh, preconditioners, out);
+    }
+    return benchmarkAssembly(mesh, threads, repeat, out);
+}
+
+} // namespace BenchmarkCommand
@@ -0,0 +1,138 @@
+#include "core/RenderCommand.h"
+#include "viewport/OffscreenRenderer.h"
+#include "scene/ObjectManager.h"
+#include "scene/SceneFile.h"
+
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QSize>
+#include <QDebug>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+bool parseSize(const QString& text, QSize* size)
+{
+    const QStringList parts = text.toLower().split('x');
+    if (parts.size() != 2) {
+        return false;
+    }
+    bool okW = false;
+    bool okH = false;
+    const int w = parts[0].toInt(&okW);
+    const int h = parts[1].toInt(&okH);
+    if (!okW || !okH || w <= 0 || h <= 0) {
+        return false;
+    }
+    *size = QSize(w, h);
+    return true;
+}
+
+} // namespace
+
+namespace RenderCommand {
+
+bool isRequested(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--render") == 0 || std::strncmp(argv[i], "--render=", 9) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int run(QGuiApplication& app)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Render the scene to images without a window");
+    parser.addHelpOption();
+    const QCommandLineOption renderOption("render", "Write images into <dir>.", "dir");
+    const QCommandLineOption sizeOption("size", "Image size, default 1920x1080.", "WxH", "1920x1080");
+    const QCommandLineOption viewsOption("views", "Comma-separated views: iso, front, back, left, right, top, bottom.",
+                                         "views", "iso,front,right,top");
+    const QCommandLineOption parallelOption("parallel", "Number of renderers working at once, default 1.", "N", "1");
+    const QCommandLineOption nameOption("name", "File name prefix, default 'scene'.", "base", "scene");
+    const QCommandLineOption sceneOption("scene", "Scene file (JSON) to render instead of the default scene.", "file");
+    parser.addOptions({ renderOption, sizeOption, viewsOption, parallelOption, nameOption, sceneOption });
+    parser.process(app);
+
+    QSize size;
+    if (!parseSize(parser.value(sizeOption), &size)) {
+        qWarning() << "Invalid --size" << parser.value(sizeOption) << "(expected WxH)";
+        return 1;
+    }
+
+    QVector<OffscreenRenderer::View> views;
+    for (const QString& name : parser.value(viewsOption).split(',', Qt::SkipEmptyParts)) {
+        OffscreenRenderer::View view;
+        if (!OffscreenRenderer::viewFromName(name.trimmed(), &view)) {
+            qWarning() << "Unknown view" << name;
+            return 1;
+        }
+        views.append(view);
+    }
+    if (views.isEmpty()) {
+        qWarning() << "No views to render";
+        return 1;
+    }
+
+    const QString directory = parser.value(renderOption);
+    if (!QDir().mkpath(directory)) {
+        qWarning() << "Cannot create output directory" << directory;
+        return 1;
+    }
+
+    const QVector<OffscreenRenderer::Job> jobs =
+        OffscreenRenderer::viewJobs(directory, parser.value(nameOption), views, size);
+    const int rendererCount = qBound(1, parser.value(parallelOption).toInt(), int(jobs.size()));
+
+    // Round-robin the jobs over independent renderers
+    std::vector<std::unique_ptr<OffscreenRenderer>> renderers;
+    QVector<QVector<OffscreenRenderer::Job>> batches(rendererCount);
+    for (int i = 0; i < jobs.size(); ++i) {
+        batches[i % rendererCount].append(jobs[i]);
+    }
+
+    int running = rendererCount;
+    int failed = 0;
+    for (int i = 0; i < rendererCount; ++i) {
+        auto renderer = std::make_unique<OffscreenRenderer>();
+        if (parser.isSet(sceneOption)) {
+            QString error;
+            if (!SceneFile::load(parser.value(sceneOption), renderer->objectManager(), &error)) {
+                qWarning() << "Cannot load scene:" << error;
+                return 1;
+            }
+        } else {
+            SceneFile::createDefault(renderer->objectManager());
+        }
+        QObject::connect(renderer.get(), &OffscreenRenderer::jobFinished,
+                         [&failed](const OffscreenRenderer::Job& job, bool written) {
+            if (written) {
+                qDebug() << "Wrote" << job.filePath;
+            } else {
+                ++failed;
+            }
+        });
+        QObject::connect(renderer.get(), &OffscreenRenderer::finished, &app, [&running, &app]() {
+            if (--running == 0) {
+                app.quit();
+            }
+        });
+        renderers.push_back(std::move(renderer));
+    }
+
+    for (int i = 0; i < rendererCount; ++i) {
+        renderers[i]->render(batches[i]);
+    }
+    app.exec();
+
+    renderers.clear();
+    return failed == 0 ? 0 : 2;
+}
+
+} // namespace RenderCommand
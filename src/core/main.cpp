@@ -1,10 +1,26 @@
 #include <QApplication>
 #include <QSurfaceFormat>
+#include <memory>
 #include "ui/MainWindow.h"
+#include "core/RenderCommand.h"
+#include "core/BenchmarkCommand.h"
 
 int main(int argc, char *argv[])
 {
-    QApplication app(argc, argv);
+    // Benchmarks need neither a display nor a window system
+    if (BenchmarkCommand::isRequested(argc, argv)) {
+        QCoreApplication app(argc, argv);
+        return BenchmarkCommand::run(app);
+    }
+
+    // Headless batch rendering needs no widgets (see RenderCommand)
+    const bool headless = RenderCommand::isRequested(argc, argv);
+    std::unique_ptr<QGuiApplication> app;
+    if (headless) {
+        app = std::make_unique<QGuiApplication>(argc, argv);
+    } else {
+        app = std::make_unique<QApplication>(argc, argv);
+    }
 
     // Set application metadata
     QCoreApplication::setOrganizationName("DFD-Engineering");
@@ -20,8 +36,12 @@ int main(int argc, char *argv[])
     format.setSamples(4);
     QSurfaceFormat::setDefaultFormat(format);
 
+    if (headless) {
+        return RenderCommand::run(*app);
+    }
+
     MainWindow window;
     window.show();
 
-    return app.exec();
-}
\ No newline at end of file
+    return app->exec();
+}
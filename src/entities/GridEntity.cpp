@@ -4,19 +4,103 @@
 #include <Qt3DCore/QAttribute>
 #include <Qt3DCore/QBuffer>
 #include <Qt3DRender/QGeometryRenderer>
-#include <Qt3DExtras/QPhongMaterial>
-#include <Qt3DExtras/QPerVertexColorMaterial>
+#include <Qt3DRender/QMaterial>
 #include <Qt3DRender/QEffect>
 #include <Qt3DRender/QTechnique>
 #include <Qt3DRender/QRenderPass>
 #include <Qt3DRender/QShaderProgram>
 #include <Qt3DRender/QGraphicsApiFilter>
+#include <Qt3DRender/QFilterKey>
+#include <Qt3DRender/QParameter>
+#include <Qt3DRender/QBlendEquation>
+#include <Qt3DRender/QBlendEquationArguments>
+#include <Qt3DRender/QDepthTest>
+#include <Qt3DRender/QNoDepthMask>
+#include <Qt3DRender/QCullFace>
 #include <QDebug>
 
+namespace {
+
+const char* const gridVertexShader = R"(
+#version 330 core
+
+in vec3 vertexPosition;
+
+out vec3 worldPosition;
+
+uniform mat4 modelMatrix;
+uniform mat4 viewProjectionMatrix;
+
+void main()
+{
+    vec4 world = modelMatrix * vec4(vertexPosition, 1.0);
+    worldPosition = world.xyz;
+    gl_Position = viewProjectionMatrix * world;
+}
+)";
+
+// Lines are one pixel wide at every level. Level spacing is cellSize * 10^n,
+// with n chosen so the finest drawn cells stay at least minCellPixels wide;
+// the finest level fades out and the next one dims down as n grows, so the
+// transition between levels is continuous.
+const char* const gridFragmentShader = R"(
+#version 330 core
+
+in vec3 worldPosition;
+
+out vec4 fragColor;
+
+uniform vec3 eyePosition;
+uniform vec4 gridColor;
+uniform float cellSize;
+uniform float fadeRadius;
+
+const float minCellPixels = 8.0;
+
+float lineCoverage(vec2 coord, vec2 pixelSize, float spacing)
+{
+    // Distance to the nearest line in pixels, per axis
+    vec2 distance = abs(fract(coord / spacing - 0.5) - 0.5) * spacing / pixelSize;
+    return 1.0 - min(min(distance.x, distance.y), 1.0);
+}
+
+void main()
+{
+    vec2 coord = worldPosition.xz;
+    vec2 pixelSize = max(fwidth(coord), vec2(1e-6));
+
+    float lod = max(0.0, log(length(pixelSize) * minCellPixels / cellSize) / log(10.0) + 1.0);
+    float lodFade = fract(lod);
+    float spacing0 = cellSize * pow(10.0, floor(lod));
+    float spacing1 = spacing0 * 10.0;
+    float spacing2 = spacing1 * 10.0;
+
+    float alpha = max(lineCoverage(coord, pixelSize, spacing2),
+                      max(lineCoverage(coord, pixelSize, spacing1) * (1.0 - 0.6 * lodFade),
+                          lineCoverage(coord, pixelSize, spacing0) * 0.4 * (1.0 - lodFade)));
+
+    // Fade with distance (further when the camera is high up) and at
+    // grazing angles, where even the coarsest lines alias
+    vec3 toEye = eyePosition - worldPosition;
+    float radius = max(fadeRadius, abs(eyePosition.y) * 20.0);
+    alpha *= 1.0 - smoothstep(radius * 0.5, radius, length(toEye));
+    alpha *= smoothstep(0.0, 0.05, abs(normalize(toEye).y));
+
+    if (alpha <= 0.001)
+        discard;
+    fragColor = vec4(gridColor.rgb, gridColor.a * alpha);
+}
+)";
+
+} // namespace
+
 GridEntity::GridEntity(Qt3DCore::QNode *parent)
     : Qt3DCore::QEntity(parent)
     , m_mesh(nullptr)
     , m_material(nullptr)
+    , m_colorParameter(nullptr)
+    , m_cellSizeParameter(nullptr)
+    , m_fadeRadiusParameter(nullptr)
     , m_gridSize(1.0f)
     , m_gridDivisions(20)
     , m_color(128, 128, 128, 100)
@@ -30,7 +114,8 @@ void GridEntity::setGridSize(float size)
 {
     if (!qFuzzyCompare(m_gridSize, size)) {
         m_gridSize = size;
-        createGrid();
+        m_cellSizeParameter->setValue(m_gridSize);
+        updateFadeRadius();
     }
 }
 
@@ -38,7 +123,7 @@ void GridEntity::setGridDivisions(int divisions)
 {
     if (m_gridDivisions != divisions) {
         m_gridDivisions = divisions;
-        createGrid();
+        updateFadeRadius();
     }
 }
 
@@ -46,13 +131,7 @@ void GridEntity::setColor(const QColor &color)
 {
     if (m_color != color) {
         m_color = color;
-        if (m_material) {
-            auto phongMat = qobject_cast<Qt3DExtras::QPhongMaterial*>(m_material);
-            if (phongMat) {
-                phongMat->setDiffuse(m_color);
-                phongMat->setAmbient(m_color);
-            }
-        }
+        m_colorParameter->setValue(m_color);
     }
 }
 
@@ -61,67 +140,26 @@ void GridEntity::setVisible(bool visible)
     setEnabled(visible);
 }
 
-void GridEntity::createGrid()
+void GridEntity::updateFadeRadius()
 {
-    // Remove old components
-    if (m_mesh) {
-        removeComponent(m_mesh);
-        delete m_mesh;
-    }
-    if (m_material) {
-        removeComponent(m_material);
-        delete m_material;
-    }
+    m_fadeRadiusParameter->setValue(qMax(m_gridSize * m_gridDivisions * 0.5f, m_gridSize));
+}
 
-    // Create geometry for grid lines
+void GridEntity::createGrid()
+{
+    // One quad on the ground plane, drawn as a triangle strip
     auto *geometry = new Qt3DCore::QGeometry(this);
 
-    // Calculate grid dimensions
-    float halfSize = (m_gridDivisions * m_gridSize) / 2.0f;
-    int lineCount = m_gridDivisions + 1;
-
-    // Vertices for grid lines (2 vertices per line)
-    QByteArray vertexBytes;
-    vertexBytes.resize(lineCount * 4 * 3 * sizeof(float)); // X and Z lines, 3 floats per vertex
-    float *vertices = reinterpret_cast<float*>(vertexBytes.data());
-
-    int idx = 0;
-
-    // Create lines parallel to X axis
-    for (int i = 0; i < lineCount; ++i) {
-        float z = -halfSize + i * m_gridSize;
-
-        // Start point
-        vertices[idx++] = -halfSize;
-        vertices[idx++] = 0.0f;
-        vertices[idx++] = z;
+    const float vertices[] = {
+        -Extent, 0.0f, -Extent,
+         Extent, 0.0f, -Extent,
+        -Extent, 0.0f,  Extent,
+         Extent, 0.0f,  Extent,
+    };
 
-        // End point
-        vertices[idx++] = halfSize;
-        vertices[idx++] = 0.0f;
-        vertices[idx++] = z;
-    }
-
-    // Create lines parallel to Z axis
-    for (int i = 0; i < lineCount; ++i) {
-        float x = -halfSize + i * m_gridSize;
-
-        // Start point
-        vertices[idx++] = x;
-        vertices[idx++] = 0.0f;
-        vertices[idx++] = -halfSize;
-
-        // End point
-        vertices[idx++] = x;
-        vertices[idx++] = 0.0f;
-        vertices[idx++] = halfSize;
-    }
-
-    // Create vertex buffer
     auto *vertexBuffer = new Qt3DCore::QBuffer(geometry);
-    vertexBuffer->setData(vertexBytes);
+    vertexBuffer->setData(QByteArray(reinterpret_cast<const char*>(vertices), sizeof(vertices)));
 
-    // Create position attribute
     auto *positionAttribute = new Qt3DCore::QAttribute(geometry);
     positionAttribute->setName(Qt3DCore::QAttribute::defaultPositionAttributeName());
     positionAttribute->setVertexBaseType(Qt3DCore::QAttribute::Float);
@@ -129,24 +167,63 @@ void GridEntity::createGrid()
     positionAttribute->setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
     positionAttribute->setBuffer(vertexBuffer);
     positionAttribute->setByteStride(3 * sizeof(float));
-    positionAttribute->setCount(lineCount * 4);
-
+    positionAttribute->setCount(4);
     geometry->addAttribute(positionAttribute);
 
-    // Create geometry renderer
     m_mesh = new Qt3DRender::QGeometryRenderer(this);
     m_mesh->setGeometry(geometry);
-    m_mesh->setPrimitiveType(Qt3DRender::QGeometryRenderer::Lines);
+    m_mesh->setPrimitiveType(Qt3DRender::QGeometryRenderer::TriangleStrip);
+
+    // Material: forward technique only, so the ID pass never draws the grid
+    m_material = new Qt3DRender::QMaterial(this);
+    auto *effect = new Qt3DRender::QEffect(m_material);
+    auto *technique = new Qt3DRender::QTechnique(effect);
+
+    technique->graphicsApiFilter()->setApi(Qt3DRender::QGraphicsApiFilter::OpenGL);
+    technique->graphicsApiFilter()->setProfile(Qt3DRender::QGraphicsApiFilter::CoreProfile);
+    technique->graphicsApiFilter()->setMajorVersion(3);
+    technique->graphicsApiFilter()->setMinorVersion(3);
+
+    auto *filterKey = new Qt3DRender::QFilterKey(technique);
+    filterKey->setName(QStringLiteral("renderingStyle"));
+    filterKey->setValue(QStringLiteral("forward"));
+    technique->addFilterKey(filterKey);
+
+    auto *shader = new Qt3DRender::QShaderProgram(technique);
+    shader->setVertexShaderCode(gridVertexShader);
+    shader->setFragmentShaderCode(gridFragmentShader);
+
+    auto *pass = new Qt3DRender::QRenderPass(technique);
+    pass->setShaderProgram(shader);
+
+    // Blended over the scene; depth tested but not written, visible from below
+    auto *blendArguments = new Qt3DRender::QBlendEquationArguments(pass);
+    blendArguments->setSourceRgba(Qt3DRender::QBlendEquationArguments::SourceAlpha);
+    blendArguments->setDestinationRgba(Qt3DRender::QBlendEquationArguments::OneMinusSourceAlpha);
+    auto *blendEquation = new Qt3DRender::QBlendEquation(pass);
+    blendEquation->setBlendFunction(Qt3DRender::QBlendEquation::Add);
+    auto *depthTest = new Qt3DRender::QDepthTest(pass);
+    depthTest->setDepthFunction(Qt3DRender::QDepthTest::Less);
+    auto *cullFace = new Qt3DRender::QCullFace(pass);
+    cullFace->setMode(Qt3DRender::QCullFace::NoCulling);
+
+    pass->addRenderState(blendArguments);
+    pass->addRenderState(blendEquation);
+    pass->addRenderState(depthTest);
+    pass->addRenderState(new Qt3DRender::QNoDepthMask(pass));
+    pass->addRenderState(cullFace);
+    technique->addRenderPass(pass);
+    effect->addTechnique(technique);
+    m_material->setEffect(effect);
+
+    m_colorParameter = new Qt3DRender::QParameter(QStringLiteral("gridColor"), m_color, m_material);
+    m_cellSizeParameter = new Qt3DRender::QParameter(QStringLiteral("cellSize"), m_gridSize, m_material);
+    m_fadeRadiusParameter = new Qt3DRender::QParameter(QStringLiteral("fadeRadius"), 0.0f, m_material);
+    m_material->addParameter(m_colorParameter);
+    m_material->addParameter(m_cellSizeParameter);
+    m_material->addParameter(m_fadeRadiusParameter);
+    updateFadeRadius();
 
-    // Create material
-    m_material = new Qt3DExtras::QPhongMaterial(this);
-    auto phongMat = qobject_cast<Qt3DExtras::QPhongMaterial*>(m_material);
-    phongMat->setDiffuse(m_color);
-    phongMat->setAmbient(m_color);
-    phongMat->setSpecular(QColor(0, 0, 0));
-    phongMat->setShininess(0.0f);
-
-    // Add components
     addComponent(m_mesh);
     addComponent(m_material);
-}
\ No newline at end of file
+}
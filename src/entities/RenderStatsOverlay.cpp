@@ -0,0 +1,59 @@
+#include "entities/RenderStatsOverlay.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QLocale>
+
+RenderStatsOverlay::RenderStatsOverlay(QWidget *parent)
+    : QWidget(parent)
+    , m_repaintIntervalMs(250)
+{
+    // A native child stacks above the Qt3D window container, where a plain
+    // child widget would be hidden; it is opaque, so fill the whole panel
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_NativeWindow);
+    setAutoFillBackground(false);
+
+    setFixedSize(230, 135);
+    setVisible(false);  // Hidden by default
+}
+
+void RenderStatsOverlay::setSample(const FrameProfiler::Sample &sample)
+{
+    m_sample = sample;
+    if (!m_lastRepaint.isValid() || m_lastRepaint.elapsed() >= m_repaintIntervalMs) {
+        m_lastRepaint.start();
+        update();
+    }
+}
+
+void RenderStatsOverlay::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(30, 30, 30));
+
+    const QLocale locale;
+    const QStringList lines = {
+        tr("FPS: %1").arg(m_sample.fps, 0, 'f', 1),
+        tr("Frame: %1 ms").arg(m_sample.frameMs, 0, 'f', 2),
+        tr("CPU (main): %1 ms").arg(m_sample.cpuMs, 0, 'f', 2),
+        tr("Objects (est.): %1").arg(m_sample.estimatedObjects),
+        tr("Triangles (est.): %1").arg(locale.toString(m_sample.estimatedTriangles)),
+        tr("Uploaded: %1").arg(locale.formattedDataSize(m_sample.uploadedBytes)),
+        tr("Entities: %1").arg(m_sample.entityCount),
+    };
+
+    QFont font("monospace");
+    font.setStyleHint(QFont::Monospace);
+    font.setPointSize(9);
+    painter.setFont(font);
+    painter.setPen(QColor(230, 230, 230));
+
+    const int lineHeight = painter.fontMetrics().height();
+    int y = 8 + painter.fontMetrics().ascent();
+    for (const QString &line : lines) {
+        painter.drawText(10, y, line);
+        y += lineHeight;
+    }
+}
@@ -0,0 +1,271 @@
+#include "mesh/HalfEdgeMesh.h"
+#include "mesh/MeshData.h"
+#include <QDebug>
+#include <utility>
+
+HalfEdgeMesh::HalfEdgeMesh(const MeshData& mesh)
+    : m_mesh(mesh)
+    , m_looseEdgeCount(0)
+    , m_manifold(true)
+{
+    const QVector<MeshData::Vertex>& vertices = mesh.getVertices();
+    const QVector<MeshData::Edge>& edges = mesh.getEdges();
+    const QVector<MeshData::Face>& faces = mesh.getFaces();
+
+    m_vertexHalfEdge.fill(-1, vertices.size());
+    m_faceHalfEdge.fill(-1, faces.size());
+    m_edgeHalfEdge.fill(-1, edges.size());
+
+    int cornerCount = 0;
+    for (const MeshData::Face& face : faces) {
+        cornerCount += face.vertices.size();
+    }
+    m_halfEdges.reserve(cornerCount + cornerCount / 4);
+
+    // Interior half-edges, one per face corner, twinned through the shared edge
+    QVector<int> vertexSlots;
+    QVector<int> edgeSlots;
+    for (int f = 0; f < faces.size(); ++f) {
+        const MeshData::Face& face = faces[f];
+        const int n = face.vertices.size();
+
+        vertexSlots.resize(n);
+        edgeSlots.resize(n);
+        bool valid = n >= 3;
+        for (int i = 0; i < n && valid; ++i) {
+            vertexSlots[i] = mesh.vertexSlot(face.vertices[i]);
+            int edgeIndex = i < face.edges.size() ? face.edges[i] : -1;
+            if (mesh.edgeSlot(edgeIndex) == -1) {
+                edgeIndex = mesh.findEdge(face.vertices[i], face.vertices[(i + 1) % n]);
+            }
+            edgeSlots[i] = mesh.edgeSlot(edgeIndex);
+            valid = vertexSlots[i] != -1 && edgeSlots[i] != -1;
+        }
+        if (!valid) {
+            qWarning() << "HalfEdgeMesh: skipping face" << face.index << "with dangling references";
+            continue;
+        }
+
+        const int base = m_halfEdges.size();
+        m_faceHalfEdge[f] = base;
+
+        for (int i = 0; i < n; ++i) {
+            HalfEdge he;
+            he.origin = vertexSlots[i];
+            he.twin = -1;
+            he.next = base + (i + 1) % n;
+            he.prev = base + (i + n - 1) % n;
+            he.face = f;
+            he.edge = edgeSlots[i];
+
+            const int h = base + i;
+            int& edgeHe = m_edgeHalfEdge[he.edge];
+            if (edgeHe == -1) {
+                edgeHe = h;
+            } else if (m_halfEdges[edgeHe].twin == -1 && m_halfEdges[edgeHe].origin != he.origin) {
+                he.twin = edgeHe;
+                m_halfEdges[edgeHe].twin = h;
+            } else {
+                // Third face on an edge, or inconsistent winding
+                m_manifold = false;
+            }
+
+            if (m_vertexHalfEdge[he.origin] == -1) {
+                m_vertexHalfEdge[he.origin] = h;
+            }
+            m_halfEdges.append(he);
+        }
+    }
+
+    // Boundary half-edges (face == -1) for every unpaired interior half-edge
+    const int interiorCount = m_halfEdges.size();
+    QVector<int> boundaryOut(vertices.size(), -1);  // Head of per-vertex list
+    QVector<int> boundaryOutNext;                   // Linked list through boundary half-edges
+
+    for (int h = 0; h < interiorCount; ++h) {
+        if (m_halfEdges[h].twin != -1) continue;
+
+        HalfEdge b;
+        b.origin = destination(h);
+        b.twin = h;
+        b.next = -1;
+        b.prev = -1;
+        b.face = -1;
+        b.edge = m_halfEdges[h].edge;
+
+        const int bIdx = m_halfEdges.size();
+        m_halfEdges[h].twin = bIdx;
+        m_halfEdges.append(b);
+
+        boundaryOutNext.append(boundaryOut[b.origin]);
+        if (boundaryOut[b.origin] != -1) {
+            m_manifold = false;  // Pinched vertex (two boundary fans meet)
+        }
+        boundaryOut[b.origin] = bIdx;
+
+        // Circulation starting at a boundary half-edge covers the whole fan
+        m_vertexHalfEdge[b.origin] = bIdx;
+    }
+
+    // Link boundary loops: each boundary half-edge continues at an outgoing
+    // boundary half-edge of its destination. In- and out-degree of boundary
+    // half-edges match at every vertex, so the lists never run dry.
+    for (int bIdx = interiorCount; bIdx < m_halfEdges.size(); ++bIdx) {
+        int dest = m_halfEdges[m_halfEdges[bIdx].twin].origin;
+        int nextIdx = boundaryOut[dest];
+        boundaryOut[dest] = boundaryOutNext[nextIdx - interiorCount];
+
+        m_halfEdges[bIdx].next = nextIdx;
+        m_halfEdges[nextIdx].prev = bIdx;
+    }
+
+    // A vertex where closed fans meet (no boundary between them) is pinched
+    // too: circulation from its half-edge reaches only one of the fans
+    if (m_manifold) {
+        QVector<int> outgoingCount(vertices.size(), 0);
+        for (const HalfEdge& he : std::as_const(m_halfEdges)) {
+            ++outgoingCount[he.origin];
+        }
+        for (int v = 0; v < vertices.size() && m_manifold; ++v) {
+            int circulated = 0;
+            forEachOutgoing(v, [&circulated](int) { ++circulated; });
+            m_manifold = circulated == outgoingCount[v];
+        }
+    }
+
+    for (int e = 0; e < m_edgeHalfEdge.size(); ++e) {
+        if (m_edgeHalfEdge[e] == -1) {
+            ++m_looseEdgeCount;
+        }
+    }
+}
+
+QVector<int> HalfEdgeMesh::vertexNeighbors(int vertexIndex) const
+{
+    QVector<int> result;
+    int slot = m_mesh.vertexSlot(vertexIndex);
+    if (slot == -1) return result;
+
+    const QVector<MeshData::Vertex>& vertices = m_mesh.getVertices();
+    forEachOutgoing(slot, [&](int he) {
+        result.append(vertices[destination(he)].index);
+    });
+    return result;
+}
+
+QVector<int> HalfEdgeMesh::vertexFaces(int vertexIndex) const
+{
+    QVector<int> result;
+    int slot = m_mesh.vertexSlot(vertexIndex);
+    if (slot == -1) return result;
+
+    const QVector<MeshData::Face>& faces = m_mesh.getFaces();
+    forEachOutgoing(slot, [&](int he) {
+        int face = m_halfEdges[he].face;
+        if (face != -1) {
+            result.append(faces[face].index);
+        }
+    });
+    return result;
+}
+
+QVector<int> HalfEdgeMesh::vertexEdges(int vertexIndex) const
+{
+    QVector<int> result;
+    int slot = m_mesh.vertexSlot(vertexIndex);
+    if (slot == -1) return result;
+
+    const QVector<MeshData::Edge>& edges = m_mesh.getEdges();
+    forEachOutgoing(slot, [&](int he) {
+        result.append(edges[m_halfEdges[he].edge].index);
+    });
+    return result;
+}
+
+QVector<int> HalfEdgeMesh::edgeFaces(int edgeIndex) const
+{
+    QVector<int> result;
+    int slot = m_mesh.edgeSlot(edgeIndex);
+    if (slot == -1 || m_edgeHalfEdge[slot] == -1) return result;
+
+    const QVector<MeshData::Face>& faces = m_mesh.getFaces();
+    const HalfEdge& he = m_halfEdges[m_edgeHalfEdge[slot]];
+    if (he.face != -1) {
+        result.append(faces[he.face].index);
+    }
+    int twinFace = m_halfEdges[he.twin].face;
+    if (twinFace != -1) {
+        result.append(faces[twinFace].index);
+    }
+    return result;
+}
+
+QVector<int> HalfEdgeMesh::faceNeighbors(int faceIndex) const
+{
+    QVector<int> result;
+    int slot = m_mesh.faceSlot(faceIndex);
+    if (slot == -1 || m_faceHalfEdge[slot] == -1) return result;
+
+    const QVector<MeshData::Face>& faces = m_mesh.getFaces();
+    int start = m_faceHalfEdge[slot];
+    int he = start;
+    do {
+        int neighbor = m_halfEdges[m_halfEdges[he].twin].face;
+        if (neighbor != -1) {
+            result.append(faces[neighbor].index);
+        }
+        he = m_halfEdges[he].next;
+    } while (he != start);
+    return result;
+}
+
+bool HalfEdgeMesh::isBoundaryVertex(int vertexIndex) const
+{
+    int slot = m_mesh.vertexSlot(vertexIndex);
+    if (slot == -1 || m_vertexHalfEdge[slot] == -1) return false;
+
+    // Boundary vertices always point at their outgoing boundary half-edge
+    return m_halfEdges[m_vertexHalfEdge[slot]].face == -1;
+}
+
+bool HalfEdgeMesh::isBoundaryEdge(int edgeIndex) const
+{
+    int slot = m_mesh.edgeSlot(edgeIndex);
+    if (slot == -1 || m_edgeHalfEdge[slot] == -1) return false;
+
+    const HalfEdge& he = m_halfEdges[m_edgeHalfEdge[slot]];
+    return he.face == -1 || m_halfEdges[he.twin].face == -1;
+}
+
+QVector<int> HalfEdgeMesh::boundaryEdges() const
+{
+    QVector<int> result;
+    const QVector<MeshData::Edge>& edges = m_mesh.getEdges();
+    for (const HalfEdge& he : m_halfEdges) {
+        if (he.face == -1) {
+            result.append(edges[he.edge].index);
+        }
+    }
+    return result;
+}
+
+QVector<QVector<int>> HalfEdgeMesh::boundaryLoops() const
+{
+    QVector<QVector<int>> loops;
+    const QVector<MeshData::Vertex>& vertices = m_mesh.getVertices();
+    QVector<bool> visited(m_halfEdges.size(), false);
+
+    for (int start = 0; start < m_halfEdges.size(); ++start) {
+        if (m_halfEdges[start].face != -1 || visited[start]) continue;
+
+        QVector<int> loop;
+        int he = start;
+        do {
+            visited[he] = true;
+            loop.append(vertices[m_halfEdges[he].origin].index);
+            he = m_halfEdges[he].next;
+        } while (he != start);
+        loops.append(loop);
+    }
+    return loops;
+}
@@ -0,0 +1,233 @@
+#include "mesh/MeshBVH.h"
+#include "mesh/MeshData.h"
+#include <algorithm>
+
+MeshBVH::MeshBVH(const MeshData& mesh)
+{
+    const QVector<MeshData::Vertex>& vertices = mesh.getVertices();
+    m_positions.reserve(vertices.size());
+    m_vertexIndices.reserve(vertices.size());
+    for (const MeshData::Vertex& v : vertices) {
+        m_positions.append(v.position);
+        m_vertexIndices.append(v.index);
+    }
+
+    // Fan triangulation, matching MeshData::generateGeometry()
+    for (const MeshData::Face& face : mesh.getFaces()) {
+        const int n = face.vertices.size();
+        if (n < 3) {
+            continue;
+        }
+        const int first = mesh.vertexSlot(face.vertices[0]);
+        for (int i = 1; i < n - 1; ++i) {
+            Triangle triangle;
+            triangle.v[0] = first;
+            triangle.v[1] = mesh.vertexSlot(face.vertices[i]);
+            triangle.v[2] = mesh.vertexSlot(face.vertices[i + 1]);
+            triangle.faceIndex = face.index;
+            if (triangle.v[0] >= 0 && triangle.v[1] >= 0 && triangle.v[2] >= 0) {
+                m_triangles.append(triangle);
+            }
+        }
+    }
+
+    if (m_triangles.isEmpty()) {
+        return;
+    }
+
+    QVector<QVector3D> centroids;
+    centroids.reserve(m_triangles.size());
+    for (const Triangle& triangle : m_triangles) {
+        centroids.append((m_positions[triangle.v[0]] + m_positions[triangle.v[1]] + m_positions[triangle.v[2]]) / 3.0f);
+    }
+
+    // A binary tree with leaves of >= 1 triangle has at most 2n - 1 nodes
+    m_nodes.reserve(2 * m_triangles.size() - 1);
+    m_nodes.append(Node());
+    build(0, 0, m_triangles.size(), centroids);
+}
+
+void MeshBVH::build(int nodeIndex, int first, int count, QVector<QVector3D>& centroids)
+{
+    BoundingBox box;
+    BoundingBox centroidBox;
+    for (int i = first; i < first + count; ++i) {
+        box.expand(triangleBounds(m_triangles[i]));
+        centroidBox.expand(centroids[i]);
+    }
+    m_nodes[nodeIndex].box = box;
+
+    const int axis = centroidBox.longestAxis();
+    if (count <= MaxLeafTriangles || centroidBox.size()[axis] <= 0.0f) {
+        m_nodes[nodeIndex].first = first;
+        m_nodes[nodeIndex].count = count;
+        return;
+    }
+
+    // Partition around the centroid median; triangles and centroids move together
+    QVector<int> order(count);
+    for (int i = 0; i < count; ++i) {
+        order[i] = first + i;
+    }
+    const int half = count / 2;
+    std::nth_element(order.begin(), order.begin() + half, order.end(), [&centroids, axis](int a, int b) {
+        return centroids[a][axis] < centroids[b][axis];
+    });
+
+    QVector<Triangle> triangles(count);
+    QVector<QVector3D> sortedCentroids(count);
+    for (int i = 0; i < count; ++i) {
+        triangles[i] = m_triangles[order[i]];
+        sortedCentroids[i] = centroids[order[i]];
+    }
+    std::copy(triangles.cbegin(), triangles.cend(), m_triangles.begin() + first);
+    std::copy(sortedCentroids.cbegin(), sortedCentroids.cend(), centroids.begin() + first);
+
+    // Children are allocated as a pair after all existing nodes
+    const int left = m_nodes.size();
+    m_nodes[nodeIndex].first = left;
+    m_nodes[nodeIndex].count = 0;
+    m_nodes.append(Node());
+    m_nodes.append(Node());
+
+    build(left, first, half, centroids);
+    build(left + 1, first + half, count - half, centroids);
+}
+
+BoundingBox MeshBVH::triangleBounds(const Triangle& triangle) const
+{
+    BoundingBox box;
+    box.expand(m_positions[triangle.v[0]]);
+    box.expand(m_positions[triangle.v[1]]);
+    box.expand(m_positions[triangle.v[2]]);
+    return box;
+}
+
+void MeshBVH::refit(const MeshData& mesh)
+{
+    const QVector<MeshData::Vertex>& vertices = mesh.getVertices();
+    if (vertices.size() != m_positions.size()) {
+        return;  // Topology changed; MeshData rebuilds instead
+    }
+    for (int slot = 0; slot < vertices.size(); ++slot) {
+        m_positions[slot] = vertices[slot].position;
+    }
+
+    // Children are stored after their parent, so a reverse sweep is bottom-up
+    for (int i = m_nodes.size() - 1; i >= 0; --i) {
+        Node& node = m_nodes[i];
+        BoundingBox box;
+        if (node.count > 0) {
+            for (int t = node.first; t < node.first + node.count; ++t) {
+                box.expand(triangleBounds(m_triangles[t]));
+            }
+        } else {
+            box.expand(m_nodes[node.first].box);
+            box.expand(m_nodes[node.first + 1].box);
+        }
+        node.box = box;
+    }
+}
+
+bool MeshBVH::intersectTriangle(const Ray& ray, const Triangle& triangle, float maxT, float* t) const
+{
+    // Möller–Trumbore, double-sided
+    const QVector3D& p0 = m_positions[triangle.v[0]];
+    const QVector3D e1 = m_positions[triangle.v[1]] - p0;
+    const QVector3D e2 = m_positions[triangle.v[2]] - p0;
+
+    const QVector3D p = QVector3D::crossProduct(ray.direction, e2);
+    const float det = QVector3D::dotProduct(e1, p);
+    if (qAbs(det) < 1e-12f) {
+        return false;
+    }
+    const float invDet = 1.0f / det;
+
+    const QVector3D s = ray.origin - p0;
+    const float u = QVector3D::dotProduct(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+
+    const QVector3D q = QVector3D::crossProduct(s, e1);
+    const float v = QVector3D::dotProduct(ray.direction, q) * invDet;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+
+    const float hitT = QVector3D::dotProduct(e2, q) * invDet;
+    if (hitT < 0.0f || hitT > maxT) {
+        return false;
+    }
+    *t = hitT;
+    return true;
+}
+
+bool MeshBVH::raycast(const Ray& ray, Hit* hit, float maxT) const
+{
+    if (m_nodes.isEmpty()) {
+        return false;
+    }
+
+    float nearest = maxT;
+    int nearestTriangle = -1;
+
+    // Median splits halve every node, so the depth stays below 32
+    int stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const Node& node = m_nodes[stack[--stackSize]];
+        if (!node.box.intersects(ray, 0.0f, nearest)) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (int i = node.first; i < node.first + node.count; ++i) {
+                float t;
+                if (intersectTriangle(ray, m_triangles[i], nearest, &t)) {
+                    nearest = t;
+                    nearestTriangle = i;
+                }
+            }
+            continue;
+        }
+
+        // Push the farther child first so the nearer one is visited next
+        float tLeft = 0.0f;
+        float tRight = 0.0f;
+        const bool hitLeft = m_nodes[node.first].box.intersects(ray, 0.0f, nearest, &tLeft);
+        const bool hitRight = m_nodes[node.first + 1].box.intersects(ray, 0.0f, nearest, &tRight);
+        if (hitLeft && hitRight) {
+            const bool leftFirst = tLeft <= tRight;
+            stack[stackSize++] = leftFirst ? node.first + 1 : node.first;
+            stack[stackSize++] = leftFirst ? node.first : node.first + 1;
+        } else if (hitLeft) {
+            stack[stackSize++] = node.first;
+        } else if (hitRight) {
+            stack[stackSize++] = node.first + 1;
+        }
+    }
+
+    if (nearestTriangle < 0) {
+        return false;
+    }
+
+    if (hit) {
+        const Triangle& triangle = m_triangles[nearestTriangle];
+        hit->t = nearest;
+        hit->faceIndex = triangle.faceIndex;
+        hit->position = ray.at(nearest);
+
+        float bestDistance = std::numeric_limits<float>::max();
+        for (int corner : triangle.v) {
+            const float d = (m_positions[corner] - hit->position).lengthSquared();
+            if (d < bestDistance) {
+                bestDistance = d;
+                hit->vertexIndex = m_vertexIndices[corner];
+            }
+        }
+    }
+    return true;
+}
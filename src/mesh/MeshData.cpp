@@ -1,86 +1,231 @@
 #include "mesh/MeshData.h"
+#include "mesh/HalfEdgeMesh.h"
+#include "mesh/MeshBVH.h"
+#include "core/RenderCounters.h"
 #include <Qt3DCore/QGeometry>
 #include <Qt3DCore/QAttribute>
 #include <Qt3DCore/QBuffer>
 #include <QDebug>
+#include <algorithm>
 
 MeshData::MeshData()
     : m_nextVertexIndex(0)
     , m_nextEdgeIndex(0)
     , m_nextFaceIndex(0)
+    , m_bvhStale(false)
+    , m_triangleOffsetsValid(false)
+    , m_layoutValid(false)
 {
 }
 
+MeshData::MeshData(const MeshData& other)
+    : m_vertices(other.m_vertices)
+    , m_edges(other.m_edges)
+    , m_faces(other.m_faces)
+    , m_nextVertexIndex(other.m_nextVertexIndex)
+    , m_nextEdgeIndex(other.m_nextEdgeIndex)
+    , m_nextFaceIndex(other.m_nextFaceIndex)
+    , m_vertexSlots(other.m_vertexSlots)
+    , m_edgeSlots(other.m_edgeSlots)
+    , m_faceSlots(other.m_faceSlots)
+    , m_edgeLookup(other.m_edgeLookup)
+    , m_bvhStale(false)
+    , m_triangleOffsetsValid(false)
+    , m_layoutValid(false)
+{
+}
+
+MeshData& MeshData::operator=(const MeshData& other)
+{
+    if (this != &other) {
+        m_vertices = other.m_vertices;
+        m_edges = other.m_edges;
+        m_faces = other.m_faces;
+        m_nextVertexIndex = other.m_nextVertexIndex;
+        m_nextEdgeIndex = other.m_nextEdgeIndex;
+        m_nextFaceIndex = other.m_nextFaceIndex;
+        m_vertexSlots = other.m_vertexSlots;
+        m_edgeSlots = other.m_edgeSlots;
+        m_faceSlots = other.m_faceSlots;
+        m_edgeLookup = other.m_edgeLookup;
+        invalidateTopology();
+        m_dirtyVertices.clear();
+    }
+    return *this;
+}
+
 MeshData::~MeshData()
 {
 }
 
+void MeshData::reserve(int vertexCount, int faceCount)
+{
+    // Closed polygon meshes have roughly twice as many edges as faces
+    int edgeCount = faceCount * 2;
+
+    m_vertices.reserve(vertexCount);
+    m_edges.reserve(edgeCount);
+    m_faces.reserve(faceCount);
+    m_vertexSlots.reserve(vertexCount);
+    m_edgeSlots.reserve(edgeCount);
+    m_faceSlots.reserve(faceCount);
+    m_edgeLookup.reserve(edgeCount);
+}
+
 int MeshData::addVertex(const QVector3D& position)
 {
+    invalidateTopology();
+
     int index = m_nextVertexIndex++;
+    m_vertexSlots.insert(index, m_vertices.size());
     m_vertices.append(Vertex(position, index));
     return index;
 }
 
 void MeshData::removeVertex(int index)
 {
-    // Find and remove the vertex
-    for (int i = 0; i < m_vertices.size(); ++i) {
-        if (m_vertices[i].index == index) {
-            m_vertices.removeAt(i);
-            break;
-        }
+    int slot = m_vertexSlots.value(index, -1);
+    if (slot == -1) {
+        return;
+    }
+
+    // Adjacency is already available: avoid scanning every edge and face
+    // (fans around non-manifold vertices are incomplete, so not then)
+    if (m_halfEdges && m_halfEdges->isManifold()) {
+        removeVertices({index});
+        return;
     }
 
+    invalidateTopology();
+    removeVertexAt(slot);
+
     // Remove any edges that reference this vertex
     for (int i = m_edges.size() - 1; i >= 0; --i) {
         if (m_edges[i].v0 == index || m_edges[i].v1 == index) {
-            m_edges.removeAt(i);
+            removeEdgeAt(i);
         }
     }
 
     // Remove any faces that reference this vertex
     for (int i = m_faces.size() - 1; i >= 0; --i) {
         if (m_faces[i].vertices.contains(index)) {
-            m_faces.removeAt(i);
+            removeFaceAt(i);
         }
     }
 }
 
-void MeshData::updateVertex(int index, const QVector3D& position)
+void MeshData::removeVertices(const QVector<int>& indices)
 {
-    for (int i = 0; i < m_vertices.size(); ++i) {
-        if (m_vertices[i].index == index) {
-            m_vertices[i].position = position;
-            return;
+    if (indices.isEmpty()) {
+        return;
+    }
+
+    // Collect everything incident to the removed vertices in one pass over
+    // the adjacency, then remove by stable index (slots move while removing)
+    const HalfEdgeMesh* topology = halfEdgeTopology();
+
+    // Circulating a non-manifold vertex misses faces in its other fans;
+    // scan every face and edge instead
+    const bool walkAdjacency = topology->isManifold();
+
+    QSet<int> removedVertices;
+    QSet<int> removedEdges;
+    QSet<int> removedFaces;
+    for (int index : indices) {
+        if (vertexSlot(index) == -1) continue;
+
+        removedVertices.insert(index);
+        if (!walkAdjacency) continue;
+
+        for (int face : topology->vertexFaces(index)) {
+            removedFaces.insert(face);
+        }
+        for (int edge : topology->vertexEdges(index)) {
+            removedEdges.insert(edge);
+        }
+    }
+
+    if (!walkAdjacency) {
+        for (const Face& face : m_faces) {
+            for (int vertex : face.vertices) {
+                if (removedVertices.contains(vertex)) {
+                    removedFaces.insert(face.index);
+                    break;
+                }
+            }
         }
     }
+
+    // Edges that belong to no face are not part of the half-edge structure
+    if (!walkAdjacency || topology->looseEdgeCount() > 0) {
+        for (const Edge& edge : m_edges) {
+            if (removedVertices.contains(edge.v0) || removedVertices.contains(edge.v1)) {
+                removedEdges.insert(edge.index);
+            }
+        }
+    }
+
+    invalidateTopology();
+
+    for (int face : removedFaces) {
+        removeFaceAt(m_faceSlots.value(face));
+    }
+    for (int edge : removedEdges) {
+        removeEdgeAt(m_edgeSlots.value(edge));
+    }
+    for (int vertex : removedVertices) {
+        removeVertexAt(m_vertexSlots.value(vertex));
+    }
+}
+
+void MeshData::updateVertex(int index, const QVector3D& position)
+{
+    int slot = m_vertexSlots.value(index, -1);
+    if (slot != -1) {
+        m_vertices[slot].position = position;
+        m_dirtyVertices.insert(index);
+        m_bvhStale = true;
+    }
+}
+
+const MeshData::Vertex* MeshData::findVertex(int index) const
+{
+    int slot = m_vertexSlots.value(index, -1);
+    return slot == -1 ? nullptr : &m_vertices[slot];
 }
 
 int MeshData::addEdge(int v0, int v1)
 {
     // Check if edge already exists
-    for (const Edge& edge : m_edges) {
-        if ((edge.v0 == v0 && edge.v1 == v1) || (edge.v0 == v1 && edge.v1 == v0)) {
-            return edge.index;
-        }
+    quint64 key = edgeKey(v0, v1);
+    auto it = m_edgeLookup.constFind(key);
+    if (it != m_edgeLookup.constEnd()) {
+        return it.value();
     }
 
+    invalidateTopology();
+
     int index = m_nextEdgeIndex++;
+    m_edgeSlots.insert(index, m_edges.size());
+    m_edgeLookup.insert(key, index);
     m_edges.append(Edge(v0, v1, index));
     return index;
 }
 
 void MeshData::removeEdge(int index)
 {
-    for (int i = 0; i < m_edges.size(); ++i) {
-        if (m_edges[i].index == index) {
-            m_edges.removeAt(i);
-            break;
-        }
+    int slot = m_edgeSlots.value(index, -1);
+    if (slot != -1) {
+        invalidateTopology();
+        removeEdgeAt(slot);
     }
 }
 
+int MeshData::findEdge(int v0, int v1) const
+{
+    return m_edgeLookup.value(edgeKey(v0, v1), -1);
+}
+
 int MeshData::addFace(const QVector<int>& vertexIndices)
 {
     if (vertexIndices.size() < 3) {
@@ -88,8 +233,11 @@ int MeshData::addFace(const QVector<int>& vertexIndices)
         return -1;
     }
 
+    invalidateTopology();
+
     int index = m_nextFaceIndex++;
     Face face(vertexIndices, index);
+    face.edges.reserve(vertexIndices.size());
 
     // Create edges for this face
     for (int i = 0; i < vertexIndices.size(); ++i) {
@@ -99,20 +247,26 @@ int MeshData::addFace(const QVector<int>& vertexIndices)
         face.edges.append(edgeIdx);
     }
 
+    m_faceSlots.insert(index, m_faces.size());
     m_faces.append(face);
     return index;
 }
 
 void MeshData::removeFace(int index)
 {
-    for (int i = 0; i < m_faces.size(); ++i) {
-        if (m_faces[i].index == index) {
-            m_faces.removeAt(i);
-            break;
-        }
+    int slot = m_faceSlots.value(index, -1);
+    if (slot != -1) {
+        invalidateTopology();
+        removeFaceAt(slot);
     }
 }
 
+const MeshData::Face* MeshData::findFace(int index) const
+{
+    int slot = m_faceSlots.value(index, -1);
+    return slot == -1 ? nullptr : &m_faces[slot];
+}
+
 Qt3DCore::QGeometry* MeshData::generateGeometry(Qt3DCore::QNode* parent)
 {
     if (m_faces.isEmpty() || m_vertices.isEmpty()) {
@@ -120,124 +274,232 @@ Qt3DCore::QGeometry* MeshData::generateGeometry(Qt3DCore::QNode* parent)
         return nullptr;
     }
 
-    // Build arrays for rendering
-    QVector<QVector3D> positions;
-    QVector<QVector3D> normals;
-    QVector<unsigned int> indices;
-
-    // Generate triangulated mesh from faces
+    // Size the output up front: an n-gon fans into n - 2 triangles, and every
+    // triangle gets its own three corners so it can carry a flat normal
+    qsizetype triangleCount = 0;
     for (const Face& face : m_faces) {
-        if (face.vertices.size() < 3) continue;
-
-        // Simple fan triangulation for n-gons
-        int v0Idx = face.vertices[0];
-        QVector3D v0;
-        for (const Vertex& v : m_vertices) {
-            if (v.index == v0Idx) {
-                v0 = v.position;
-                break;
-            }
+        if (face.vertices.size() >= 3) {
+            triangleCount += face.vertices.size() - 2;
         }
+    }
+    const qsizetype outVertexCount = triangleCount * 3;
+    const bool shortIndices = outVertexCount <= 0x10000;
+    const int indexSize = shortIndices ? sizeof(quint16) : sizeof(quint32);
 
-        for (int i = 1; i < face.vertices.size() - 1; ++i) {
-            // Find vertex positions
-            QVector3D v1, v2;
-            for (const Vertex& v : m_vertices) {
-                if (v.index == face.vertices[i]) v1 = v.position;
-                if (v.index == face.vertices[i + 1]) v2 = v.position;
-            }
+    QByteArray vertexData;
+    vertexData.resize(outVertexCount * VertexStride);
+    QByteArray indexData;
+    indexData.resize(outVertexCount * indexSize);
 
-            // Calculate face normal
-            QVector3D edge1 = v1 - v0;
-            QVector3D edge2 = v2 - v0;
-            QVector3D normal = QVector3D::crossProduct(edge1, edge2).normalized();
-
-            // Add triangle
-            unsigned int baseIdx = positions.size();
-            positions.append(v0);
-            positions.append(v1);
-            positions.append(v2);
-            normals.append(normal);
-            normals.append(normal);
-            normals.append(normal);
-            indices.append(baseIdx);
-            indices.append(baseIdx + 1);
-            indices.append(baseIdx + 2);
+    // Fan triangulation; remember where each face lands for partial updates
+    buildTriangleOffsets();
+    float* vertexPtr = reinterpret_cast<float*>(vertexData.data());
+    for (const Face& face : m_faces) {
+        vertexPtr = writeFaceTriangles(face, vertexPtr);
+    }
+    m_layoutValid = true;
+    m_dirtyVertices.clear();
+
+    // Corners are unshared, so the index buffer is simply 0..n-1
+    if (shortIndices) {
+        quint16* indexPtr = reinterpret_cast<quint16*>(indexData.data());
+        for (qsizetype i = 0; i < outVertexCount; ++i) {
+            indexPtr[i] = static_cast<quint16>(i);
+        }
+    } else {
+        quint32* indexPtr = reinterpret_cast<quint32*>(indexData.data());
+        for (qsizetype i = 0; i < outVertexCount; ++i) {
+            indexPtr[i] = static_cast<quint32>(i);
         }
     }
 
-    // Create Qt3D geometry
+    // Create Qt3D geometry: one interleaved position/normal buffer plus indices
     auto* geometry = new Qt3DCore::QGeometry(parent);
 
-    // Position attribute
-    auto* positionBuffer = new Qt3DCore::QBuffer(geometry);
-    QByteArray positionData;
-    positionData.resize(positions.size() * 3 * sizeof(float));
-    float* posPtr = reinterpret_cast<float*>(positionData.data());
-    for (const QVector3D& pos : positions) {
-        *posPtr++ = pos.x();
-        *posPtr++ = pos.y();
-        *posPtr++ = pos.z();
-    }
-    positionBuffer->setData(positionData);
+    auto* vertexBuffer = new Qt3DCore::QBuffer(geometry);
+    vertexBuffer->setData(vertexData);
+    RenderCounters::addUploadedBytes(vertexData.size());
 
     auto* positionAttribute = new Qt3DCore::QAttribute(geometry);
     positionAttribute->setName(Qt3DCore::QAttribute::defaultPositionAttributeName());
     positionAttribute->setVertexBaseType(Qt3DCore::QAttribute::Float);
     positionAttribute->setVertexSize(3);
     positionAttribute->setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
-    positionAttribute->setBuffer(positionBuffer);
-    positionAttribute->setByteStride(3 * sizeof(float));
-    positionAttribute->setCount(positions.size());
+    positionAttribute->setBuffer(vertexBuffer);
+    positionAttribute->setByteOffset(0);
+    positionAttribute->setByteStride(VertexStride);
+    positionAttribute->setCount(outVertexCount);
     geometry->addAttribute(positionAttribute);
 
-    // Normal attribute
-    auto* normalBuffer = new Qt3DCore::QBuffer(geometry);
-    QByteArray normalData;
-    normalData.resize(normals.size() * 3 * sizeof(float));
-    float* normPtr = reinterpret_cast<float*>(normalData.data());
-    for (const QVector3D& norm : normals) {
-        *normPtr++ = norm.x();
-        *normPtr++ = norm.y();
-        *normPtr++ = norm.z();
-    }
-    normalBuffer->setData(normalData);
-
     auto* normalAttribute = new Qt3DCore::QAttribute(geometry);
     normalAttribute->setName(Qt3DCore::QAttribute::defaultNormalAttributeName());
     normalAttribute->setVertexBaseType(Qt3DCore::QAttribute::Float);
     normalAttribute->setVertexSize(3);
     normalAttribute->setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
-    normalAttribute->setBuffer(normalBuffer);
-    normalAttribute->setByteStride(3 * sizeof(float));
-    normalAttribute->setCount(normals.size());
+    normalAttribute->setBuffer(vertexBuffer);
+    normalAttribute->setByteOffset(3 * sizeof(float));
+    normalAttribute->setByteStride(VertexStride);
+    normalAttribute->setCount(outVertexCount);
     geometry->addAttribute(normalAttribute);
 
-    // Index attribute
     auto* indexBuffer = new Qt3DCore::QBuffer(geometry);
-    QByteArray indexData;
-    indexData.resize(indices.size() * sizeof(unsigned int));
-    unsigned int* idxPtr = reinterpret_cast<unsigned int*>(indexData.data());
-    for (unsigned int idx : indices) {
-        *idxPtr++ = idx;
-    }
     indexBuffer->setData(indexData);
+    RenderCounters::addUploadedBytes(indexData.size());
 
     auto* indexAttribute = new Qt3DCore::QAttribute(geometry);
-    indexAttribute->setVertexBaseType(Qt3DCore::QAttribute::UnsignedInt);
+    indexAttribute->setVertexBaseType(shortIndices ? Qt3DCore::QAttribute::UnsignedShort
+                                                   : Qt3DCore::QAttribute::UnsignedInt);
     indexAttribute->setAttributeType(Qt3DCore::QAttribute::IndexAttribute);
     indexAttribute->setBuffer(indexBuffer);
-    indexAttribute->setCount(indices.size());
+    indexAttribute->setCount(outVertexCount);
     geometry->addAttribute(indexAttribute);
 
     return geometry;
 }
 
+bool MeshData::updateVertexBuffer(Qt3DCore::QBuffer* vertexBuffer)
+{
+    if (!vertexBuffer || !m_layoutValid) {
+        return false;
+    }
+    if (m_dirtyVertices.isEmpty()) {
+        return true;
+    }
+
+    // Faces touching a moved vertex change both corner positions and normal
+    const HalfEdgeMesh* topology = halfEdgeTopology();
+    QSet<int> dirtyFaceSlots;
+    for (int vertex : m_dirtyVertices) {
+        for (int face : topology->vertexFaces(vertex)) {
+            dirtyFaceSlots.insert(m_faceSlots.value(face));
+        }
+    }
+    m_dirtyVertices.clear();
+
+    QVector<int> faceSlots(dirtyFaceSlots.begin(), dirtyFaceSlots.end());
+    std::sort(faceSlots.begin(), faceSlots.end());
+
+    // Merge runs of consecutive faces into one updateData() call each
+    const int triangleBytes = 3 * VertexStride;
+    int i = 0;
+    while (i < faceSlots.size()) {
+        int first = faceSlots[i];
+        int last = first;
+        while (i + 1 < faceSlots.size() && faceSlots[i + 1] == last + 1) {
+            last = faceSlots[++i];
+        }
+        ++i;
+
+        const int startTriangle = m_faceTriangleOffset[first];
+        const int endTriangle = m_faceTriangleOffset[last + 1];
+        if (endTriangle == startTriangle) continue;
+
+        QByteArray bytes;
+        bytes.resize((endTriangle - startTriangle) * triangleBytes);
+        float* out = reinterpret_cast<float*>(bytes.data());
+        for (int f = first; f <= last; ++f) {
+            out = writeFaceTriangles(m_faces[f], out);
+        }
+        vertexBuffer->updateData(startTriangle * triangleBytes, bytes);
+        RenderCounters::addUploadedBytes(bytes.size());
+    }
+
+    return true;
+}
+
+Qt3DCore::QBuffer* MeshData::vertexBufferOf(const Qt3DCore::QGeometry* geometry)
+{
+    if (!geometry) {
+        return nullptr;
+    }
+
+    for (Qt3DCore::QAttribute* attribute : geometry->attributes()) {
+        if (attribute->name() == Qt3DCore::QAttribute::defaultPositionAttributeName()) {
+            return attribute->buffer();
+        }
+    }
+    return nullptr;
+}
+
+void MeshData::buildTriangleOffsets() const
+{
+    if (m_triangleOffsetsValid) {
+        return;
+    }
+
+    m_faceTriangleOffset.resize(m_faces.size() + 1);
+    int triangle = 0;
+    for (int f = 0; f < m_faces.size(); ++f) {
+        m_faceTriangleOffset[f] = triangle;
+        const int n = m_faces[f].vertices.size();
+        if (n >= 3) {
+            triangle += n - 2;
+        }
+    }
+    m_faceTriangleOffset[m_faces.size()] = triangle;
+    m_triangleOffsetsValid = true;
+}
+
+int MeshData::faceOfTriangle(int triangle) const
+{
+    buildTriangleOffsets();
+    if (triangle < 0 || triangle >= m_faceTriangleOffset.last()) {
+        return -1;
+    }
+
+    // Last face starting at or before the triangle
+    auto it = std::upper_bound(m_faceTriangleOffset.cbegin(), m_faceTriangleOffset.cend(), triangle);
+    const int slot = int(it - m_faceTriangleOffset.cbegin()) - 1;
+    return m_faces[slot].index;
+}
+
+float* MeshData::writeFaceTriangles(const Face& face, float* out) const
+{
+    const int n = face.vertices.size();
+    if (n < 3) {
+        return out;
+    }
+
+    auto positionOf = [this](int index) {
+        const Vertex* vertex = findVertex(index);
+        return vertex ? vertex->position : QVector3D();
+    };
+
+    auto writeCorner = [&out](const QVector3D& position, const QVector3D& normal) {
+        *out++ = position.x();
+        *out++ = position.y();
+        *out++ = position.z();
+        *out++ = normal.x();
+        *out++ = normal.y();
+        *out++ = normal.z();
+    };
+
+    // Fan triangulation, one slot lookup per face corner
+    const QVector3D v0 = positionOf(face.vertices[0]);
+    QVector3D v1 = positionOf(face.vertices[1]);
+    for (int i = 1; i < n - 1; ++i) {
+        const QVector3D v2 = positionOf(face.vertices[i + 1]);
+        const QVector3D normal = QVector3D::crossProduct(v1 - v0, v2 - v0).normalized();
+
+        writeCorner(v0, normal);
+        writeCorner(v1, normal);
+        writeCorner(v2, normal);
+        v1 = v2;
+    }
+    return out;
+}
+
 void MeshData::clear()
 {
     m_vertices.clear();
     m_edges.clear();
     m_faces.clear();
+    m_vertexSlots.clear();
+    m_edgeSlots.clear();
+    m_faceSlots.clear();
+    m_edgeLookup.clear();
+    invalidateTopology();
+    m_dirtyVertices.clear();
     m_nextVertexIndex = 0;
     m_nextEdgeIndex = 0;
     m_nextFaceIndex = 0;
@@ -248,29 +510,103 @@ bool MeshData::isValid() const
     return !m_vertices.isEmpty() && !m_faces.isEmpty();
 }
 
-int MeshData::findOrCreateEdge(int v0, int v1)
+void MeshData::invalidateTopology()
+{
+    m_halfEdges.reset();
+    m_triangleBVH.reset();
+    m_bvhStale = false;
+    m_triangleOffsetsValid = false;
+    m_layoutValid = false;
+}
+
+const HalfEdgeMesh* MeshData::halfEdgeTopology() const
 {
-    // Check if edge already exists (in either direction)
-    for (const Edge& edge : m_edges) {
-        if ((edge.v0 == v0 && edge.v1 == v1) || (edge.v0 == v1 && edge.v1 == v0)) {
-            return edge.index;
+    if (!m_halfEdges) {
+        m_halfEdges = std::make_unique<HalfEdgeMesh>(*this);
+        if (!m_halfEdges->isManifold()) {
+            qWarning() << "MeshData: non-manifold topology, adjacency queries may be incomplete";
         }
     }
+    return m_halfEdges.get();
+}
+
+const MeshBVH* MeshData::triangleBVH() const
+{
+    if (!m_triangleBVH) {
+        m_triangleBVH = std::make_unique<MeshBVH>(*this);
+    } else if (m_bvhStale) {
+        m_triangleBVH->refit(*this);
+    }
+    m_bvhStale = false;
+    return m_triangleBVH.get();
+}
+
+quint64 MeshData::edgeKey(int v0, int v1)
+{
+    quint32 lo = static_cast<quint32>(qMin(v0, v1));
+    quint32 hi = static_cast<quint32>(qMax(v0, v1));
+    return (quint64(lo) << 32) | hi;
+}
 
-    // Create new edge
+int MeshData::findOrCreateEdge(int v0, int v1)
+{
+    // addEdge() returns the existing edge (in either direction) if present
     return addEdge(v0, v1);
 }
 
 void MeshData::buildEdgesFromFaces()
 {
+    invalidateTopology();
     m_edges.clear();
+    m_edgeSlots.clear();
+    m_edgeLookup.clear();
     m_nextEdgeIndex = 0;
 
-    for (const Face& face : m_faces) {
+    for (Face& face : m_faces) {
+        face.edges.clear();
         for (int i = 0; i < face.vertices.size(); ++i) {
             int v0 = face.vertices[i];
             int v1 = face.vertices[(i + 1) % face.vertices.size()];
-            findOrCreateEdge(v0, v1);
+            face.edges.append(findOrCreateEdge(v0, v1));
         }
     }
 }
+
+void MeshData::removeVertexAt(int slot)
+{
+    m_vertexSlots.remove(m_vertices[slot].index);
+
+    // Swap-remove: move the last vertex into the freed slot
+    int last = m_vertices.size() - 1;
+    if (slot != last) {
+        m_vertices[slot] = m_vertices[last];
+        m_vertexSlots[m_vertices[slot].index] = slot;
+    }
+    m_vertices.removeLast();
+}
+
+void MeshData::removeEdgeAt(int slot)
+{
+    const Edge& edge = m_edges[slot];
+    m_edgeSlots.remove(edge.index);
+    m_edgeLookup.remove(edgeKey(edge.v0, edge.v1));
+
+    int last = m_edges.size() - 1;
+    if (slot != last) {
+        m_edges[slot] = m_edges[last];
+        m_edgeSlots[m_edges[slot].index] = slot;
+    }
+    m_edges.removeLast();
+}
+
+void MeshData::removeFaceAt(int slot)
+{
+    m_faceSlots.remove(m_faces[slot].index);
+
+    int last = m_faces.size() - 1;
+    if (slot != last) {
+        m_faces[slot] = std::move(m_faces[last]);
+        m_faceSlots[m_faces[slot].index] = slot;
+    }
+    m_faces.removeLast();
+}
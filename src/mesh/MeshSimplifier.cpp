@@ -0,0 +1,189 @@
+#include "mesh/MeshSimplifier.h"
+#include "mesh/MeshData.h"
+#include "mesh/BoundingBox.h"
+#include "core/RenderCounters.h"
+#include <Qt3DCore/QGeometry>
+#include <Qt3DCore/QAttribute>
+#include <Qt3DCore/QBuffer>
+#include <QHash>
+#include <QSet>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Grid resolution limits (cells along the longest axis). Cell indices run
+// up to the resolution itself (points on the max face), so at most 128^3
+// clusters: cluster ids stay within 21 bits for the triangle dedupe key.
+constexpr int MaxResolution = 127;
+constexpr int MinResolution = 2;
+
+// A level must drop at least this share of the previous level's triangles
+constexpr float MinReduction = 0.2f;
+
+quint64 packKey(quint64 a, quint64 b, quint64 c)
+{
+    return a | (b << 21) | (c << 42);
+}
+
+} // namespace
+
+MeshSimplifier::Input MeshSimplifier::snapshot(const MeshData& mesh)
+{
+    Input input;
+    const QVector<MeshData::Vertex>& vertices = mesh.getVertices();
+    input.positions.reserve(vertices.size());
+    for (const MeshData::Vertex& v : vertices) {
+        input.positions.append(v.position);
+    }
+
+    for (const MeshData::Face& face : mesh.getFaces()) {
+        const int n = face.vertices.size();
+        if (n < 3) {
+            continue;
+        }
+        const int first = mesh.vertexSlot(face.vertices[0]);
+        for (int i = 1; i < n - 1; ++i) {
+            const int v1 = mesh.vertexSlot(face.vertices[i]);
+            const int v2 = mesh.vertexSlot(face.vertices[i + 1]);
+            if (first >= 0 && v1 >= 0 && v2 >= 0) {
+                input.triangles << first << v1 << v2;
+            }
+        }
+    }
+    return input;
+}
+
+QVector<MeshSimplifier::Level> MeshSimplifier::buildChain(const Input& input, int maxLevels, int minTriangles)
+{
+    QVector<Level> levels;
+
+    BoundingBox bounds;
+    for (const QVector3D& p : input.positions) {
+        bounds.expand(p);
+    }
+    const QVector3D size = bounds.size();
+    const float extent = qMax(size.x(), qMax(size.y(), size.z()));
+    int previousTriangles = input.triangles.size() / 3;
+    if (bounds.isEmpty() || extent <= 0.0f || previousTriangles <= minTriangles) {
+        return levels;
+    }
+
+    // A surface with n triangles covers roughly n / 2 cells at full detail
+    int resolution = qBound(MinResolution, int(std::sqrt(previousTriangles / 2.0)), MaxResolution);
+    for (; resolution >= MinResolution && levels.size() < maxLevels; resolution /= 2) {
+        Level level = simplify(input, extent / resolution);
+        if (level.triangleCount < minTriangles) {
+            break;
+        }
+        if (level.triangleCount > previousTriangles * (1.0f - MinReduction)) {
+            continue;  // Not worth a level; try a coarser grid
+        }
+        previousTriangles = level.triangleCount;
+        levels.append(std::move(level));
+    }
+    return levels;
+}
+
+MeshSimplifier::Level MeshSimplifier::simplify(const Input& input, float cellSize)
+{
+    Level level;
+    level.error = cellSize;
+
+    BoundingBox bounds;
+    for (const QVector3D& p : input.positions) {
+        bounds.expand(p);
+    }
+    const QVector3D origin = bounds.min();
+
+    // Cluster vertices by grid cell; each cluster moves to its mean position
+    QHash<quint64, int> clusterOfCell;
+    QVector<int> clusterOfVertex(input.positions.size());
+    QVector<QVector3D> clusterSum;
+    QVector<int> clusterCount;
+    for (int i = 0; i < input.positions.size(); ++i) {
+        const QVector3D cell = (input.positions[i] - origin) / cellSize;
+        const quint64 key = packKey(quint64(cell.x()), quint64(cell.y()), quint64(cell.z()));
+        auto it = clusterOfCell.find(key);
+        if (it == clusterOfCell.end()) {
+            it = clusterOfCell.insert(key, clusterSum.size());
+            clusterSum.append(QVector3D());
+            clusterCount.append(0);
+        }
+        clusterOfVertex[i] = it.value();
+        clusterSum[it.value()] += input.positions[i];
+        ++clusterCount[it.value()];
+    }
+    for (int c = 0; c < clusterSum.size(); ++c) {
+        clusterSum[c] /= float(clusterCount[c]);
+    }
+
+    // Keep triangles whose corners land in three clusters, once each
+    QSet<quint64> seen;
+    QVector<float> out;
+    out.reserve(input.triangles.size() * 6);
+    for (int t = 0; t + 2 < input.triangles.size(); t += 3) {
+        int c[3] = { clusterOfVertex[input.triangles[t]],
+                     clusterOfVertex[input.triangles[t + 1]],
+                     clusterOfVertex[input.triangles[t + 2]] };
+        if (c[0] == c[1] || c[1] == c[2] || c[0] == c[2]) {
+            continue;
+        }
+        int sorted[3] = { c[0], c[1], c[2] };
+        std::sort(sorted, sorted + 3);
+        if (seen.contains(packKey(sorted[0], sorted[1], sorted[2]))) {
+            continue;
+        }
+        seen.insert(packKey(sorted[0], sorted[1], sorted[2]));
+
+        const QVector3D& p0 = clusterSum[c[0]];
+        const QVector3D& p1 = clusterSum[c[1]];
+        const QVector3D& p2 = clusterSum[c[2]];
+        const QVector3D normal = QVector3D::crossProduct(p1 - p0, p2 - p0).normalized();
+        if (normal.isNull()) {
+            continue;
+        }
+        for (const QVector3D* p : { &p0, &p1, &p2 }) {
+            out << p->x() << p->y() << p->z() << normal.x() << normal.y() << normal.z();
+        }
+        ++level.triangleCount;
+    }
+
+    level.vertexData = QByteArray(reinterpret_cast<const char*>(out.constData()),
+                                  out.size() * qsizetype(sizeof(float)));
+    return level;
+}
+
+Qt3DCore::QGeometry* MeshSimplifier::createGeometry(const Level& level, Qt3DCore::QNode* parent)
+{
+    const int vertexCount = level.triangleCount * 3;
+    auto* geometry = new Qt3DCore::QGeometry(parent);
+
+    auto* vertexBuffer = new Qt3DCore::QBuffer(geometry);
+    vertexBuffer->setData(level.vertexData);
+    RenderCounters::addUploadedBytes(level.vertexData.size());
+
+    auto* positionAttribute = new Qt3DCore::QAttribute(geometry);
+    positionAttribute->setName(Qt3DCore::QAttribute::defaultPositionAttributeName());
+    positionAttribute->setVertexBaseType(Qt3DCore::QAttribute::Float);
+    positionAttribute->setVertexSize(3);
+    positionAttribute->setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+    positionAttribute->setBuffer(vertexBuffer);
+    positionAttribute->setByteOffset(0);
+    positionAttribute->setByteStride(MeshData::VertexStride);
+    positionAttribute->setCount(vertexCount);
+    geometry->addAttribute(positionAttribute);
+
+    auto* normalAttribute = new Qt3DCore::QAttribute(geometry);
+    normalAttribute->setName(Qt3DCore::QAttribute::defaultNormalAttributeName());
+    normalAttribute->setVertexBaseType(Qt3DCore::QAttribute::Float);
+    normalAttribute->setVertexSize(3);
+    normalAttribute->setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+    normalAttribute->setBuffer(vertexBuffer);
+    normalAttribute->setByteOffset(3 * sizeof(float));
+    normalAttribute->setByteStride(MeshData::VertexStride);
+    normalAttribute->setCount(vertexCount);
+    geometry->addAttribute(normalAttribute);
+
+    return geometry;
+}
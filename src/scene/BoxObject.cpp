@@ -1,4 +1,5 @@
 #include "scene/BoxObject.h"
+#include "scene/GeometryCache.h"
 #include "mesh/MeshData.h"
 #include <Qt3DRender/QGeometryRenderer>
 #include <Qt3DExtras/QPhongMaterial>
@@ -19,12 +20,29 @@ BoxObject::BoxObject(float width, float height, float depth, Qt3DCore::QNode *pa
     initialize();
 }
 
+BoxObject::BoxObject(const QVector3D& dimensions, GeometryCache* cache, Qt3DCore::QNode *parent)
+    : SceneObject(parent)
+{
+    m_geometryCache = cache;
+    setName("Box");
+    setDimensions(dimensions);
+    initialize();
+}
+
 BoxObject::~BoxObject()
 {
 }
 
 void BoxObject::initialize()
 {
+    if (m_geometryCache) {
+        // Material and geometry renderer are shared through the cache
+        updateSharedMaterial();
+        regenerateMesh();
+        qDebug() << "BoxObject initialized with dimensions:" << dimensions() << "(shared)";
+        return;
+    }
+
     // Create material
     auto* material = new Qt3DExtras::QPhongMaterial(this);
     material->setDiffuse(QColor(120, 150, 220));      // Blue
@@ -40,8 +58,7 @@ void BoxObject::initialize()
     addComponent(m_renderer);
 
     // Generate initial mesh
-    generateMesh();
-    updateGeometry();
+    regenerateMesh();
 
     qDebug() << "BoxObject initialized with dimensions:" << dimensions();
 }
@@ -97,3 +114,8 @@ void BoxObject::generateMesh()
              << m_meshData->vertexCount() << "vertices,"
              << m_meshData->faceCount() << "faces";
 }
+
+QString BoxObject::geometryKey() const
+{
+    return GeometryCache::boxKey(dimensions());
+}
@@ -8,6 +8,7 @@ Collection::Collection(const QString& name, QObject* parent)
     , m_uuid(QUuid::createUuid())
     , m_visible(true)
     , m_parentCollection(nullptr)
+    , m_boundsValid(false)
 {
 }
 
@@ -50,11 +51,14 @@ void Collection::setVisible(bool visible)
 
 void Collection::addObject(SceneObject* object)
 {
-    if (!object || m_objects.contains(object)) {
+    if (!object || m_objectSet.contains(object)) {
         return;
     }
 
     m_objects.append(object);
+    m_objectSet.insert(object);
+    connect(object, &SceneObject::boundsChanged, this, &Collection::invalidateBounds);
+    invalidateBounds();
 
     // Apply collection visibility to object
     if (!m_visible) {
@@ -66,14 +70,42 @@ void Collection::addObject(SceneObject* object)
 
 void Collection::removeObject(SceneObject* object)
 {
-    if (m_objects.removeOne(object)) {
+    if (m_objectSet.remove(object)) {
+        m_objects.removeOne(object);
+        disconnect(object, &SceneObject::boundsChanged, this, &Collection::invalidateBounds);
+        invalidateBounds();
+        emit objectRemoved(object);
+    }
+}
+
+void Collection::removeObjects(const QVector<SceneObject*>& objects)
+{
+    QSet<SceneObject*> removed;
+    for (SceneObject* object : objects) {
+        if (m_objectSet.remove(object)) {
+            removed.insert(object);
+        }
+    }
+    if (removed.isEmpty()) {
+        return;
+    }
+
+    // Keep the order of the remaining objects
+    m_objects.removeIf([&removed](SceneObject* object) { return removed.contains(object); });
+
+    for (SceneObject* object : removed) {
+        disconnect(object, &SceneObject::boundsChanged, this, &Collection::invalidateBounds);
+    }
+    invalidateBounds();
+
+    for (SceneObject* object : removed) {
         emit objectRemoved(object);
     }
 }
 
 bool Collection::containsObject(SceneObject* object) const
 {
-    return m_objects.contains(object);
+    return m_objectSet.contains(object);
 }
 
 void Collection::addChildCollection(Collection* collection)
@@ -84,6 +116,7 @@ void Collection::addChildCollection(Collection* collection)
 
     m_childCollections.append(collection);
     collection->setParentCollection(this);
+    invalidateBounds();
 
     // Apply visibility to child
     if (!m_visible) {
@@ -97,6 +130,7 @@ void Collection::removeChildCollection(Collection* collection)
 {
     if (m_childCollections.removeOne(collection)) {
         collection->setParentCollection(nullptr);
+        invalidateBounds();
         emit childCollectionRemoved(collection);
     }
 }
@@ -105,3 +139,29 @@ void Collection::setParentCollection(Collection* parent)
 {
     m_parentCollection = parent;
 }
+
+BoundingBox Collection::bounds() const
+{
+    if (!m_boundsValid) {
+        m_bounds = BoundingBox();
+        for (const SceneObject* object : m_objects) {
+            if (object->isVisible()) {
+                m_bounds.expand(object->worldBounds());
+            }
+        }
+        for (const Collection* child : m_childCollections) {
+            m_bounds.expand(child->bounds());
+        }
+        m_boundsValid = true;
+    }
+    return m_bounds;
+}
+
+void Collection::invalidateBounds()
+{
+    // Ancestors are already invalid if we are
+    for (Collection* collection = this; collection && collection->m_boundsValid;
+         collection = collection->m_parentCollection) {
+        collection->m_boundsValid = false;
+    }
+}
@@ -0,0 +1,137 @@
+#include "scene/GeometryCache.h"
+#include "mesh/MeshData.h"
+#include <Qt3DCore/QNode>
+#include <Qt3DCore/QGeometry>
+#include <Qt3DRender/QGeometryRenderer>
+#include <Qt3DExtras/QPhongMaterial>
+#include <QDebug>
+
+GeometryCache::GeometryCache(Qt3DCore::QNode* sharedParent, QObject* parent)
+    : QObject(parent)
+    , m_sharedParent(sharedParent)
+{
+}
+
+GeometryCache::~GeometryCache()
+{
+    // Shared nodes are children of m_sharedParent and go away with the scene
+    if (!m_renderers.isEmpty() || !m_materials.isEmpty()) {
+        qDebug() << "GeometryCache destroyed with" << m_renderers.size() << "renderers and"
+                 << m_materials.size() << "materials still referenced";
+    }
+}
+
+Qt3DRender::QGeometryRenderer* GeometryCache::acquireRenderer(const QString& key, MeshData& mesh)
+{
+    auto it = m_renderers.find(key);
+    if (it != m_renderers.end()) {
+        ++it->refCount;
+        return it->node;
+    }
+
+    auto* renderer = new Qt3DRender::QGeometryRenderer(m_sharedParent);
+    renderer->setPrimitiveType(Qt3DRender::QGeometryRenderer::Triangles);
+    renderer->setGeometry(mesh.generateGeometry(renderer));
+
+    Entry<Qt3DRender::QGeometryRenderer> entry;
+    entry.node = renderer;
+    entry.refCount = 1;
+    m_renderers.insert(key, entry);
+    m_rendererKeys.insert(renderer, key);
+
+    qDebug() << "GeometryCache: new shared geometry" << key;
+    return renderer;
+}
+
+void GeometryCache::releaseRenderer(Qt3DRender::QGeometryRenderer* renderer)
+{
+    auto keyIt = m_rendererKeys.find(renderer);
+    if (keyIt == m_rendererKeys.end()) {
+        qWarning() << "GeometryCache: releasing unknown renderer";
+        return;
+    }
+
+    auto it = m_renderers.find(keyIt.value());
+    if (--it->refCount > 0) {
+        return;
+    }
+
+    m_renderers.erase(it);
+    m_rendererKeys.erase(keyIt);
+    renderer->deleteLater();
+}
+
+bool GeometryCache::isShared(Qt3DRender::QGeometryRenderer* renderer) const
+{
+    return m_rendererKeys.contains(renderer);
+}
+
+int GeometryCache::refCount(Qt3DRender::QGeometryRenderer* renderer) const
+{
+    auto keyIt = m_rendererKeys.constFind(renderer);
+    if (keyIt == m_rendererKeys.constEnd()) {
+        return 0;
+    }
+    return m_renderers.value(keyIt.value()).refCount;
+}
+
+Qt3DRender::QMaterial* GeometryCache::acquireMaterial(int materialId, bool selected)
+{
+    const QString key = QString("%1/%2").arg(materialId).arg(selected ? "selected" : "normal");
+
+    auto it = m_materials.find(key);
+    if (it != m_materials.end()) {
+        ++it->refCount;
+        return it->node;
+    }
+
+    auto* material = new Qt3DExtras::QPhongMaterial(m_sharedParent);
+    if (selected) {
+        material->setDiffuse(QColor(255, 140, 0));  // Orange
+        material->setAmbient(QColor(127, 70, 0));
+    } else {
+        material->setDiffuse(QColor(120, 150, 220));  // Default blue
+        material->setAmbient(QColor(60, 75, 110));
+    }
+    material->setSpecular(QColor(255, 255, 255));
+    material->setShininess(50.0f);
+
+    Entry<Qt3DRender::QMaterial> entry;
+    entry.node = material;
+    entry.refCount = 1;
+    m_materials.insert(key, entry);
+    m_materialKeys.insert(material, key);
+    return material;
+}
+
+void GeometryCache::releaseMaterial(Qt3DRender::QMaterial* material)
+{
+    auto keyIt = m_materialKeys.find(material);
+    if (keyIt == m_materialKeys.end()) {
+        qWarning() << "GeometryCache: releasing unknown material";
+        return;
+    }
+
+    auto it = m_materials.find(keyIt.value());
+    if (--it->refCount > 0) {
+        return;
+    }
+
+    m_materials.erase(it);
+    m_materialKeys.erase(keyIt);
+    material->deleteLater();
+}
+
+bool GeometryCache::isShared(Qt3DRender::QMaterial* material) const
+{
+    return m_materialKeys.contains(material);
+}
+
+QString GeometryCache::boxKey(const QVector3D& dimensions)
+{
+    // Quantize so that 2.0 and 2.0000001 land on the same entry
+    return QString("box/%1/%2/%3")
+        .arg(qRound64(dimensions.x() * 10000.0))
+        .arg(qRound64(dimensions.y() * 10000.0))
+        .arg(qRound64(dimensions.z() * 10000.0));
+}
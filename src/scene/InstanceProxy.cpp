@@ -0,0 +1,109 @@
+#include "scene/InstanceProxy.h"
+#include "scene/InstancedObject.h"
+#include "mesh/MeshData.h"
+#include <Qt3DRender/QGeometryRenderer>
+#include <Qt3DExtras/QPhongMaterial>
+#include <QDebug>
+
+InstanceProxy::InstanceProxy(InstancedObject* group, int slot)
+    : SceneObject(group)
+    , m_group(group)
+    , m_slot(slot)
+    , m_detached(false)
+{
+    setDimensions(group->baseDimensions());
+}
+
+InstanceProxy::~InstanceProxy()
+{
+    if (m_group) {
+        m_group->removeInstance(this);
+    }
+}
+
+QMatrix4x4 InstanceProxy::instanceMatrix() const
+{
+    // The shared mesh is built at the group's base dimensions
+    QMatrix4x4 matrix = m_transform->matrix();
+    if (m_group) {
+        const QVector3D base = m_group->baseDimensions();
+        const QVector3D dim = dimensions();
+        matrix.scale(base.x() != 0.0f ? dim.x() / base.x() : 1.0f,
+                     base.y() != 0.0f ? dim.y() / base.y() : 1.0f,
+                     base.z() != 0.0f ? dim.z() / base.z() : 1.0f);
+    }
+    return matrix;
+}
+
+void InstanceProxy::updateGeometry()
+{
+    // Edited meshes no longer match the shared one
+    if (!m_detached) {
+        detachFromGroup();
+    }
+    SceneObject::updateGeometry();
+}
+
+void InstanceProxy::generateMesh()
+{
+    if (!m_group) {
+        return;
+    }
+
+    // Our own copy of the shared mesh at our dimensions, for Edit Mode
+    *m_meshData = m_group->baseMesh();
+
+    const QVector3D base = m_group->baseDimensions();
+    const QVector3D dim = dimensions();
+    const QVector3D factor(base.x() != 0.0f ? dim.x() / base.x() : 1.0f,
+                           base.y() != 0.0f ? dim.y() / base.y() : 1.0f,
+                           base.z() != 0.0f ? dim.z() / base.z() : 1.0f);
+    if (factor == QVector3D(1.0f, 1.0f, 1.0f)) {
+        return;
+    }
+
+    const QVector<MeshData::Vertex> vertices = m_meshData->getVertices();
+    for (const MeshData::Vertex& v : vertices) {
+        m_meshData->updateVertex(v.index, v.position * factor);
+    }
+}
+
+void InstanceProxy::rebuildGeometry()
+{
+    // Attached: the group draws us from the shared mesh and our instance row
+    if (!m_detached) {
+        if (m_group) {
+            m_group->markDirty(this);
+        }
+        return;
+    }
+
+    SceneObject::rebuildGeometry();
+}
+
+void InstanceProxy::detachFromGroup()
+{
+    if (m_detached) {
+        return;
+    }
+
+    auto* material = new Qt3DExtras::QPhongMaterial(this);
+    material->setDiffuse(isSelected() ? QColor(255, 140, 0) : QColor(120, 150, 220));
+    material->setAmbient(isSelected() ? QColor(127, 70, 0) : QColor(60, 75, 110));
+    material->setSpecular(QColor(255, 255, 255));
+    material->setShininess(50.0f);
+    m_material = material;
+    addComponent(m_material);
+
+    m_renderer = new Qt3DRender::QGeometryRenderer(this);
+    m_renderer->setPrimitiveType(Qt3DRender::QGeometryRenderer::Triangles);
+    addComponent(m_renderer);
+
+    // Hide our row in the instance buffer
+    m_detached = true;
+    if (m_group) {
+        m_group->markDirty(this);
+    }
+
+    qDebug() << "Instance detached from group:" << name();
+}
@@ -0,0 +1,367 @@
+#include "scene/InstancedObject.h"
+#include "scene/InstanceProxy.h"
+#include "core/RenderCounters.h"
+#include <Qt3DCore/QGeometry>
+#include <Qt3DCore/QAttribute>
+#include <Qt3DCore/QBuffer>
+#include <Qt3DCore/QBoundingVolume>
+#include <Qt3DRender/QGeometryRenderer>
+#include <Qt3DRender/QMaterial>
+#include <Qt3DRender/QEffect>
+#include <Qt3DRender/QTechnique>
+#include <Qt3DRender/QRenderPass>
+#include <Qt3DRender/QShaderProgram>
+#include <Qt3DRender/QGraphicsApiFilter>
+#include <Qt3DRender/QFilterKey>
+#include <QDebug>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// Headlight shading close to the default Phong look (ambient = diffuse / 2)
+const char* const instancedVertexShader = R"(
+#version 330 core
+
+in vec3 vertexPosition;
+in vec3 vertexNormal;
+in vec4 instanceModel0;
+in vec4 instanceModel1;
+in vec4 instanceModel2;
+in vec4 instanceModel3;
+in vec4 instanceColor;
+
+out vec3 worldPosition;
+out vec3 worldNormal;
+out vec4 color;
+
+uniform mat4 modelMatrix;
+uniform mat4 viewProjectionMatrix;
+
+void main()
+{
+    mat4 model = modelMatrix * mat4(instanceModel0, instanceModel1, instanceModel2, instanceModel3);
+    vec4 world = model * vec4(vertexPosition, 1.0);
+
+    worldPosition = world.xyz;
+    worldNormal = transpose(inverse(mat3(model))) * vertexNormal;
+    color = instanceColor;
+    gl_Position = viewProjectionMatrix * world;
+}
+)";
+
+const char* const instancedFragmentShader = R"(
+#version 330 core
+
+in vec3 worldPosition;
+in vec3 worldNormal;
+in vec4 color;
+
+out vec4 fragColor;
+
+uniform vec3 eyePosition;
+
+void main()
+{
+    vec3 n = normalize(worldNormal);
+    vec3 v = normalize(eyePosition - worldPosition);
+    float ndotv = max(dot(n, v), 0.0);
+
+    vec3 rgb = color.rgb * (0.5 + 0.5 * ndotv) + vec3(pow(ndotv, 50.0)) * 0.2;
+    fragColor = vec4(rgb, color.a);
+}
+)";
+
+// ID pass (see PickIdPass): writes the instance's pick id, or 0 while a
+// single object is being picked for its faces in Edit Mode
+const char* const instancedPickVertexShader = R"(
+#version 330 core
+
+in vec3 vertexPosition;
+in vec4 instanceModel0;
+in vec4 instanceModel1;
+in vec4 instanceModel2;
+in vec4 instanceModel3;
+in float instancePickId;
+
+flat out int pickId;
+
+uniform mat4 modelMatrix;
+uniform mat4 viewProjectionMatrix;
+
+void main()
+{
+    mat4 model = modelMatrix * mat4(instanceModel0, instanceModel1, instanceModel2, instanceModel3);
+    pickId = int(instancePickId + 0.5);
+    gl_Position = viewProjectionMatrix * model * vec4(vertexPosition, 1.0);
+}
+)";
+
+const char* const instancedPickFragmentShader = R"(
+#version 330 core
+
+flat in int pickId;
+
+out vec4 fragColor;
+
+uniform int editObjectId;
+
+void main()
+{
+    int value = editObjectId == 0 ? pickId : 0;
+    fragColor = vec4(value & 0xff, (value >> 8) & 0xff, (value >> 16) & 0xff, 255) / 255.0;
+}
+)";
+
+Qt3DRender::QTechnique* createTechnique(Qt3DRender::QEffect* effect, const QString& renderingStyle,
+                                        const char* vertexShader, const char* fragmentShader)
+{
+    auto* technique = new Qt3DRender::QTechnique(effect);
+
+    technique->graphicsApiFilter()->setApi(Qt3DRender::QGraphicsApiFilter::OpenGL);
+    technique->graphicsApiFilter()->setProfile(Qt3DRender::QGraphicsApiFilter::CoreProfile);
+    technique->graphicsApiFilter()->setMajorVersion(3);
+    technique->graphicsApiFilter()->setMinorVersion(3);
+
+    // Frame graph branches select techniques by rendering style
+    auto* filterKey = new Qt3DRender::QFilterKey(technique);
+    filterKey->setName(QStringLiteral("renderingStyle"));
+    filterKey->setValue(renderingStyle);
+    technique->addFilterKey(filterKey);
+
+    auto* shader = new Qt3DRender::QShaderProgram(technique);
+    shader->setVertexShaderCode(vertexShader);
+    shader->setFragmentShaderCode(fragmentShader);
+
+    auto* pass = new Qt3DRender::QRenderPass(technique);
+    pass->setShaderProgram(shader);
+    technique->addRenderPass(pass);
+
+    effect->addTechnique(technique);
+    return technique;
+}
+
+Qt3DRender::QMaterial* createInstancedMaterial(Qt3DCore::QNode* parent)
+{
+    auto* material = new Qt3DRender::QMaterial(parent);
+    auto* effect = new Qt3DRender::QEffect(material);
+
+    // QForwardRenderer draws "forward"; the ID pass draws "pickId"
+    createTechnique(effect, QStringLiteral("forward"), instancedVertexShader, instancedFragmentShader);
+    createTechnique(effect, QStringLiteral("pickId"), instancedPickVertexShader, instancedPickFragmentShader);
+
+    material->setEffect(effect);
+    return material;
+}
+
+Qt3DCore::QAttribute* createInstanceAttribute(Qt3DCore::QBuffer* buffer, const QString& name, int offset,
+                                              int size = 4)
+{
+    auto* attribute = new Qt3DCore::QAttribute();
+    attribute->setName(name);
+    attribute->setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+    attribute->setVertexBaseType(Qt3DCore::QAttribute::Float);
+    attribute->setVertexSize(size);
+    attribute->setBuffer(buffer);
+    attribute->setByteOffset(offset);
+    attribute->setByteStride(InstancedObject::InstanceStride);
+    attribute->setDivisor(1);
+    return attribute;
+}
+
+} // namespace
+
+InstancedObject::InstancedObject(const MeshData& mesh, const QVector3D& baseDimensions,
+                                 Qt3DCore::QNode *parent)
+    : Qt3DCore::QEntity(parent)
+    , m_mesh(mesh)
+    , m_baseDimensions(baseDimensions)
+    , m_countChanged(false)
+    , m_uploadPending(false)
+    , m_renderer(new Qt3DRender::QGeometryRenderer(this))
+    , m_material(createInstancedMaterial(this))
+    , m_instanceBuffer(nullptr)
+    , m_boundingVolume(new Qt3DCore::QBoundingVolume(this))
+{
+    // Local bounds of the shared mesh, used to bound the whole group
+    const float inf = std::numeric_limits<float>::max();
+    m_meshMin = QVector3D(inf, inf, inf);
+    m_meshMax = QVector3D(-inf, -inf, -inf);
+    for (const MeshData::Vertex& v : m_mesh.getVertices()) {
+        m_meshMin = QVector3D(qMin(m_meshMin.x(), v.position.x()), qMin(m_meshMin.y(), v.position.y()),
+                              qMin(m_meshMin.z(), v.position.z()));
+        m_meshMax = QVector3D(qMax(m_meshMax.x(), v.position.x()), qMax(m_meshMax.y(), v.position.y()),
+                              qMax(m_meshMax.z(), v.position.z()));
+    }
+
+    // Mesh buffers once, plus the per-instance buffer
+    Qt3DCore::QGeometry* geometry = m_mesh.generateGeometry(m_renderer);
+    m_instanceBuffer = new Qt3DCore::QBuffer(geometry);
+    geometry->addAttribute(createInstanceAttribute(m_instanceBuffer, QStringLiteral("instanceModel0"), 0));
+    geometry->addAttribute(createInstanceAttribute(m_instanceBuffer, QStringLiteral("instanceModel1"), 4 * sizeof(float)));
+    geometry->addAttribute(createInstanceAttribute(m_instanceBuffer, QStringLiteral("instanceModel2"), 8 * sizeof(float)));
+    geometry->addAttribute(createInstanceAttribute(m_instanceBuffer, QStringLiteral("instanceModel3"), 12 * sizeof(float)));
+    geometry->addAttribute(createInstanceAttribute(m_instanceBuffer, QStringLiteral("instanceColor"), 16 * sizeof(float)));
+    geometry->addAttribute(createInstanceAttribute(m_instanceBuffer, QStringLiteral("instancePickId"), 20 * sizeof(float), 1));
+
+    m_renderer->setPrimitiveType(Qt3DRender::QGeometryRenderer::Triangles);
+    m_renderer->setGeometry(geometry);
+    m_renderer->setInstanceCount(0);
+
+    addComponent(m_renderer);
+    addComponent(m_material);
+    addComponent(m_boundingVolume);
+
+    qDebug() << "InstancedObject created:" << m_mesh.faceCount() << "faces per instance";
+}
+
+InstancedObject::~InstancedObject()
+{
+    // Proxies are our children; keep them from calling back while we go away
+    for (InstanceProxy* proxy : m_instances) {
+        proxy->m_group = nullptr;
+    }
+}
+
+InstanceProxy* InstancedObject::addInstance(const QVector3D& location)
+{
+    auto* proxy = new InstanceProxy(this, m_instances.size());
+    m_instances.append(proxy);
+    proxy->setLocation(location);
+
+    connect(proxy, &SceneObject::transformChanged, this, [this, proxy]() { markDirty(proxy); });
+    connect(proxy, &SceneObject::propertiesChanged, this, [this, proxy]() { markDirty(proxy); });
+    connect(proxy, &SceneObject::selectionChanged, this, [this, proxy]() { markDirty(proxy); });
+
+    m_countChanged = true;
+    scheduleUpload();
+    return proxy;
+}
+
+void InstancedObject::removeInstance(InstanceProxy* proxy)
+{
+    int slot = proxy->m_slot;
+    if (slot < 0 || slot >= m_instances.size() || m_instances[slot] != proxy) {
+        qWarning() << "InstancedObject: removing unknown instance";
+        return;
+    }
+
+    // Swap-remove: last instance takes over the freed row
+    InstanceProxy* last = m_instances.last();
+    m_instances[slot] = last;
+    last->m_slot = slot;
+    m_instances.removeLast();
+    proxy->m_slot = -1;
+    disconnect(proxy, nullptr, this, nullptr);
+
+    m_countChanged = true;
+    scheduleUpload();
+
+    if (m_instances.isEmpty()) {
+        deleteLater();
+    }
+}
+
+void InstancedObject::markDirty(InstanceProxy* proxy)
+{
+    // Not (or no longer) in the buffer, e.g. still being constructed
+    if (m_instances.value(proxy->m_slot) != proxy) {
+        return;
+    }
+    m_dirtySlots.insert(proxy->m_slot);
+    scheduleUpload();
+}
+
+void InstancedObject::scheduleUpload()
+{
+    if (!m_uploadPending) {
+        m_uploadPending = true;
+        QMetaObject::invokeMethod(this, &InstancedObject::uploadInstances, Qt::QueuedConnection);
+    }
+}
+
+void InstancedObject::uploadInstances()
+{
+    m_uploadPending = false;
+
+    const int floatsPerInstance = InstanceStride / sizeof(float);
+
+    if (m_countChanged || m_dirtySlots.size() * 4 > m_instances.size()) {
+        // Count changed or most rows touched: replace the whole buffer
+        QByteArray data(m_instances.size() * InstanceStride, Qt::Uninitialized);
+        float* out = reinterpret_cast<float*>(data.data());
+        for (const InstanceProxy* proxy : m_instances) {
+            writeInstance(proxy, out);
+            out += floatsPerInstance;
+        }
+        m_instanceBuffer->setData(data);
+        RenderCounters::addUploadedBytes(data.size());
+        m_renderer->setInstanceCount(m_instances.size());
+    } else {
+        // A few rows changed (move/select one instance): patch them in place
+        QByteArray row(InstanceStride, Qt::Uninitialized);
+        for (int slot : m_dirtySlots) {
+            writeInstance(m_instances[slot], reinterpret_cast<float*>(row.data()));
+            m_instanceBuffer->updateData(slot * InstanceStride, row);
+            RenderCounters::addUploadedBytes(row.size());
+        }
+    }
+
+    m_countChanged = false;
+    m_dirtySlots.clear();
+    updateBounds();
+}
+
+void InstancedObject::writeInstance(const InstanceProxy* proxy, float* out) const
+{
+    // Hidden and detached instances collapse to a point and draw nothing
+    if (!proxy->isVisible() || proxy->isDetached()) {
+        std::memset(out, 0, InstanceStride);
+        return;
+    }
+
+    const QMatrix4x4 matrix = proxy->instanceMatrix();
+    std::memcpy(out, matrix.constData(), 16 * sizeof(float));
+
+    if (proxy->isSelected()) {
+        out[16] = 255 / 255.0f;  // Orange
+        out[17] = 140 / 255.0f;
+        out[18] = 0.0f;
+    } else {
+        out[16] = 120 / 255.0f;  // Default blue
+        out[17] = 150 / 255.0f;
+        out[18] = 220 / 255.0f;
+    }
+    out[19] = 1.0f;
+
+    // Pick ids stay below 2^24, so the float is exact
+    out[20] = float(proxy->pickId());
+}
+
+void InstancedObject::updateBounds()
+{
+    // Explicit bounds so frustum culling sees every instance, not just the mesh
+    const float inf = std::numeric_limits<float>::max();
+    QVector3D minPoint(inf, inf, inf);
+    QVector3D maxPoint(-inf, -inf, -inf);
+
+    for (const InstanceProxy* proxy : m_instances) {
+        if (!proxy->isVisible() || proxy->isDetached()) continue;
+
+        const QMatrix4x4 matrix = proxy->instanceMatrix();
+        for (int corner = 0; corner < 8; ++corner) {
+            QVector3D p(corner & 1 ? m_meshMax.x() : m_meshMin.x(),
+                        corner & 2 ? m_meshMax.y() : m_meshMin.y(),
+                        corner & 4 ? m_meshMax.z() : m_meshMin.z());
+            p = matrix.map(p);
+            minPoint = QVector3D(qMin(minPoint.x(), p.x()), qMin(minPoint.y(), p.y()), qMin(minPoint.z(), p.z()));
+            maxPoint = QVector3D(qMax(maxPoint.x(), p.x()), qMax(maxPoint.y(), p.y()), qMax(maxPoint.z(), p.z()));
+        }
+    }
+
+    if (minPoint.x() > maxPoint.x()) {
+        minPoint = maxPoint = QVector3D();
+    }
+    m_boundingVolume->setMinPoint(minPoint);
+    m_boundingVolume->setMaxPoint(maxPoint);
+}
@@ -1,11 +1,19 @@
 #include "scene/ObjectManager.h"
 #include "scene/SceneObject.h"
 #include "scene/BoxObject.h"
+#include "scene/GeometryCache.h"
+#include "scene/InstancedObject.h"
+#include "scene/InstanceProxy.h"
+#include "mesh/MeshData.h"
 #include <QDebug>
+#include <utility>
 
 ObjectManager::ObjectManager(Qt3DCore::QEntity* rootEntity, QObject *parent)
     : QObject(parent)
     , m_rootEntity(rootEntity)
+    , m_geometryCache(new GeometryCache(rootEntity, this))
+    , m_bulkDepth(0)
+    , m_sceneBoundsValid(true)
 {
     qDebug() << "ObjectManager created";
 }
@@ -15,44 +23,155 @@ ObjectManager::~ObjectManager()
     // Clean up all objects
     qDeleteAll(m_objects);
     m_objects.clear();
+    m_objectSlots.clear();
 }
 
 void ObjectManager::addObject(SceneObject* object)
+{
+    BulkEdit bulk(this);
+    insertObject(object);
+}
+
+void ObjectManager::removeObject(SceneObject* object)
+{
+    BulkEdit bulk(this);
+    takeObject(object);
+}
+
+void ObjectManager::addObjects(const QVector<SceneObject*>& objects)
+{
+    BulkEdit bulk(this);
+    m_objects.reserve(m_objects.size() + objects.size());
+    m_objectSlots.reserve(m_objects.size() + objects.size());
+    for (SceneObject* object : objects) {
+        insertObject(object);
+    }
+}
+
+void ObjectManager::removeObjects(const QVector<SceneObject*>& objects)
+{
+    BulkEdit bulk(this);
+    for (SceneObject* object : objects) {
+        takeObject(object);
+    }
+}
+
+bool ObjectManager::insertObject(SceneObject* object)
 {
     if (!object) {
         qWarning() << "Cannot add null object";
-        return;
+        return false;
     }
 
-    if (m_objects.contains(object)) {
+    if (m_objectSlots.contains(object->uuid())) {
         qWarning() << "Object already managed:" << object->name();
-        return;
+        return false;
     }
 
+    m_objectSlots.insert(object->uuid(), m_objects.size());
     m_objects.append(object);
-    qDebug() << "Object added:" << object->name() << "Total objects:" << m_objects.size();
+    m_pendingAdded.append(object);
+    m_pendingAddedSet.insert(object);
+
+    if (m_sceneBoundsValid && object->isVisible()) {
+        m_sceneBounds.expand(object->worldBounds());
+    }
+    connect(object, &SceneObject::boundsChanged, this, [this]() { m_sceneBoundsValid = false; });
     emit objectAdded(object);
+    return true;
 }
 
-void ObjectManager::removeObject(SceneObject* object)
+bool ObjectManager::takeObject(SceneObject* object)
 {
     if (!object) {
         qWarning() << "Cannot remove null object";
-        return;
+        return false;
     }
 
-    int index = m_objects.indexOf(object);
-    if (index == -1) {
+    int slot = m_objectSlots.value(object->uuid(), -1);
+    if (slot == -1 || m_objects[slot] != object) {
         qWarning() << "Object not managed:" << object->name();
-        return;
+        return false;
     }
 
-    m_objects.removeAt(index);
-    qDebug() << "Object removed:" << object->name() << "Total objects:" << m_objects.size();
+    // Swap-remove: the last object takes over the freed slot
+    SceneObject* last = m_objects.last();
+    m_objects[slot] = last;
+    m_objectSlots[last->uuid()] = slot;
+    m_objects.removeLast();
+    m_objectSlots.remove(object->uuid());
+    disconnect(object, &SceneObject::boundsChanged, this, nullptr);
+    m_sceneBoundsValid = false;
     emit objectRemoved(object);
 
+    // Added and removed within the same bulk edit: nothing to announce
+    if (!m_pendingAddedSet.remove(object)) {
+        m_pendingRemoved.append(object);
+    }
+
     // Delete the object
     object->deleteLater();
+    return true;
+}
+
+void ObjectManager::beginBulkEdit()
+{
+    ++m_bulkDepth;
+}
+
+void ObjectManager::endBulkEdit()
+{
+    if (--m_bulkDepth > 0) {
+        return;
+    }
+
+    // Take the lists first: listeners may start another edit
+    const QVector<SceneObject*> removed = std::exchange(m_pendingRemoved, {});
+    QVector<SceneObject*> added = std::exchange(m_pendingAdded, {});
+    const QSet<SceneObject*> stillAdded = std::exchange(m_pendingAddedSet, {});
+    if (stillAdded.size() != added.size()) {
+        added.removeIf([&stillAdded](SceneObject* object) { return !stillAdded.contains(object); });
+    }
+
+    if (!removed.isEmpty()) {
+        qDebug() << "Objects removed:" << removed.size() << "Total objects:" << m_objects.size();
+        emit objectsRemoved(removed);
+    }
+    if (!added.isEmpty()) {
+        qDebug() << "Objects added:" << added.size() << "Total objects:" << m_objects.size();
+        emit objectsAdded(added);
+    }
+}
+
+ObjectManager::BulkEdit::BulkEdit(ObjectManager* manager)
+    : m_manager(manager)
+{
+    m_manager->beginBulkEdit();
+}
+
+ObjectManager::BulkEdit::~BulkEdit()
+{
+    m_manager->endBulkEdit();
+}
+
+BoundingBox ObjectManager::sceneBounds() const
+{
+    if (!m_sceneBoundsValid) {
+        m_sceneBounds = boundsOf(m_objects);
+        m_sceneBoundsValid = true;
+    }
+    return m_sceneBounds;
+}
+
+BoundingBox ObjectManager::boundsOf(const QVector<SceneObject*>& objects)
+{
+    BoundingBox bounds;
+    for (const SceneObject* object : objects) {
+        if (object && object->isVisible()) {
+            bounds.expand(object->worldBounds());
+        }
+    }
+    return bounds;
 }
 
 SceneObject* ObjectManager::duplicateObject(SceneObject* object)
@@ -62,6 +181,18 @@ SceneObject* ObjectManager::duplicateObject(SceneObject* object)
         return nullptr;
     }
 
+    // Instances duplicate into their own group
+    InstanceProxy* proxy = qobject_cast<InstanceProxy*>(object);
+    if (proxy && proxy->group() && !proxy->isDetached()) {
+        InstanceProxy* duplicate = proxy->group()->addInstance(proxy->location() + QVector3D(1, 0, 0));
+        duplicate->setRotation(proxy->rotation());
+        duplicate->setScale(proxy->scale());
+        duplicate->setDimensions(proxy->dimensions());
+        duplicate->setName(proxy->name() + "_copy");
+        addObject(duplicate);
+        return duplicate;
+    }
+
     // TODO: Implement duplication for each object type
     // For now, just create a new box if it's a box
     BoxObject* boxObj = qobject_cast<BoxObject*>(object);
@@ -80,7 +211,7 @@ SceneObject* ObjectManager::duplicateObject(SceneObject* object)
 
 SceneObject* ObjectManager::createBox(const QVector3D& dimensions)
 {
-    auto* box = new BoxObject(dimensions.x(), dimensions.y(), dimensions.z(), m_rootEntity);
+    auto* box = new BoxObject(dimensions, m_geometryCache, m_rootEntity);
     addObject(box);
     return box;
 }
@@ -99,12 +230,68 @@ SceneObject* ObjectManager::createSphere(float radius)
     return nullptr;
 }
 
-SceneObject* ObjectManager::findByUuid(const QUuid& uuid) const
+QVector<SceneObject*> ObjectManager::createArray(SceneObject* source, const QVector<QVector3D>& offsets)
 {
-    for (SceneObject* obj : m_objects) {
-        if (obj->uuid() == uuid) {
-            return obj;
+    QVector<SceneObject*> created;
+    if (!source || !source->meshData()) {
+        qWarning() << "Cannot create array from null object";
+        return created;
+    }
+    if (offsets.isEmpty()) {
+        return created;
+    }
+
+    auto* group = new InstancedObject(*source->meshData(), source->dimensions(), m_rootEntity);
+    created.reserve(offsets.size());
+
+    BulkEdit bulk(this);
+
+    for (int i = 0; i < offsets.size(); ++i) {
+        InstanceProxy* instance = group->addInstance(source->location() + offsets[i]);
+        instance->setRotation(source->rotation());
+        instance->setScale(source->scale());
+        instance->setMaterialId(source->materialId());
+        instance->setMeshSize(source->meshSize());
+        instance->setName(QString("%1_%2").arg(source->name()).arg(i + 1, 3, 10, QChar('0')));
+        addObject(instance);
+        created.append(instance);
+    }
+
+    qDebug() << "Array created from" << source->name() << "with" << created.size() << "instances";
+    return created;
+}
+
+QVector<SceneObject*> ObjectManager::createGridArray(SceneObject* source, int columns, int rows,
+                                                     const QVector3D& spacing)
+{
+    // Columns along X, rows along Z; the source itself is the (0, 0) cell
+    QVector<QVector3D> offsets;
+    offsets.reserve(columns * rows);
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            if (row == 0 && column == 0) continue;
+            offsets.append(QVector3D(column * spacing.x(), 0.0f, row * spacing.z()));
         }
     }
-    return nullptr;
+    return createArray(source, offsets);
+}
+
+QVector<InstancedObject*> ObjectManager::instanceGroups() const
+{
+    return m_rootEntity->findChildren<InstancedObject*>(Qt::FindDirectChildrenOnly);
+}
+
+SceneObject* ObjectManager::findByUuid(const QUuid& uuid) const
+{
+    int slot = m_objectSlots.value(uuid, -1);
+    return slot == -1 ? nullptr : m_objects[slot];
+}
+
+bool ObjectManager::contains(const SceneObject* object) const
+{
+    if (!object) {
+        return false;
+    }
+    int slot = m_objectSlots.value(object->uuid(), -1);
+    return slot != -1 && m_objects[slot] == object;
 }
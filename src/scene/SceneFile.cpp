@@ -0,0 +1,133 @@
+#include "scene/SceneFile.h"
+#include "scene/ObjectManager.h"
+#include "scene/SceneObject.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QVector>
+#include <QVector3D>
+
+namespace {
+
+struct BoxSpec {
+    QString name;
+    QVector3D dimensions{1, 1, 1};
+    QVector3D location;
+    QVector3D rotation;
+    QVector3D scale{1, 1, 1};
+    int materialId = 0;
+    double meshSize = 0.0;
+    bool visible = true;
+};
+
+// Reads key as [x, y, z]; a missing key keeps *value
+bool readVector(const QJsonObject& object, const QString& key, QVector3D* value)
+{
+    if (!object.contains(key)) {
+        return true;
+    }
+    const QJsonArray array = object.value(key).toArray();
+    if (array.size() != 3 || !array[0].isDouble() || !array[1].isDouble() || !array[2].isDouble()) {
+        return false;
+    }
+    *value = QVector3D(array[0].toDouble(), array[1].toDouble(), array[2].toDouble());
+    return true;
+}
+
+bool readBox(const QJsonObject& object, BoxSpec* box, QString* error)
+{
+    box->name = object.value("name").toString();
+    if (!readVector(object, "dimensions", &box->dimensions) || !readVector(object, "location", &box->location)
+        || !readVector(object, "rotation", &box->rotation) || !readVector(object, "scale", &box->scale)) {
+        *error = "dimensions, location, rotation and scale must be [x, y, z]";
+        return false;
+    }
+    if (box->dimensions.x() <= 0 || box->dimensions.y() <= 0 || box->dimensions.z() <= 0) {
+        *error = "dimensions must be positive";
+        return false;
+    }
+    box->materialId = object.value("material").toInt(0);
+    box->meshSize = object.value("meshSize").toDouble(0.0);
+    if (box->meshSize < 0) {
+        *error = "meshSize must not be negative";
+        return false;
+    }
+    box->visible = object.value("visible").toBool(true);
+    return true;
+}
+
+} // namespace
+
+namespace SceneFile {
+
+void createDefault(ObjectManager* objectManager)
+{
+    ObjectManager::BulkEdit bulk(objectManager);
+
+    SceneObject* box1 = objectManager->createBox(QVector3D(2, 2, 2));
+    box1->setLocation(QVector3D(0, 1, 0));
+    box1->setName("Cube");
+
+    SceneObject* box2 = objectManager->createBox(QVector3D(1.5, 3, 1));
+    box2->setLocation(QVector3D(3, 1.5, 0));
+    box2->setName("Tall Box");
+}
+
+bool load(const QString& filePath, ObjectManager* objectManager, QString* error)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *error = QString("cannot read %1: %2").arg(filePath, file.errorString());
+        return false;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (document.isNull()) {
+        *error = QString("%1: %2 at offset %3").arg(filePath, parseError.errorString()).arg(parseError.offset);
+        return false;
+    }
+    if (!document.isObject() || !document.object().value("objects").isArray()) {
+        *error = QString("%1: expected an object with an \"objects\" array").arg(filePath);
+        return false;
+    }
+
+    // Validate everything before creating anything
+    const QJsonArray objects = document.object().value("objects").toArray();
+    QVector<BoxSpec> boxes;
+    boxes.reserve(objects.size());
+    for (int i = 0; i < objects.size(); ++i) {
+        const QJsonObject object = objects[i].toObject();
+        const QString type = object.value("type").toString();
+        if (type != "box") {
+            *error = QString("%1: object %2 has unsupported type \"%3\"").arg(filePath).arg(i).arg(type);
+            return false;
+        }
+        BoxSpec box;
+        QString reason;
+        if (!readBox(object, &box, &reason)) {
+            *error = QString("%1: object %2: %3").arg(filePath).arg(i).arg(reason);
+            return false;
+        }
+        boxes.append(box);
+    }
+
+    ObjectManager::BulkEdit bulk(objectManager);
+    for (const BoxSpec& box : boxes) {
+        SceneObject* object = objectManager->createBox(box.dimensions);
+        if (!box.name.isEmpty()) {
+            object->setName(box.name);
+        }
+        object->setLocation(box.location);
+        object->setRotation(box.rotation);
+        object->setScale(box.scale);
+        object->setMaterialId(box.materialId);
+        object->setMeshSize(box.meshSize);
+        object->setVisible(box.visible);
+    }
+    return true;
+}
+
+} // namespace SceneFile
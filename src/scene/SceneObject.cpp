@@ -1,49 +1,68 @@
 #include "scene/SceneObject.h"
+#include "scene/GeometryCache.h"
 #include "mesh/MeshData.h"
+#include "mesh/MeshSimplifier.h"
+#include <Qt3DCore/QGeometry>
+#include <Qt3DCore/QBuffer>
 #include <Qt3DRender/QGeometryRenderer>
-#include <Qt3DRender/QObjectPicker>
-#include <Qt3DRender/QPickEvent>
 #include <Qt3DExtras/QPhongMaterial>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QFutureWatcher>
 #include <QDebug>
 
 int SceneObject::s_objectCounter = 0;
+quint32 SceneObject::s_pickIdCounter = 0;
 
 SceneObject::SceneObject(Qt3DCore::QNode *parent)
     : Qt3DCore::QEntity(parent)
     , m_transform(new Qt3DCore::QTransform(this))
     , m_material(nullptr)
     , m_renderer(nullptr)
-    , m_picker(new Qt3DRender::QObjectPicker(this))
+    , m_geometry(nullptr)
+    , m_vertexBuffer(nullptr)
     , m_meshData(new MeshData())
     , m_dimensions(1.0f, 1.0f, 1.0f)
+    , m_meshEdited(false)
     , m_name(QString("Object_%1").arg(++s_objectCounter))
     , m_uuid(QUuid::createUuid())
+    , m_pickId(++s_pickIdCounter)
     , m_visible(true)
     , m_locked(false)
     , m_materialId(-1)
+    , m_meshSize(0.0)
     , m_selected(false)
+    , m_localBoundsValid(false)
+    , m_worldBoundsValid(false)
+    , m_triangleCount(0)
+    , m_lodLevel(0)
+    , m_lodGeneration(0)
+    , m_lodBuiltGeneration(-1)
+    , m_lodPending(false)
+    , m_culled(false)
 {
-    // Add transform component
+    // Add transform component. Picking is done on the CPU (see ScenePicker)
     addComponent(m_transform);
 
-    // Setup object picker for mouse selection
-    m_picker->setEnabled(true);
-    m_picker->setHoverEnabled(false);  // We only care about clicks, not hover
-    addComponent(m_picker);
-
-    // Connect picker signal to our slot (only respond to left mouse button)
-    connect(m_picker, &Qt3DRender::QObjectPicker::clicked, this, [this](Qt3DRender::QPickEvent* event) {
-        // Only select on left mouse button (not middle or right)
-        if (event && event->button() == Qt3DRender::QPickEvent::LeftButton) {
-            this->onObjectClicked();
-        }
-    });
+    // The ID pass encodes pick ids in 24 bits (see PickIdPass)
+    if (m_pickId >= (1u << 24)) {
+        qWarning() << "SceneObject: pick id overflow, GPU picking may return wrong objects";
+    }
 
     qDebug() << "SceneObject created:" << m_name << "UUID:" << m_uuid.toString();
 }
 
 SceneObject::~SceneObject()
 {
+    // Give back shared components; private ones are our children
+    if (m_geometryCache) {
+        if (m_geometryCache->isShared(m_renderer)) {
+            m_geometryCache->releaseRenderer(m_renderer);
+        }
+        if (m_geometryCache->isShared(m_material)) {
+            m_geometryCache->releaseMaterial(m_material);
+        }
+    }
+
     delete m_meshData;
     qDebug() << "SceneObject destroyed:" << m_name;
 }
@@ -92,6 +111,140 @@ QVector3D SceneObject::dimensions() const
     return m_dimensions;
 }
 
+QMatrix4x4 SceneObject::transformMatrix() const
+{
+    return m_transform->matrix();
+}
+
+const BoundingBox& SceneObject::localBounds() const
+{
+    if (!m_localBoundsValid) {
+        m_localBounds = BoundingBox();
+        m_triangleCount = 0;
+        if (m_meshData) {
+            for (const MeshData::Vertex& vertex : m_meshData->getVertices()) {
+                m_localBounds.expand(vertex.position);
+            }
+            for (const MeshData::Face& face : m_meshData->getFaces()) {
+                m_triangleCount += qMax(0, int(face.vertices.size()) - 2);
+            }
+        }
+        m_localBoundsValid = true;
+    }
+    return m_localBounds;
+}
+
+const BoundingBox& SceneObject::worldBounds() const
+{
+    if (!m_worldBoundsValid) {
+        m_worldBounds = localBounds().transformed(transformMatrix());
+        m_worldBoundsValid = true;
+    }
+    return m_worldBounds;
+}
+
+int SceneObject::triangleCount() const
+{
+    localBounds();
+    return m_triangleCount;
+}
+
+void SceneObject::requestLodChain()
+{
+    if (m_lodPending || m_lodBuiltGeneration == m_lodGeneration || !m_renderer || !m_meshData
+        || triangleCount() < LodMinTriangles) {
+        return;
+    }
+
+    // Simplify a snapshot on a worker thread; the mesh may change meanwhile
+    m_lodPending = true;
+    const int generation = m_lodGeneration;
+    auto* watcher = new QFutureWatcher<QVector<MeshSimplifier::Level>>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, generation]() {
+        watcher->deleteLater();
+        m_lodPending = false;
+        if (generation != m_lodGeneration) {
+            return;  // Geometry changed while simplifying
+        }
+        m_lodBuiltGeneration = generation;
+
+        for (const MeshSimplifier::Level& level : watcher->result()) {
+            auto* renderer = new Qt3DRender::QGeometryRenderer(this);
+            renderer->setPrimitiveType(Qt3DRender::QGeometryRenderer::Triangles);
+            renderer->setGeometry(MeshSimplifier::createGeometry(level, renderer));
+            m_lodLevels.append({ renderer, level.error, level.triangleCount });
+        }
+        if (!m_lodLevels.isEmpty()) {
+            qDebug() << "LOD chain built for" << m_name << ":" << m_lodLevels.size() << "levels";
+            emit lodChainReady();
+        }
+    });
+    watcher->setFuture(QtConcurrent::run([input = MeshSimplifier::snapshot(*m_meshData)]() {
+        return MeshSimplifier::buildChain(input);
+    }));
+}
+
+Qt3DRender::QGeometryRenderer* SceneObject::lodRenderer(int level) const
+{
+    return level == 0 ? m_renderer : m_lodLevels[level - 1].renderer;
+}
+
+void SceneObject::setLodLevel(int level)
+{
+    level = qBound(0, level, m_lodLevels.size());
+    if (level == m_lodLevel || !m_renderer) {
+        return;
+    }
+
+    removeComponent(lodRenderer(m_lodLevel));
+    addComponent(lodRenderer(level));
+    m_lodLevel = level;
+}
+
+float SceneObject::lodError(int level) const
+{
+    return level > 0 && level <= m_lodLevels.size() ? m_lodLevels[level - 1].error : 0.0f;
+}
+
+int SceneObject::lodTriangleCount(int level) const
+{
+    return level > 0 && level <= m_lodLevels.size() ? m_lodLevels[level - 1].triangleCount : triangleCount();
+}
+
+void SceneObject::clearLodChain()
+{
+    // Back to the full mesh before its renderer is touched
+    if (m_lodLevel != 0) {
+        removeComponent(lodRenderer(m_lodLevel));
+        if (m_renderer) {
+            addComponent(m_renderer);
+        }
+        m_lodLevel = 0;
+    }
+    for (const LodLevel& level : m_lodLevels) {
+        level.renderer->deleteLater();
+    }
+    m_lodLevels.clear();
+    ++m_lodGeneration;
+}
+
+void SceneObject::setCulled(bool culled)
+{
+    if (m_culled != culled) {
+        m_culled = culled;
+        setEnabled(m_visible && !m_culled);
+    }
+}
+
+void SceneObject::invalidateBounds(bool geometry)
+{
+    if (geometry) {
+        m_localBoundsValid = false;
+    }
+    m_worldBoundsValid = false;
+    emit boundsChanged();
+}
+
 void SceneObject::setLocation(const QVector3D& pos)
 {
     if (m_locked) {
@@ -100,6 +253,7 @@ void SceneObject::setLocation(const QVector3D& pos)
     }
 
     m_transform->setTranslation(pos);
+    invalidateBounds(false);
     emit transformChanged();
 }
 
@@ -116,6 +270,7 @@ void SceneObject::setRotation(const QVector3D& rot)
     QQuaternion qz = QQuaternion::fromAxisAndAngle(0, 0, 1, rot.z());
 
     m_transform->setRotation(qz * qy * qx);
+    invalidateBounds(false);
     emit transformChanged();
 }
 
@@ -127,6 +282,7 @@ void SceneObject::setScale(const QVector3D& scale)
     }
 
     m_transform->setScale3D(scale);
+    invalidateBounds(false);
     emit transformChanged();
 }
 
@@ -140,8 +296,7 @@ void SceneObject::setDimensions(const QVector3D& dim)
     m_dimensions = dim;
 
     // Regenerate mesh with new dimensions
-    generateMesh();
-    updateGeometry();
+    regenerateMesh();
 
     emit transformChanged();
 }
@@ -158,8 +313,9 @@ void SceneObject::setVisible(bool visible)
 {
     if (m_visible != visible) {
         m_visible = visible;
-        setEnabled(visible);  // Qt3D visibility
+        setEnabled(visible && !m_culled);  // Qt3D visibility
         emit propertiesChanged();
+        emit boundsChanged();  // Hidden objects drop out of scene bounds
     }
 }
 
@@ -175,23 +331,150 @@ void SceneObject::setMaterialId(int id)
 {
     if (m_materialId != id) {
         m_materialId = id;
+        if (m_geometryCache) {
+            updateSharedMaterial();
+        }
+        emit propertiesChanged();
+    }
+}
+
+void SceneObject::setMeshSize(double size)
+{
+    size = qMax(0.0, size);
+    if (m_meshSize != size) {
+        m_meshSize = size;
         emit propertiesChanged();
     }
 }
 
 void SceneObject::updateGeometry()
 {
+    m_meshEdited = true;
+    clearLodChain();
+    rebuildGeometry();
+    invalidateBounds(true);
+    emit geometryChanged();
+}
+
+void SceneObject::regenerateMesh()
+{
+    generateMesh();
+    m_meshEdited = false;
+    clearLodChain();
+    rebuildGeometry();
+    invalidateBounds(true);
+    emit geometryChanged();
+}
+
+void SceneObject::rebuildGeometry()
+{
+    // Unedited primitive: use the renderer shared by identical objects
+    if (m_geometryCache && m_meshData && !m_meshEdited) {
+        const QString key = geometryKey();
+        if (!key.isEmpty()) {
+            Qt3DRender::QGeometryRenderer* shared = m_geometryCache->acquireRenderer(key, *m_meshData);
+            if (shared == m_renderer) {
+                m_geometryCache->releaseRenderer(shared);  // Already holding a reference
+            } else {
+                replaceRenderer(shared);
+            }
+            return;
+        }
+    }
+
+    // Edited mesh on shared geometry: copy-on-write
+    if (hasSharedGeometry()) {
+        detachGeometry();
+        return;
+    }
+
     if (!m_renderer || !m_meshData) {
         qWarning() << "Cannot update geometry: renderer or mesh data is null";
         return;
     }
 
-    // Generate new Qt3D geometry from mesh data
+    // Same topology: only re-upload the byte ranges of faces that moved
+    if (m_geometry && m_meshData->updateVertexBuffer(m_vertexBuffer)) {
+        return;
+    }
+
+    // Topology changed: generate new Qt3D geometry from mesh data
     Qt3DCore::QGeometry* geometry = m_meshData->generateGeometry(this);
     if (geometry) {
         m_renderer->setGeometry(geometry);
-        qDebug() << "Geometry updated for" << m_name;
+        if (m_geometry) {
+            m_geometry->deleteLater();
+        }
+        m_geometry = geometry;
+        m_vertexBuffer = MeshData::vertexBufferOf(geometry);
+        qDebug() << "Geometry rebuilt for" << m_name;
+    }
+}
+
+bool SceneObject::hasSharedGeometry() const
+{
+    return m_geometryCache && m_geometryCache->isShared(m_renderer);
+}
+
+void SceneObject::detachGeometry()
+{
+    if (!hasSharedGeometry()) {
+        return;
+    }
+
+    auto* renderer = new Qt3DRender::QGeometryRenderer(this);
+    renderer->setPrimitiveType(Qt3DRender::QGeometryRenderer::Triangles);
+    replaceRenderer(renderer);
+
+    // From here on the mesh is our own; build its private GPU buffers
+    m_meshEdited = true;
+    rebuildGeometry();
+    qDebug() << "Geometry detached from cache for" << m_name;
+}
+
+void SceneObject::replaceRenderer(Qt3DRender::QGeometryRenderer* renderer)
+{
+    clearLodChain();
+    if (m_renderer) {
+        removeComponent(m_renderer);
+        if (m_geometryCache && m_geometryCache->isShared(m_renderer)) {
+            m_geometryCache->releaseRenderer(m_renderer);
+        } else {
+            m_renderer->deleteLater();
+        }
+    }
+    if (m_geometry) {
+        m_geometry->deleteLater();
     }
+
+    m_renderer = renderer;
+    m_geometry = nullptr;
+    m_vertexBuffer = nullptr;
+    addComponent(m_renderer);
+}
+
+void SceneObject::updateSharedMaterial()
+{
+    if (!m_geometryCache) {
+        return;
+    }
+
+    Qt3DRender::QMaterial* material = m_geometryCache->acquireMaterial(m_materialId, m_selected);
+    if (material == m_material) {
+        m_geometryCache->releaseMaterial(material);  // Already holding a reference
+        return;
+    }
+
+    if (m_material) {
+        removeComponent(m_material);
+        if (m_geometryCache->isShared(m_material)) {
+            m_geometryCache->releaseMaterial(m_material);
+        } else {
+            m_material->deleteLater();
+        }
+    }
+    m_material = material;
+    addComponent(m_material);
 }
 
 void SceneObject::setSelected(bool selected)
@@ -200,6 +483,12 @@ void SceneObject::setSelected(bool selected)
         m_selected = selected;
         emit selectionChanged(selected);
 
+        // Shared materials: swap to the highlighted variant
+        if (m_geometryCache) {
+            updateSharedMaterial();
+            return;
+        }
+
         // Update material to show selection (orange highlight)
         if (m_material) {
             auto* phongMaterial = qobject_cast<Qt3DExtras::QPhongMaterial*>(m_material);
@@ -215,9 +504,3 @@ void SceneObject::setSelected(bool selected)
         }
     }
 }
-
-void SceneObject::onObjectClicked()
-{
-    qDebug() << "Object clicked:" << m_name;
-    emit clicked(this);
-}
@@ -0,0 +1,252 @@
+#include "scene/ScenePicker.h"
+#include "scene/ObjectManager.h"
+#include "scene/SceneObject.h"
+#include "mesh/MeshData.h"
+#include "mesh/MeshBVH.h"
+#include <Qt3DRender/QCamera>
+#include <QRect>
+#include <QDebug>
+#include <algorithm>
+
+ScenePicker::ScenePicker(ObjectManager* objectManager, QObject *parent)
+    : QObject(parent)
+    , m_objectManager(objectManager)
+    , m_structureDirty(true)
+{
+    connect(m_objectManager, &ObjectManager::objectsAdded, this, &ScenePicker::onObjectsAdded);
+    connect(m_objectManager, &ObjectManager::objectsRemoved, this, &ScenePicker::onObjectsRemoved);
+
+    for (SceneObject* object : m_objectManager->allObjects()) {
+        trackObject(object);
+    }
+}
+
+ScenePicker::~ScenePicker()
+{
+}
+
+void ScenePicker::onObjectsAdded(const QVector<SceneObject*>& objects)
+{
+    for (SceneObject* object : objects) {
+        trackObject(object);
+    }
+}
+
+void ScenePicker::onObjectsRemoved(const QVector<SceneObject*>& objects)
+{
+    for (SceneObject* object : objects) {
+        const int slot = m_itemSlots.value(object, -1);
+        if (slot == -1) {
+            continue;
+        }
+
+        disconnect(object, nullptr, this, nullptr);
+
+        // Swap-remove; slots are only used by the tree, which is rebuilt
+        const int last = m_items.size() - 1;
+        if (slot != last) {
+            m_items[slot] = m_items[last];
+            m_itemSlots[m_items[slot]] = slot;
+        }
+        m_items.removeLast();
+        m_itemSlots.remove(object);
+    }
+    m_structureDirty = true;
+}
+
+void ScenePicker::trackObject(SceneObject* object)
+{
+    if (!object || m_itemSlots.contains(object)) {
+        return;
+    }
+
+    m_itemSlots.insert(object, m_items.size());
+    m_items.append(object);
+    m_structureDirty = true;
+
+    // Covers transform, geometry and visibility changes
+    connect(object, &SceneObject::boundsChanged, this, [this, object]() { markDirty(object); });
+}
+
+void ScenePicker::markDirty(SceneObject* object)
+{
+    if (m_structureDirty) {
+        return;  // Everything is recomputed on the next pick anyway
+    }
+    const int slot = m_itemSlots.value(object, -1);
+    if (slot != -1) {
+        m_dirtyItems.insert(slot);
+    }
+}
+
+BoundingBox ScenePicker::worldBounds(const SceneObject* object)
+{
+    return object->worldBounds();
+}
+
+void ScenePicker::ensureUpToDate() const
+{
+    if (m_structureDirty) {
+        rebuild();
+    } else if (!m_dirtyItems.isEmpty()) {
+        refit();
+    }
+}
+
+void ScenePicker::rebuild() const
+{
+    const int count = m_items.size();
+    m_itemBounds.resize(count);
+    m_order.resize(count);
+    for (int i = 0; i < count; ++i) {
+        m_itemBounds[i] = worldBounds(m_items[i]);
+        m_order[i] = i;
+    }
+
+    m_nodes.clear();
+    if (count > 0) {
+        m_nodes.reserve(2 * count - 1);
+        m_nodes.append(Node());
+        build(0, 0, count);
+    }
+
+    m_dirtyItems.clear();
+    m_structureDirty = false;
+}
+
+void ScenePicker::build(int nodeIndex, int first, int count) const
+{
+    BoundingBox box;
+    BoundingBox centroidBox;
+    for (int i = first; i < first + count; ++i) {
+        const BoundingBox& itemBox = m_itemBounds[m_order[i]];
+        box.expand(itemBox);
+        centroidBox.expand(itemBox.center());
+    }
+    m_nodes[nodeIndex].box = box;
+
+    const int axis = centroidBox.longestAxis();
+    if (count <= MaxLeafObjects || centroidBox.size()[axis] <= 0.0f) {
+        m_nodes[nodeIndex].first = first;
+        m_nodes[nodeIndex].count = count;
+        return;
+    }
+
+    // Centroid median split on the longest axis
+    const int half = count / 2;
+    std::nth_element(m_order.begin() + first, m_order.begin() + first + half, m_order.begin() + first + count,
+                     [this, axis](int a, int b) {
+                         return m_itemBounds[a].center()[axis] < m_itemBounds[b].center()[axis];
+                     });
+
+    const int left = m_nodes.size();
+    m_nodes[nodeIndex].first = left;
+    m_nodes[nodeIndex].count = 0;
+    m_nodes.append(Node());
+    m_nodes.append(Node());
+
+    build(left, first, half);
+    build(left + 1, first + half, count - half);
+}
+
+void ScenePicker::refit() const
+{
+    for (int slot : m_dirtyItems) {
+        m_itemBounds[slot] = worldBounds(m_items[slot]);
+    }
+    m_dirtyItems.clear();
+
+    // Children are stored after their parent, so a reverse sweep is bottom-up
+    for (int i = m_nodes.size() - 1; i >= 0; --i) {
+        Node& node = m_nodes[i];
+        BoundingBox box;
+        if (node.count > 0) {
+            for (int j = node.first; j < node.first + node.count; ++j) {
+                box.expand(m_itemBounds[m_order[j]]);
+            }
+        } else {
+            box.expand(m_nodes[node.first].box);
+            box.expand(m_nodes[node.first + 1].box);
+        }
+        node.box = box;
+    }
+}
+
+ScenePicker::Hit ScenePicker::pick(const Ray& ray) const
+{
+    ensureUpToDate();
+
+    Hit result;
+    if (m_nodes.isEmpty()) {
+        return result;
+    }
+
+    // Median splits halve every node, so the depth stays below 32
+    int stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const Node& node = m_nodes[stack[--stackSize]];
+        if (!node.box.intersects(ray, 0.0f, result.distance)) {
+            continue;
+        }
+
+        if (node.count == 0) {
+            float tLeft = 0.0f;
+            float tRight = 0.0f;
+            const bool hitLeft = m_nodes[node.first].box.intersects(ray, 0.0f, result.distance, &tLeft);
+            const bool hitRight = m_nodes[node.first + 1].box.intersects(ray, 0.0f, result.distance, &tRight);
+            if (hitLeft && hitRight) {
+                const bool leftFirst = tLeft <= tRight;
+                stack[stackSize++] = leftFirst ? node.first + 1 : node.first;
+                stack[stackSize++] = leftFirst ? node.first : node.first + 1;
+            } else if (hitLeft) {
+                stack[stackSize++] = node.first;
+            } else if (hitRight) {
+                stack[stackSize++] = node.first + 1;
+            }
+            continue;
+        }
+
+        for (int i = node.first; i < node.first + node.count; ++i) {
+            const int slot = m_order[i];
+            SceneObject* object = m_items[slot];
+            if (!object->isVisible() || !m_itemBounds[slot].intersects(ray, 0.0f, result.distance)) {
+                continue;
+            }
+
+            // Into object space; t stays comparable across objects
+            bool invertible = false;
+            const QMatrix4x4 toWorld = object->transformMatrix();
+            const QMatrix4x4 toLocal = toWorld.inverted(&invertible);
+            if (!invertible) {
+                continue;
+            }
+
+            MeshBVH::Hit meshHit;
+            if (object->meshData()->triangleBVH()->raycast(ray.transformed(toLocal), &meshHit, result.distance)) {
+                result.object = object;
+                result.distance = meshHit.t;
+                result.position = toWorld.map(meshHit.position);
+                result.faceIndex = meshHit.faceIndex;
+                result.vertexIndex = meshHit.vertexIndex;
+            }
+        }
+    }
+
+    return result;
+}
+
+Ray ScenePicker::screenRay(const Qt3DRender::QCamera* camera, const QPointF& pos, const QSize& viewportSize)
+{
+    const QRect viewport(QPoint(0, 0), viewportSize);
+    const QMatrix4x4 view = camera->viewMatrix();
+    const QMatrix4x4 projection = camera->projectionMatrix();
+
+    // Window coordinates have y up
+    const float windowY = float(viewportSize.height()) - float(pos.y());
+    const QVector3D nearPoint = QVector3D(float(pos.x()), windowY, 0.0f).unproject(view, projection, viewport);
+    const QVector3D farPoint = QVector3D(float(pos.x()), windowY, 1.0f).unproject(view, projection, viewport);
+    return Ray(nearPoint, farPoint - nearPoint);
+}
@@ -1,10 +1,13 @@
 #include "scene/SelectionManager.h"
 #include "scene/SceneObject.h"
+#include "mesh/MeshData.h"
 #include <QDebug>
+#include <utility>
 
 SelectionManager::SelectionManager(QObject *parent)
     : QObject(parent)
     , m_mode(ObjectSelection)
+    , m_firstSelected(0)
 {
     qDebug() << "SelectionManager created";
 }
@@ -30,107 +33,169 @@ void SelectionManager::selectObject(SceneObject* obj, bool addToSelection)
         return;
     }
 
-    // Clear previous selection if not adding
+    selectObjects({obj}, addToSelection);
+}
+
+void SelectionManager::selectObjects(const QVector<SceneObject*>& objects, bool addToSelection)
+{
+    bool changed = false;
+
+    // Replace the previous selection if not adding
     if (!addToSelection) {
-        for (SceneObject* prevObj : m_selectedObjects) {
-            prevObj->setSelected(false);
+        QVector<SceneObject*> replacement;
+        QSet<SceneObject*> kept;
+        replacement.reserve(objects.size());
+        kept.reserve(objects.size());
+        for (SceneObject* obj : objects) {
+            if (obj && !kept.contains(obj)) {
+                kept.insert(obj);
+                replacement.append(obj);
+            }
+        }
+
+        // Same objects in the same order (so the same active object)
+        if (replacement == selectedObjects()) {
+            return;
+        }
+
+        for (auto it = m_selectedObjectSlots.cbegin(); it != m_selectedObjectSlots.cend(); ++it) {
+            if (!kept.contains(it.key())) {
+                it.key()->setSelected(false);
+            }
         }
         m_selectedObjects.clear();
+        m_selectedObjectSlots.clear();
+        m_firstSelected = 0;
+        changed = true;
     }
 
     // Add to selection if not already selected
-    if (!m_selectedObjects.contains(obj)) {
-        m_selectedObjects.append(obj);
-        obj->setSelected(true);
-        qDebug() << "Object selected:" << obj->name() << "Total selected:" << m_selectedObjects.size();
+    for (SceneObject* obj : objects) {
+        if (obj && !m_selectedObjectSlots.contains(obj)) {
+            m_selectedObjectSlots.insert(obj, m_selectedObjects.size());
+            m_selectedObjects.append(obj);
+            obj->setSelected(true);
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        qDebug() << "Objects selected:" << m_selectedObjectSlots.size();
         emit selectionChanged();
     }
 }
 
 void SelectionManager::deselectObject(SceneObject* obj)
 {
-    if (!obj) return;
+    const auto it = m_selectedObjectSlots.find(obj);
+    if (!obj || it == m_selectedObjectSlots.end()) return;
+    const int slot = *it;
+    m_selectedObjectSlots.erase(it);
 
-    int index = m_selectedObjects.indexOf(obj);
-    if (index != -1) {
-        m_selectedObjects.removeAt(index);
-        obj->setSelected(false);
-        qDebug() << "Object deselected:" << obj->name();
-        emit selectionChanged();
+    // Leave a hole; compact once holes make up half the list
+    m_selectedObjects[slot] = nullptr;
+    while (m_firstSelected < m_selectedObjects.size() && !m_selectedObjects[m_firstSelected]) {
+        ++m_firstSelected;
+    }
+    if (2 * m_selectedObjectSlots.size() < m_selectedObjects.size()) {
+        compactSelectedObjects();
     }
+    obj->setSelected(false);
+    qDebug() << "Object deselected:" << obj->name();
+    emit selectionChanged();
 }
 
 void SelectionManager::clearSelection()
 {
-    if (m_selectedObjects.isEmpty())
+    if (m_selectedObjectSlots.isEmpty())
         return;
 
-    for (SceneObject* obj : m_selectedObjects) {
-        obj->setSelected(false);
+    for (auto it = m_selectedObjectSlots.cbegin(); it != m_selectedObjectSlots.cend(); ++it) {
+        it.key()->setSelected(false);
     }
 
     m_selectedObjects.clear();
+    m_selectedObjectSlots.clear();
+    m_firstSelected = 0;
     qDebug() << "Selection cleared";
     emit selectionChanged();
 }
 
 bool SelectionManager::isSelected(SceneObject* obj) const
 {
-    return m_selectedObjects.contains(obj);
+    return m_selectedObjectSlots.contains(obj);
 }
 
 void SelectionManager::selectVertex(int index, bool addToSelection)
 {
-    if (!addToSelection) {
-        m_selectedVertices.clear();
-    }
-
-    if (!m_selectedVertices.contains(index)) {
-        m_selectedVertices.append(index);
-        emit selectionChanged();
-    }
+    selectVertices({index}, addToSelection);
 }
 
 void SelectionManager::selectEdge(int index, bool addToSelection)
 {
-    if (!addToSelection) {
-        m_selectedEdges.clear();
-    }
+    selectEdges({index}, addToSelection);
+}
+
+void SelectionManager::selectFace(int index, bool addToSelection)
+{
+    selectFaces({index}, addToSelection);
+}
 
-    if (!m_selectedEdges.contains(index)) {
-        m_selectedEdges.append(index);
+void SelectionManager::selectVertices(const QVector<int>& indices, bool addToSelection)
+{
+    if (selectElements(m_selectedVertices, indices, addToSelection)) {
         emit selectionChanged();
     }
 }
 
-void SelectionManager::selectFace(int index, bool addToSelection)
+void SelectionManager::selectEdges(const QVector<int>& indices, bool addToSelection)
 {
-    if (!addToSelection) {
-        m_selectedFaces.clear();
+    if (selectElements(m_selectedEdges, indices, addToSelection)) {
+        emit selectionChanged();
     }
+}
 
-    if (!m_selectedFaces.contains(index)) {
-        m_selectedFaces.append(index);
+void SelectionManager::selectFaces(const QVector<int>& indices, bool addToSelection)
+{
+    if (selectElements(m_selectedFaces, indices, addToSelection)) {
         emit selectionChanged();
     }
 }
 
 void SelectionManager::deselectVertex(int index)
 {
-    m_selectedVertices.removeAll(index);
-    emit selectionChanged();
+    deselectVertices({index});
 }
 
 void SelectionManager::deselectEdge(int index)
 {
-    m_selectedEdges.removeAll(index);
-    emit selectionChanged();
+    deselectEdges({index});
 }
 
 void SelectionManager::deselectFace(int index)
 {
-    m_selectedFaces.removeAll(index);
-    emit selectionChanged();
+    deselectFaces({index});
+}
+
+void SelectionManager::deselectVertices(const QVector<int>& indices)
+{
+    if (deselectElements(m_selectedVertices, indices)) {
+        emit selectionChanged();
+    }
+}
+
+void SelectionManager::deselectEdges(const QVector<int>& indices)
+{
+    if (deselectElements(m_selectedEdges, indices)) {
+        emit selectionChanged();
+    }
+}
+
+void SelectionManager::deselectFaces(const QVector<int>& indices)
+{
+    if (deselectElements(m_selectedFaces, indices)) {
+        emit selectionChanged();
+    }
 }
 
 void SelectionManager::clearVertexSelection()
@@ -157,9 +222,62 @@ void SelectionManager::clearFaceSelection()
     }
 }
 
+void SelectionManager::selectAll(const QVector<SceneObject*>& objects)
+{
+    selectObjects(objects, true);
+}
+
+void SelectionManager::selectAll(const MeshData& mesh)
+{
+    QSet<int>* selection = elementSelection(m_mode);
+    if (selection && selectElements(*selection, elementIndices(mesh, m_mode), true)) {
+        emit selectionChanged();
+    }
+}
+
+void SelectionManager::invertSelection(const QVector<SceneObject*>& objects)
+{
+    QVector<SceneObject*> inverted;
+    inverted.reserve(qMax(0, int(objects.size() - m_selectedObjectSlots.size())));
+    for (SceneObject* obj : objects) {
+        if (obj && !m_selectedObjectSlots.contains(obj)) {
+            inverted.append(obj);
+        }
+    }
+
+    // Replace the selection in one step; selectObjects emits once
+    if (inverted.isEmpty()) {
+        clearSelection();
+    } else {
+        selectObjects(inverted, false);
+    }
+}
+
+void SelectionManager::invertSelection(const MeshData& mesh)
+{
+    QSet<int>* selection = elementSelection(m_mode);
+    if (!selection) {
+        return;
+    }
+
+    const QVector<int> indices = elementIndices(mesh, m_mode);
+    QSet<int> inverted;
+    inverted.reserve(indices.size());
+    for (int index : indices) {
+        if (!selection->contains(index)) {
+            inverted.insert(index);
+        }
+    }
+
+    if (inverted != *selection) {
+        *selection = std::move(inverted);
+        emit selectionChanged();
+    }
+}
+
 bool SelectionManager::hasSelection() const
 {
-    return !m_selectedObjects.isEmpty() ||
+    return !m_selectedObjectSlots.isEmpty() ||
            !m_selectedVertices.isEmpty() ||
            !m_selectedEdges.isEmpty() ||
            !m_selectedFaces.isEmpty();
@@ -167,5 +285,85 @@ bool SelectionManager::hasSelection() const
 
 SceneObject* SelectionManager::activeObject() const
 {
-    return m_selectedObjects.isEmpty() ? nullptr : m_selectedObjects.first();
+    return m_firstSelected < m_selectedObjects.size() ? m_selectedObjects[m_firstSelected] : nullptr;
+}
+
+QVector<SceneObject*> SelectionManager::selectedObjects() const
+{
+    if (m_selectedObjects.size() != m_selectedObjectSlots.size()) {
+        compactSelectedObjects();
+    }
+    return m_selectedObjects;
+}
+
+void SelectionManager::compactSelectedObjects() const
+{
+    m_selectedObjects.removeAll(nullptr);
+    for (int slot = 0; slot < m_selectedObjects.size(); ++slot) {
+        m_selectedObjectSlots[m_selectedObjects[slot]] = slot;
+    }
+    m_firstSelected = 0;
+}
+
+QSet<int>* SelectionManager::elementSelection(SelectionMode mode)
+{
+    switch (mode) {
+    case VertexSelection: return &m_selectedVertices;
+    case EdgeSelection:   return &m_selectedEdges;
+    case FaceSelection:   return &m_selectedFaces;
+    default:              return nullptr;
+    }
+}
+
+bool SelectionManager::selectElements(QSet<int>& selection, const QVector<int>& indices, bool addToSelection)
+{
+    if (!addToSelection) {
+        QSet<int> replacement(indices.cbegin(), indices.cend());
+        if (replacement == selection) {
+            return false;
+        }
+        selection = std::move(replacement);
+        return true;
+    }
+
+    bool changed = false;
+    selection.reserve(selection.size() + indices.size());
+    for (int index : indices) {
+        if (!selection.contains(index)) {
+            selection.insert(index);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool SelectionManager::deselectElements(QSet<int>& selection, const QVector<int>& indices)
+{
+    bool changed = false;
+    for (int index : indices) {
+        changed |= selection.remove(index);
+    }
+    return changed;
+}
+
+QVector<int> SelectionManager::elementIndices(const MeshData& mesh, SelectionMode mode)
+{
+    QVector<int> indices;
+    switch (mode) {
+    case VertexSelection:
+        indices.reserve(mesh.vertexCount());
+        for (const MeshData::Vertex& v : mesh.getVertices()) indices.append(v.index);
+        break;
+    case EdgeSelection:
+        indices.reserve(mesh.edgeCount());
+        for (const MeshData::Edge& e : mesh.getEdges()) indices.append(e.index);
+        break;
+    case FaceSelection:
+        indices.reserve(mesh.faceCount());
+        for (const MeshData::Face& f : mesh.getFaces()) indices.append(f.index);
+        break;
+    default:
+        break;
+    }
+    return indices;
 }
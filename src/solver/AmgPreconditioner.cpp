@@ -0,0 +1,508 @@
+#include "solver/AmgPreconditioner.h"
+#include "solver/SparseMatrix.h"
+#include "solver/Parallel.h"
+
+#include <QStringList>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int CoarseSmoothingSteps = 20;  // Used when the coarsest level is too large to factor
+constexpr int DirectSolveLimit = 1500;
+constexpr int PowerIterations = 15;
+
+} // namespace
+
+AmgPreconditioner::AmgPreconditioner(const SparseMatrix& matrix)
+    : AmgPreconditioner(matrix, Settings())
+{
+}
+
+AmgPreconditioner::AmgPreconditioner(const SparseMatrix& matrix, const Settings& settings)
+    : m_settings(settings)
+{
+    Level fine;
+    fine.A = fromSparse(matrix);
+    m_levels.append(fine);
+
+    while (m_levels.size() < m_settings.maxLevels) {
+        Level& level = m_levels.last();
+        setupLevel(level);
+        if (level.A.rows <= m_settings.coarsestSize) {
+            break;
+        }
+
+        int coarseCount = 0;
+        level.aggregate = aggregate(level, &coarseCount);
+        // Stop when aggregation no longer shrinks the problem
+        if (coarseCount == 0 || coarseCount > 0.85 * level.A.rows) {
+            level.aggregate.clear();
+            break;
+        }
+        level.P = smoothedProlongator(level, coarseCount);
+        level.R = transpose(level.P);
+
+        Level coarse;
+        coarse.A = product(level.R, product(level.A, level.P));
+        m_levels.append(coarse);
+    }
+    setupLevel(m_levels.last());
+    factorCoarsest();
+
+    qDebug() << "AmgPreconditioner:" << description();
+}
+
+QString AmgPreconditioner::description() const
+{
+    QStringList sizes;
+    for (const Level& level : m_levels) {
+        sizes.append(QString::number(level.A.rows));
+    }
+    return QString("AMG, %1 levels (%2), operator complexity %3")
+        .arg(m_levels.size()).arg(sizes.join(" > ")).arg(operatorComplexity(), 0, 'f', 2);
+}
+
+double AmgPreconditioner::operatorComplexity() const
+{
+    double total = 0.0;
+    for (const Level& level : m_levels) {
+        total += level.A.nonZeros();
+    }
+    return total / qMax<qint64>(1, m_levels.first().A.nonZeros());
+}
+
+void AmgPreconditioner::updateValues(const SparseMatrix& matrix)
+{
+    // Same pattern, new values: keep aggregates and prolongators
+    m_levels.first().A = fromSparse(matrix);
+    computeCoarseOperators();
+    for (Level& level : m_levels) {
+        setupLevel(level);
+    }
+    factorCoarsest();
+}
+
+void AmgPreconditioner::computeCoarseOperators()
+{
+    for (int i = 0; i + 1 < m_levels.size(); ++i) {
+        const Level& level = m_levels[i];
+        m_levels[i + 1].A = product(level.R, product(level.A, level.P));
+    }
+}
+
+AmgPreconditioner::Matrix AmgPreconditioner::fromSparse(const SparseMatrix& matrix)
+{
+    // Shares the arrays with the matrix until either side writes
+    Matrix m;
+    m.rows = matrix.rows();
+    m.cols = matrix.rows();
+    m.rowStart = matrix.rowStart();
+    m.columns = matrix.columns();
+    m.values = matrix.values();
+    return m;
+}
+
+template <typename RowFn>
+AmgPreconditioner::Matrix AmgPreconditioner::buildRows(int rows, int cols, RowFn rowFn)
+{
+    // Each chunk of rows fills its own arrays; they are concatenated after
+    struct Part {
+        QVector<int> rowSize;
+        QVector<int> columns;
+        QVector<double> values;
+    };
+    QVector<Parallel::Chunk> chunks = Parallel::chunks(0, rows, 512);
+    QVector<Part> parts(chunks.size());
+
+    Parallel::forRange(0, chunks.size(), [&](qint64 begin, qint64 end) {
+        // Sums per column, and the columns seen in the current row
+        Entries entries;
+        QVector<double> sum(cols, 0.0);
+        QVector<int> seenInRow(cols, -1);
+        QVector<int> rowColumns;
+        for (qint64 c = begin; c < end; ++c) {
+            const Parallel::Chunk& chunk = chunks[c];
+            Part& part = parts[c];
+            part.rowSize.reserve(chunk.end - chunk.begin);
+            for (qint64 row = chunk.begin; row < chunk.end; ++row) {
+                entries.clear();
+                rowFn(int(row), entries);
+                rowColumns.clear();
+                for (const QPair<int, double>& entry : std::as_const(entries)) {
+                    if (seenInRow[entry.first] != row) {
+                        seenInRow[entry.first] = int(row);
+                        sum[entry.first] = 0.0;
+                        rowColumns.append(entry.first);
+                    }
+                    sum[entry.first] += entry.second;
+                }
+                std::sort(rowColumns.begin(), rowColumns.end());
+                const int before = part.columns.size();
+                for (int column : std::as_const(rowColumns)) {
+                    if (sum[column] != 0.0) {
+                        part.columns.append(column);
+                        part.values.append(sum[column]);
+                    }
+                }
+                part.rowSize.append(part.columns.size() - before);
+            }
+        }
+    }, 1);
+
+    Matrix m;
+    m.rows = rows;
+    m.cols = cols;
+    m.rowStart = QVector<int>(rows + 1, 0);
+    QVector<int> partStart(parts.size() + 1, 0);
+    int row = 0;
+    for (int c = 0; c < parts.size(); ++c) {
+        for (int size : std::as_const(parts[c].rowSize)) {
+            m.rowStart[row + 1] = m.rowStart[row] + size;
+            ++row;
+        }
+        partStart[c + 1] = partStart[c] + parts[c].columns.size();
+    }
+    m.columns = QVector<int>(partStart.last());
+    m.values = QVector<double>(partStart.last());
+    Parallel::forRange(0, parts.size(), [&](qint64 begin, qint64 end) {
+        for (qint64 c = begin; c < end; ++c) {
+            std::copy(parts[c].columns.cbegin(), parts[c].columns.cend(), m.columns.begin() + partStart[c]);
+            std::copy(parts[c].values.cbegin(), parts[c].values.cend(), m.values.begin() + partStart[c]);
+        }
+    }, 1);
+    return m;
+}
+
+AmgPreconditioner::Matrix AmgPreconditioner::transpose(const Matrix& m)
+{
+    Matrix t;
+    t.rows = m.cols;
+    t.cols = m.rows;
+    t.rowStart = QVector<int>(t.rows + 1, 0);
+    for (int column : m.columns) {
+        ++t.rowStart[column + 1];
+    }
+    for (int r = 0; r < t.rows; ++r) {
+        t.rowStart[r + 1] += t.rowStart[r];
+    }
+    t.columns = QVector<int>(m.nonZeros());
+    t.values = QVector<double>(m.nonZeros());
+    QVector<int> fill = t.rowStart;
+    for (int r = 0; r < m.rows; ++r) {
+        for (int k = m.rowStart[r]; k < m.rowStart[r + 1]; ++k) {
+            const int position = fill[m.columns[k]]++;
+            t.columns[position] = r;
+            t.values[position] = m.values[k];
+        }
+    }
+    return t;
+}
+
+AmgPreconditioner::Matrix AmgPreconditioner::product(const Matrix& a, const Matrix& b)
+{
+    return buildRows(a.rows, b.cols, [&](int row, Entries& entries) {
+        for (int k = a.rowStart[row]; k < a.rowStart[row + 1]; ++k) {
+            const int j = a.columns[k];
+            const double value = a.values[k];
+            for (int m = b.rowStart[j]; m < b.rowStart[j + 1]; ++m) {
+                entries.append({ b.columns[m], value * b.values[m] });
+            }
+        }
+    });
+}
+
+void AmgPreconditioner::multiply(const Matrix& m, const double* x, double* y)
+{
+    const int* rowStart = m.rowStart.constData();
+    const int* columns = m.columns.constData();
+    const double* values = m.values.constData();
+    Parallel::forRange(0, m.rows, [=](qint64 begin, qint64 end) {
+        for (qint64 row = begin; row < end; ++row) {
+            double sum = 0.0;
+            for (int k = rowStart[row]; k < rowStart[row + 1]; ++k) {
+                sum += values[k] * x[columns[k]];
+            }
+            y[row] = sum;
+        }
+    }, 2048);
+}
+
+void AmgPreconditioner::setupLevel(Level& level) const
+{
+    const Matrix& A = level.A;
+    level.inverseDiagonal = QVector<double>(A.rows, 1.0);
+
+    for (int i = 0; i < A.rows; ++i) {
+        for (int k = A.rowStart[i]; k < A.rowStart[i + 1]; ++k) {
+            if (A.columns[k] == i && A.values[k] > 0.0) {
+                level.inverseDiagonal[i] = 1.0 / A.values[k];
+            }
+        }
+    }
+
+    // rho(D^-1 A) by power iteration from a fixed pseudo-random start;
+    // the estimate approaches rho from below, so pad it a little
+    QVector<double> v(A.rows), w(A.rows);
+    for (int i = 0; i < A.rows; ++i) {
+        v[i] = double((quint32(i) * 2654435761u) >> 8) / double(1 << 24) + 0.5;
+    }
+    double rho = 0.0;
+    for (int iteration = 0; iteration < PowerIterations && A.rows > 0; ++iteration) {
+        multiply(A, v.constData(), w.data());
+        double norm = 0.0;
+        double previous = 0.0;
+        for (int i = 0; i < A.rows; ++i) {
+            w[i] *= level.inverseDiagonal[i];
+            norm += w[i] * w[i];
+            previous += v[i] * v[i];
+        }
+        if (norm == 0.0) {
+            break;
+        }
+        rho = std::sqrt(norm / previous);
+        const double scale = 1.0 / std::sqrt(norm);
+        for (int i = 0; i < A.rows; ++i) {
+            v[i] = w[i] * scale;
+        }
+    }
+    level.omega = rho > 0.0 ? 4.0 / (3.0 * 1.05 * rho) : 1.0;
+
+    level.b = QVector<double>(A.rows, 0.0);
+    level.x = QVector<double>(A.rows, 0.0);
+    level.r = QVector<double>(A.rows, 0.0);
+}
+
+QVector<int> AmgPreconditioner::aggregate(const Level& level, int* count) const
+{
+    const Matrix& A = level.A;
+    const int n = A.rows;
+    const double theta = m_settings.strengthThreshold;
+
+    // Strong couplings; rows without any (fixed temperatures) stay
+    // unaggregated and are handled by the smoother alone
+    QVector<char> strong(A.nonZeros(), 0);
+    QVector<char> hasStrong(n, 0);
+    for (int i = 0; i < n; ++i) {
+        const double aii = 1.0 / level.inverseDiagonal[i];
+        for (int k = A.rowStart[i]; k < A.rowStart[i + 1]; ++k) {
+            const int j = A.columns[k];
+            const double ajj = 1.0 / level.inverseDiagonal[j];
+            if (j != i && std::abs(A.values[k]) >= theta * std::sqrt(aii * ajj)) {
+                strong[k] = 1;
+                hasStrong[i] = 1;
+            }
+        }
+    }
+
+    QVector<int> result(n, -1);
+    int aggregates = 0;
+
+    // 1: a node and its strong neighbours, if none is taken yet
+    for (int i = 0; i < n; ++i) {
+        if (result[i] != -1 || !hasStrong[i]) {
+            continue;
+        }
+        bool free = true;
+        for (int k = A.rowStart[i]; k < A.rowStart[i + 1] && free; ++k) {
+            free = !strong[k] || result[A.columns[k]] == -1;
+        }
+        if (!free) {
+            continue;
+        }
+        result[i] = aggregates;
+        for (int k = A.rowStart[i]; k < A.rowStart[i + 1]; ++k) {
+            if (strong[k]) {
+                result[A.columns[k]] = aggregates;
+            }
+        }
+        ++aggregates;
+    }
+
+    // 2: join the most strongly coupled aggregate from pass 1
+    const QVector<int> firstPass = result;
+    for (int i = 0; i < n; ++i) {
+        if (result[i] != -1 || !hasStrong[i]) {
+            continue;
+        }
+        double strongest = 0.0;
+        for (int k = A.rowStart[i]; k < A.rowStart[i + 1]; ++k) {
+            const int j = A.columns[k];
+            if (strong[k] && firstPass[j] != -1 && std::abs(A.values[k]) > strongest) {
+                strongest = std::abs(A.values[k]);
+                result[i] = firstPass[j];
+            }
+        }
+    }
+
+    // 3: whatever is left forms aggregates with its free strong neighbours
+    for (int i = 0; i < n; ++i) {
+        if (result[i] != -1 || !hasStrong[i]) {
+            continue;
+        }
+        result[i] = aggregates;
+        for (int k = A.rowStart[i]; k < A.rowStart[i + 1]; ++k) {
+            if (strong[k] && result[A.columns[k]] == -1) {
+                result[A.columns[k]] = aggregates;
+            }
+        }
+        ++aggregates;
+    }
+
+    *count = aggregates;
+    return result;
+}
+
+AmgPreconditioner::Matrix AmgPreconditioner::smoothedProlongator(const Level& level, int coarseCount) const
+{
+    // P = (I - omega D^-1 A) T, T the piecewise constant aggregate map
+    const Matrix& A = level.A;
+    const int* aggregates = level.aggregate.constData();
+    const double* inverseDiagonal = level.inverseDiagonal.constData();
+    const double omega = level.omega;
+    return buildRows(A.rows, coarseCount, [&](int row, Entries& entries) {
+        if (aggregates[row] != -1) {
+            entries.append({ aggregates[row], 1.0 });
+        }
+        const double scale = -omega * inverseDiagonal[row];
+        for (int k = A.rowStart[row]; k < A.rowStart[row + 1]; ++k) {
+            const int a = aggregates[A.columns[k]];
+            if (a != -1) {
+                entries.append({ a, scale * A.values[k] });
+            }
+        }
+    });
+}
+
+void AmgPreconditioner::factorCoarsest()
+{
+    const Matrix& A = m_levels.last().A;
+    const int n = A.rows;
+    m_coarseFactor.clear();
+    if (n > DirectSolveLimit) {
+        qWarning() << "AmgPreconditioner: coarsest level has" << n << "unknowns; smoothing instead of factoring";
+        return;
+    }
+
+    QVector<double> L(qint64(n) * n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        for (int k = A.rowStart[i]; k < A.rowStart[i + 1]; ++k) {
+            L[qint64(i) * n + A.columns[k]] = A.values[k];
+        }
+    }
+    for (int j = 0; j < n; ++j) {
+        double* rowJ = L.data() + qint64(j) * n;
+        double d = rowJ[j];
+        for (int k = 0; k < j; ++k) {
+            d -= rowJ[k] * rowJ[k];
+        }
+        if (d <= 0.0) {
+            qWarning() << "AmgPreconditioner: coarsest level is not positive definite; smoothing instead";
+            return;
+        }
+        rowJ[j] = std::sqrt(d);
+        for (int i = j + 1; i < n; ++i) {
+            double* rowI = L.data() + qint64(i) * n;
+            double s = rowI[j];
+            for (int k = 0; k < j; ++k) {
+                s -= rowI[k] * rowJ[k];
+            }
+            rowI[j] = s / rowJ[j];
+        }
+    }
+    m_coarseFactor = L;
+}
+
+void AmgPreconditioner::apply(const QVector<double>& r, QVector<double>& z) const
+{
+    z.resize(r.size());
+    cycle(0, r.constData(), z.data());
+}
+
+void AmgPreconditioner::smooth(const Level& level, const double* b, double* x) const
+{
+    // x += omega D^-1 (b - A x)
+    double* ax = level.r.data();
+    multiply(level.A, x, ax);
+    const double* inverseDiagonal = level.inverseDiagonal.constData();
+    const double omega = level.omega;
+    Parallel::forRange(0, level.A.rows, [=](qint64 begin, qint64 end) {
+        for (qint64 i = begin; i < end; ++i) {
+            x[i] += omega * inverseDiagonal[i] * (b[i] - ax[i]);
+        }
+    });
+}
+
+void AmgPreconditioner::cycle(int index, const double* b, double* x) const
+{
+    const Level& level = m_levels[index];
+    if (index + 1 == m_levels.size()) {
+        solveCoarsest(b, x);
+        return;
+    }
+
+    // Pre-smoothing from x = 0; the first sweep is x = omega D^-1 b
+    const double* inverseDiagonal = level.inverseDiagonal.constData();
+    const double omega = level.omega;
+    Parallel::forRange(0, level.A.rows, [=](qint64 begin, qint64 end) {
+        for (qint64 i = begin; i < end; ++i) {
+            x[i] = omega * inverseDiagonal[i] * b[i];
+        }
+    });
+    for (int s = 1; s < m_settings.smoothingSteps; ++s) {
+        smooth(level, b, x);
+    }
+
+    // Coarse correction of the residual
+    double* r = level.r.data();
+    multiply(level.A, x, r);
+    Parallel::forRange(0, level.A.rows, [=](qint64 begin, qint64 end) {
+        for (qint64 i = begin; i < end; ++i) {
+            r[i] = b[i] - r[i];
+        }
+    });
+    const Level& coarse = m_levels[index + 1];
+    multiply(level.R, r, coarse.b.data());
+    cycle(index + 1, coarse.b.constData(), coarse.x.data());
+    multiply(level.P, coarse.x.constData(), r);
+    Parallel::forRange(0, level.A.rows, [=](qint64 begin, qint64 end) {
+        for (qint64 i = begin; i < end; ++i) {
+            x[i] += r[i];
+        }
+    });
+
+    for (int s = 0; s < m_settings.smoothingSteps; ++s) {
+        smooth(level, b, x);
+    }
+}
+
+void AmgPreconditioner::solveCoarsest(const double* b, double* x) const
+{
+    const Level& level = m_levels.last();
+    const int n = level.A.rows;
+    if (m_coarseFactor.isEmpty()) {
+        std::fill(x, x + n, 0.0);
+        for (int s = 0; s < CoarseSmoothingSteps; ++s) {
+            smooth(level, b, x);
+        }
+        return;
+    }
+
+    // L L^T x = b
+    const double* L = m_coarseFactor.constData();
+    for (int i = 0; i < n; ++i) {
+        double s = b[i];
+        for (int k = 0; k < i; ++k) {
+            s -= L[qint64(i) * n + k] * x[k];
+        }
+        x[i] = s / L[qint64(i) * n + i];
+    }
+    for (int i = n - 1; i >= 0; --i) {
+        double s = x[i];
+        for (int k = i + 1; k < n; ++k) {
+            s -= L[qint64(k) * n + i] * x[k];
+        }
+        x[i] = s / L[qint64(i) * n + i];
+    }
+}
@@ -0,0 +1,240 @@
+#include "solver/ConjugateGradient.h"
+#include "solver/SparseMatrix.h"
+#include "solver/AmgPreconditioner.h"
+#include "solver/Parallel.h"
+
+#include <QDebug>
+#include <cmath>
+
+namespace {
+
+double dot(const QVector<double>& a, const QVector<double>& b)
+{
+    const double* pa = a.constData();
+    const double* pb = b.constData();
+    return Parallel::sum(0, a.size(), [=](qint64 begin, qint64 end) {
+        double s = 0.0;
+        for (qint64 i = begin; i < end; ++i) {
+            s += pa[i] * pb[i];
+        }
+        return s;
+    });
+}
+
+} // namespace
+
+std::unique_ptr<Preconditioner> Preconditioner::create(Type type, const SparseMatrix& matrix)
+{
+    switch (type) {
+    case Jacobi: return std::make_unique<JacobiPreconditioner>(matrix);
+    case IncompleteLU: return std::make_unique<IncompleteLUPreconditioner>(matrix);
+    case Multigrid: return std::make_unique<AmgPreconditioner>(matrix);
+    }
+    return std::make_unique<JacobiPreconditioner>(matrix);
+}
+
+JacobiPreconditioner::JacobiPreconditioner(const SparseMatrix& matrix)
+{
+    updateValues(matrix);
+}
+
+void JacobiPreconditioner::updateValues(const SparseMatrix& matrix)
+{
+    m_inverseDiagonal = matrix.diagonal();
+    for (double& d : m_inverseDiagonal) {
+        d = d != 0.0 ? 1.0 / d : 1.0;
+    }
+}
+
+void JacobiPreconditioner::apply(const QVector<double>& r, QVector<double>& z) const
+{
+    z.resize(r.size());
+    const double* in = r.constData();
+    const double* inverse = m_inverseDiagonal.constData();
+    double* out = z.data();
+    Parallel::forRange(0, r.size(), [=](qint64 begin, qint64 end) {
+        for (qint64 i = begin; i < end; ++i) {
+            out[i] = inverse[i] * in[i];
+        }
+    });
+}
+
+IncompleteLUPreconditioner::IncompleteLUPreconditioner(const SparseMatrix& matrix)
+    : m_rowStart(matrix.rowStart())
+    , m_columns(matrix.columns())
+    , m_diagonal(matrix.rows(), -1)
+{
+    int missing = 0;
+    for (int row = 0; row < matrix.rows(); ++row) {
+        m_diagonal[row] = matrix.find(row, row);
+        missing += m_diagonal[row] == -1 ? 1 : 0;
+    }
+    if (missing > 0) {
+        qWarning() << "IncompleteLUPreconditioner:" << missing << "rows without a stored diagonal left unpreconditioned";
+    }
+    updateValues(matrix);
+}
+
+void IncompleteLUPreconditioner::updateValues(const SparseMatrix& matrix)
+{
+    m_values = matrix.values();
+    const int* rowStart = m_rowStart.constData();
+    const int* columns = m_columns.constData();
+    const int* diagonal = m_diagonal.constData();
+    double* values = m_values.data();
+    int replacedPivots = 0;
+
+    // IKJ elimination restricted to the pattern; columns are sorted
+    for (int i = 0; i < matrix.rows(); ++i) {
+        const int rowEnd = rowStart[i + 1];
+        for (int ik = rowStart[i]; ik < rowEnd && columns[ik] < i; ++ik) {
+            const int k = columns[ik];
+            // Rows without a diagonal pass through unchanged; decouple them
+            if (diagonal[k] == -1) {
+                values[ik] = 0.0;
+                continue;
+            }
+            values[ik] /= values[diagonal[k]];
+            int ij = ik + 1;
+            for (int kj = diagonal[k] + 1; kj < rowStart[k + 1]; ++kj) {
+                while (ij < rowEnd && columns[ij] < columns[kj]) {
+                    ++ij;
+                }
+                if (ij == rowEnd) {
+                    break;
+                }
+                if (columns[ij] == columns[kj]) {
+                    values[ij] -= values[ik] * values[kj];
+                }
+            }
+        }
+        // A breakdown would poison every later row; keep the original pivot
+        // (or 1 if that is not positive either), so divisions stay finite
+        if (diagonal[i] == -1) {
+            continue;
+        }
+        if (!(values[diagonal[i]] > 0.0)) {
+            values[diagonal[i]] = matrix.values()[diagonal[i]] > 0.0 ? matrix.values()[diagonal[i]] : 1.0;
+            ++replacedPivots;
+        }
+    }
+    if (replacedPivots > 0) {
+        qWarning() << "IncompleteLUPreconditioner:" << replacedPivots << "non-positive pivots replaced";
+    }
+}
+
+void IncompleteLUPreconditioner::apply(const QVector<double>& r, QVector<double>& z) const
+{
+    const int n = m_diagonal.size();
+    z.resize(n);
+    const int* rowStart = m_rowStart.constData();
+    const int* columns = m_columns.constData();
+    const int* diagonal = m_diagonal.constData();
+    const double* values = m_values.constData();
+    double* out = z.data();
+
+    // L y = r, then U z = y
+    for (int i = 0; i < n; ++i) {
+        double s = r[i];
+        for (int k = rowStart[i]; k < rowStart[i + 1] && columns[k] < i; ++k) {
+            s -= values[k] * out[columns[k]];
+        }
+        out[i] = s;
+    }
+    for (int i = n - 1; i >= 0; --i) {
+        if (diagonal[i] == -1) {
+            continue;
+        }
+        double s = out[i];
+        for (int k = diagonal[i] + 1; k < rowStart[i + 1]; ++k) {
+            s -= values[k] * out[columns[k]];
+        }
+        out[i] = s / values[diagonal[i]];
+    }
+}
+
+ConjugateGradient::Result ConjugateGradient::solve(const SparseMatrix& A, const QVector<double>& b, QVector<double>& x,
+                                                   const Preconditioner& preconditioner, const Settings& settings,
+                                                   const Progress& progress)
+{
+    Result result;
+    const qint64 n = A.rows();
+    if (x.size() != n) {
+        x = QVector<double>(n, 0.0);
+    }
+
+    const double bNorm = std::sqrt(dot(b, b));
+    if (bNorm == 0.0) {
+        x.fill(0.0);
+        result.converged = true;
+        return result;
+    }
+
+    // r = b - A x
+    QVector<double> r(n), z(n), p(n), q(n);
+    A.multiply(x, q);
+    {
+        const double* pb = b.constData();
+        const double* pq = q.constData();
+        double* pr = r.data();
+        Parallel::forRange(0, n, [=](qint64 begin, qint64 end) {
+            for (qint64 i = begin; i < end; ++i) pr[i] = pb[i] - pq[i];
+        });
+    }
+
+    preconditioner.apply(r, z);
+    p = z;
+    double rz = dot(r, z);
+    double rNorm = std::sqrt(dot(r, r));
+
+    while (true) {
+        result.relativeResidual = rNorm / bNorm;
+        if (result.relativeResidual <= settings.tolerance) {
+            result.converged = true;
+            break;
+        }
+        if (result.iterations >= settings.maxIterations) {
+            break;
+        }
+        if (progress && result.iterations % ProgressInterval == 0 &&
+            !progress(result.iterations, result.relativeResidual)) {
+            result.cancelled = true;
+            break;
+        }
+
+        A.multiply(p, q);
+        const double alpha = rz / dot(p, q);
+
+        // x += alpha p; r -= alpha q, fused with the residual norm
+        double* px = x.data();
+        double* pr = r.data();
+        const double* pp = p.constData();
+        const double* pq = q.constData();
+        const double rr = Parallel::sum(0, n, [=](qint64 begin, qint64 end) {
+            double s = 0.0;
+            for (qint64 i = begin; i < end; ++i) {
+                px[i] += alpha * pp[i];
+                pr[i] -= alpha * pq[i];
+                s += pr[i] * pr[i];
+            }
+            return s;
+        });
+        rNorm = std::sqrt(rr);
+
+        preconditioner.apply(r, z);
+        const double rzNew = dot(r, z);
+        const double beta = rzNew / rz;
+        rz = rzNew;
+
+        // p = z + beta p
+        const double* pz = z.constData();
+        double* pw = p.data();
+        Parallel::forRange(0, n, [=](qint64 begin, qint64 end) {
+            for (qint64 i = begin; i < end; ++i) pw[i] = pz[i] + beta * pw[i];
+        });
+
+        ++result.iterations;
+    }
+
+    return result;
+}
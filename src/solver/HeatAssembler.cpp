@@ -0,0 +1,396 @@
+#include "solver/HeatAssembler.h"
+#include "solver/ThermalMaterials.h"
+#include "solver/Parallel.h"
+
+#include <QtAlgorithms>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+constexpr double pi = 3.14159265358979323846;
+
+inline void cross(const double a[3], const double b[3], double out[3])
+{
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+inline double dot3(const double a[3], const double b[3])
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+double tetVolume(const double (&p)[4][3])
+{
+    const double e1[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+    const double e2[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+    const double e3[3] = { p[3][0] - p[0][0], p[3][1] - p[0][1], p[3][2] - p[0][2] };
+    double n[3];
+    cross(e2, e3, n);
+    return std::abs(dot3(e1, n)) / 6.0;
+}
+
+} // namespace
+
+HeatAssembler::HeatAssembler(const TetMesh& mesh, const ThermalMaterials& materials)
+    : m_mesh(mesh)
+    , m_materials(materials)
+{
+    buildPattern();
+    colourElements();
+}
+
+QVector<double> HeatAssembler::regionConductivity() const
+{
+    QVector<double> result;
+    result.reserve(m_mesh.regionMaterial.size());
+    for (int materialId : m_mesh.regionMaterial) {
+        result.append(m_materials.material(materialId).conductivity);
+    }
+    return result;
+}
+
+void HeatAssembler::buildPattern()
+{
+    const int nodes = m_mesh.nodeCount();
+    const int elements = m_mesh.elementCount();
+    const int* tets = m_mesh.tets.constData();
+
+    // Elements of each node (CSR)
+    QVector<int> elementStart(nodes + 1, 0);
+    for (int i = 0; i < elements * 4; ++i) {
+        ++elementStart[tets[i] + 1];
+    }
+    for (int n = 0; n < nodes; ++n) {
+        elementStart[n + 1] += elementStart[n];
+    }
+    QVector<int> nodeElements(elements * 4);
+    {
+        QVector<int> fill = elementStart;
+        for (int i = 0; i < elements * 4; ++i) {
+            nodeElements[fill[tets[i]]++] = i / 4;
+        }
+    }
+
+    // Row n: every node of every element of n, sorted and unique
+    auto neighbours = [&](int n, QVector<int>& row) {
+        row.clear();
+        for (int k = elementStart[n]; k < elementStart[n + 1]; ++k) {
+            const int* tet = tets + 4 * nodeElements[k];
+            row.append(tet[0]);
+            row.append(tet[1]);
+            row.append(tet[2]);
+            row.append(tet[3]);
+        }
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+    };
+
+    // Count the rows in parallel, then fill them at their offsets
+    m_rowStart = QVector<int>(nodes + 1, 0);
+    int* rowStart = m_rowStart.data();
+    Parallel::forRange(0, nodes, [&](qint64 begin, qint64 end) {
+        QVector<int> row;
+        for (qint64 n = begin; n < end; ++n) {
+            neighbours(int(n), row);
+            rowStart[n + 1] = row.size();
+        }
+    }, 1024);
+    for (int n = 0; n < nodes; ++n) {
+        rowStart[n + 1] += rowStart[n];
+    }
+
+    m_columns = QVector<int>(rowStart[nodes]);
+    int* columns = m_columns.data();
+    Parallel::forRange(0, nodes, [&](qint64 begin, qint64 end) {
+        QVector<int> row;
+        for (qint64 n = begin; n < end; ++n) {
+            neighbours(int(n), row);
+            std::copy(row.cbegin(), row.cend(), columns + rowStart[n]);
+        }
+    }, 1024);
+}
+
+void HeatAssembler::colourElements()
+{
+    const int elements = m_mesh.elementCount();
+    const int* tets = m_mesh.tets.constData();
+
+    // Greedy: the lowest colour none of the element's nodes has seen yet.
+    // A 64-bit mask per node tracks 64 colours; elements left over when
+    // all are taken go to a further round of 64.
+    QVector<int> colour(elements, -1);
+    QVector<quint64> used(m_mesh.nodeCount());
+    QVector<int> remaining(elements);
+    std::iota(remaining.begin(), remaining.end(), 0);
+    int colours = 0;
+    for (int round = 0; !remaining.isEmpty(); ++round) {
+        used.fill(0);
+        QVector<int> next;
+        for (int e : std::as_const(remaining)) {
+            const int* tet = tets + 4 * e;
+            const quint64 taken = used[tet[0]] | used[tet[1]] | used[tet[2]] | used[tet[3]];
+            if (taken == ~quint64(0)) {
+                next.append(e);
+                continue;
+            }
+            const int c = qCountTrailingZeroBits(~taken);
+            const quint64 bit = quint64(1) << c;
+            used[tet[0]] |= bit;
+            used[tet[1]] |= bit;
+            used[tet[2]] |= bit;
+            used[tet[3]] |= bit;
+            colour[e] = 64 * round + c;
+            colours = qMax(colours, colour[e] + 1);
+        }
+        remaining.swap(next);
+    }
+
+    // Group by colour, keeping element order within a colour
+    m_colourStart = QVector<int>(colours + 1, 0);
+    for (int e = 0; e < elements; ++e) {
+        ++m_colourStart[colour[e] + 1];
+    }
+    for (int c = 0; c < colours; ++c) {
+        m_colourStart[c + 1] += m_colourStart[c];
+    }
+    m_colouredElements = QVector<int>(elements);
+    QVector<int> fill = m_colourStart;
+    for (int e = 0; e < elements; ++e) {
+        m_colouredElements[fill[colour[e]]++] = e;
+    }
+}
+
+SparseMatrix HeatAssembler::createMatrix() const
+{
+    return SparseMatrix(m_mesh.nodeCount(), m_rowStart, m_columns);
+}
+
+double HeatAssembler::elementConductivity(const double (&p)[4][3], double conductivity, double (&ke)[4][4])
+{
+    const double e1[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+    const double e2[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+    const double e3[3] = { p[3][0] - p[0][0], p[3][1] - p[0][1], p[3][2] - p[0][2] };
+
+    // Shape function gradients: rows of the inverse Jacobian
+    double g[4][3];
+    cross(e2, e3, g[1]);
+    cross(e3, e1, g[2]);
+    cross(e1, e2, g[3]);
+    const double det = dot3(e1, g[1]);
+    if (det == 0.0) {
+        std::fill(&ke[0][0], &ke[0][0] + 16, 0.0);
+        return 0.0;
+    }
+    for (int a = 1; a < 4; ++a) {
+        for (int c = 0; c < 3; ++c) {
+            g[a][c] /= det;
+        }
+    }
+    for (int c = 0; c < 3; ++c) {
+        g[0][c] = -(g[1][c] + g[2][c] + g[3][c]);
+    }
+
+    const double volume = std::abs(det) / 6.0;
+    const double scale = conductivity * volume;
+    for (int a = 0; a < 4; ++a) {
+        for (int b = a; b < 4; ++b) {
+            ke[a][b] = ke[b][a] = scale * dot3(g[a], g[b]);
+        }
+    }
+    return volume;
+}
+
+void HeatAssembler::assemble(const BoundaryConditions& conditions, SparseMatrix& K, QVector<double>& rhs) const
+{
+    K.setZero();
+    rhs = QVector<double>(m_mesh.nodeCount(), 0.0);
+
+    const QVector<double> conductivity = regionConductivity();
+    double* values = K.values().data();
+    const int* tets = m_mesh.tets.constData();
+
+    // Elements of a colour touch disjoint rows: no two threads write the
+    // same entry
+    const int* coloured = m_colouredElements.constData();
+    for (int c = 0; c < colourCount(); ++c) {
+        Parallel::forRange(m_colourStart[c], m_colourStart[c + 1], [&](qint64 begin, qint64 end) {
+            for (qint64 i = begin; i < end; ++i) {
+                const int e = coloured[i];
+                const int* tet = tets + 4 * e;
+                double p[4][3];
+                for (int a = 0; a < 4; ++a) {
+                    p[a][0] = m_mesh.x[tet[a]];
+                    p[a][1] = m_mesh.y[tet[a]];
+                    p[a][2] = m_mesh.z[tet[a]];
+                }
+                double ke[4][4];
+                elementConductivity(p, conductivity[m_mesh.elementRegion[e]], ke);
+
+                for (int a = 0; a < 4; ++a) {
+                    for (int b = 0; b < 4; ++b) {
+                        values[K.find(tet[a], tet[b])] += ke[a][b];
+                    }
+                }
+            }
+        }, 2048);
+    }
+
+    // Convection, lumped onto the face nodes: the consistent h ∫ Ni Nj dA
+    // has positive off-diagonals and overshoots the ambient temperature
+    // where h is large against λ / element size
+    double coefficient[TetMesh::SideCount] = {};
+    double ambient[TetMesh::SideCount] = {};
+    for (const Convection& convection : conditions.convection) {
+        coefficient[convection.side] = convection.coefficient;
+        ambient[convection.side] = convection.ambientTemperature;
+    }
+
+    for (int f = 0; f < m_mesh.boundaryFaceCount(); ++f) {
+        const double h = coefficient[m_mesh.boundarySide[f]];
+        if (h <= 0.0) {
+            continue;
+        }
+        const int* face = m_mesh.boundaryFaces.constData() + 3 * f;
+        const double area = faceArea(f);
+        for (int a = 0; a < 3; ++a) {
+            values[K.find(face[a], face[a])] += h * area / 3.0;
+        }
+    }
+    addConvectionLoad(coefficient, ambient, rhs);
+}
+
+void HeatAssembler::assembleLoad(const BoundaryConditions& conditions, double time, QVector<double>& rhs) const
+{
+    // Reuses rhs: called once per time step
+    rhs.fill(0.0, m_mesh.nodeCount());
+    double coefficient[TetMesh::SideCount] = {};
+    double ambient[TetMesh::SideCount] = {};
+    for (const Convection& convection : conditions.convection) {
+        coefficient[convection.side] = convection.coefficient;
+        ambient[convection.side] = ambientTemperature(convection, time);
+    }
+    addConvectionLoad(coefficient, ambient, rhs);
+}
+
+void HeatAssembler::addConvectionLoad(const double (&coefficient)[TetMesh::SideCount],
+                                      const double (&ambient)[TetMesh::SideCount], QVector<double>& rhs) const
+{
+    for (int f = 0; f < m_mesh.boundaryFaceCount(); ++f) {
+        const int side = m_mesh.boundarySide[f];
+        const double h = coefficient[side];
+        if (h <= 0.0) {
+            continue;
+        }
+        const int* face = m_mesh.boundaryFaces.constData() + 3 * f;
+        const double load = h * ambient[side] * faceArea(f) / 3.0;
+        rhs[face[0]] += load;
+        rhs[face[1]] += load;
+        rhs[face[2]] += load;
+    }
+}
+
+double HeatAssembler::ambientTemperature(const Convection& convection, double time)
+{
+    // Coldest on coldestDay, warmest half a year later
+    const double days = time / SecondsPerDay;
+    return convection.ambientTemperature -
+           convection.amplitude * std::cos(2.0 * pi * (days - convection.coldestDay) / DaysPerYear);
+}
+
+double HeatAssembler::faceArea(int f) const
+{
+    const int* face = m_mesh.boundaryFaces.constData() + 3 * f;
+    const double e1[3] = { m_mesh.x[face[1]] - m_mesh.x[face[0]], m_mesh.y[face[1]] - m_mesh.y[face[0]],
+                           m_mesh.z[face[1]] - m_mesh.z[face[0]] };
+    const double e2[3] = { m_mesh.x[face[2]] - m_mesh.x[face[0]], m_mesh.y[face[2]] - m_mesh.y[face[0]],
+                           m_mesh.z[face[2]] - m_mesh.z[face[0]] };
+    double n[3];
+    cross(e1, e2, n);
+    return 0.5 * std::sqrt(dot3(n, n));
+}
+
+QVector<double> HeatAssembler::lumpedCapacity() const
+{
+    QVector<double> heatCapacity;
+    heatCapacity.reserve(m_mesh.regionMaterial.size());
+    for (int materialId : m_mesh.regionMaterial) {
+        heatCapacity.append(m_materials.material(materialId).volumetricHeatCapacity());
+    }
+
+    // A quarter of ρ c V to each node; colours keep the nodes disjoint
+    QVector<double> capacity(m_mesh.nodeCount(), 0.0);
+    double* out = capacity.data();
+    const int* tets = m_mesh.tets.constData();
+    const int* coloured = m_colouredElements.constData();
+    for (int c = 0; c < colourCount(); ++c) {
+        Parallel::forRange(m_colourStart[c], m_colourStart[c + 1], [&](qint64 begin, qint64 end) {
+            for (qint64 i = begin; i < end; ++i) {
+                const int e = coloured[i];
+                const int* tet = tets + 4 * e;
+                double p[4][3];
+                for (int a = 0; a < 4; ++a) {
+                    p[a][0] = m_mesh.x[tet[a]];
+                    p[a][1] = m_mesh.y[tet[a]];
+                    p[a][2] = m_mesh.z[tet[a]];
+                }
+                const double share = heatCapacity[m_mesh.elementRegion[e]] * tetVolume(p) / 4.0;
+                for (int a = 0; a < 4; ++a) {
+                    out[tet[a]] += share;
+                }
+            }
+        }, 2048);
+    }
+    return capacity;
+}
+
+QVector<double> HeatAssembler::fixedTemperatures(const BoundaryConditions& conditions) const
+{
+    QVector<double> fixed(m_mesh.nodeCount(), std::numeric_limits<double>::quiet_NaN());
+    for (const FixedTemperature& condition : conditions.fixed) {
+        for (int f = 0; f < m_mesh.boundaryFaceCount(); ++f) {
+            if (m_mesh.boundarySide[f] != condition.side) {
+                continue;
+            }
+            for (int a = 0; a < 3; ++a) {
+                fixed[m_mesh.boundaryFaces[3 * f + a]] = condition.temperature;
+            }
+        }
+    }
+    return fixed;
+}
+
+void HeatAssembler::applyFixedTemperatures(const QVector<double>& fixed, SparseMatrix& K, QVector<double>& rhs)
+{
+    const int* rowStart = K.rowStart().constData();
+    const int* columns = K.columns().constData();
+    double* values = K.values().data();
+
+    for (int j = 0; j < K.rows(); ++j) {
+        const double t = fixed[j];
+        if (std::isnan(t)) {
+            continue;
+        }
+        // The pattern is symmetric: row j lists the rows with column j
+        for (int k = rowStart[j]; k < rowStart[j + 1]; ++k) {
+            const int i = columns[k];
+            if (i == j) {
+                values[k] = 1.0;
+                continue;
+            }
+            values[k] = 0.0;
+            if (std::isnan(fixed[i])) {
+                const int ij = K.find(i, j);
+                rhs[i] -= values[ij] * t;
+                values[ij] = 0.0;
+            }
+        }
+        rhs[j] = t;
+    }
+}
@@ -0,0 +1,456 @@
+#include "solver/SceneTetrahedralizer.h"
+#include "solver/Parallel.h"
+#include "scene/ObjectManager.h"
+#include "scene/SceneObject.h"
+#include "scene/BoxObject.h"
+#include "mesh/MeshData.h"
+#include "mesh/HalfEdgeMesh.h"
+
+#include <QHash>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Kuhn split of a unit cell: each tetrahedron walks from corner 0 to
+// corner 7 along the axes in one order. Corner bits: 1 = +x, 2 = +y, 4 = +z.
+const int axisOrders[6][3] = {
+    { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 }
+};
+
+// First cell whose centre is >= value / > value
+int firstCentreAtLeast(const QVector<double>& centres, double value)
+{
+    return int(std::lower_bound(centres.cbegin(), centres.cend(), value) - centres.cbegin());
+}
+
+int firstCentreAbove(const QVector<double>& centres, double value)
+{
+    return int(std::upper_bound(centres.cbegin(), centres.cend(), value) - centres.cbegin());
+}
+
+// x where the line through (y, z) along +x crosses the triangle, if it
+// does. Points on an edge count for exactly one of the two triangles
+// sharing it (top-left rule in the yz projection), so a closed surface
+// is crossed an even number of times along any line.
+bool crossX(const QVector3D* corner, double y, double z, double* x)
+{
+    double e[3];
+    bool topLeft[3];
+    for (int i = 0; i < 3; ++i) {
+        const QVector3D& a = corner[(i + 1) % 3];
+        const QVector3D& b = corner[(i + 2) % 3];
+        const double dy = double(b.y()) - a.y();
+        const double dz = double(b.z()) - a.z();
+        e[i] = dy * (z - a.z()) - dz * (y - a.y());
+        topLeft[i] = dz < 0.0 || (dz == 0.0 && dy > 0.0);
+    }
+    const double area = e[0] + e[1] + e[2];
+    if (area == 0.0) {
+        return false;  // Edge-on
+    }
+    for (int i = 0; i < 3; ++i) {
+        // Clockwise in projection: the edges run the other way
+        const double edge = area > 0.0 ? e[i] : -e[i];
+        const bool owns = area > 0.0 ? topLeft[i] : !topLeft[i];
+        if (edge < 0.0 || (edge == 0.0 && !owns)) {
+            return false;
+        }
+    }
+    *x = (e[0] * corner[0].x() + e[1] * corner[1].x() + e[2] * corner[2].x()) / area;
+    return true;
+}
+
+// Paint the cells in [begin, end) whose centres lie inside a closed
+// surface: rows along x, each toggling inside at every crossing
+void fillSurface(const QVector<QVector3D>& triangles, const QVector<double>* centres,
+                 const int* begin, const int* end, int cx, int cy, qint16 region, qint16* cells)
+{
+    const int rowsY = end[1] - begin[1];
+    const int rowsZ = end[2] - begin[2];
+    if (rowsY <= 0 || rowsZ <= 0 || end[0] <= begin[0]) {
+        return;
+    }
+
+    // Bucket triangles by the rows their yz bounds cover (CSR)
+    const int triangleCount = triangles.size() / 3;
+    QVector<int> rowStart(rowsY * rowsZ + 1, 0);
+    auto forEachRow = [&](int t, auto&& fn) {
+        const QVector3D* c = triangles.constData() + 3 * t;
+        const double y0 = qMin(c[0].y(), qMin(c[1].y(), c[2].y()));
+        const double y1 = qMax(c[0].y(), qMax(c[1].y(), c[2].y()));
+        const double z0 = qMin(c[0].z(), qMin(c[1].z(), c[2].z()));
+        const double z1 = qMax(c[0].z(), qMax(c[1].z(), c[2].z()));
+        const int j0 = qMax(begin[1], firstCentreAtLeast(centres[1], y0));
+        const int j1 = qMin(end[1], firstCentreAbove(centres[1], y1));
+        const int k0 = qMax(begin[2], firstCentreAtLeast(centres[2], z0));
+        const int k1 = qMin(end[2], firstCentreAbove(centres[2], z1));
+        for (int k = k0; k < k1; ++k) {
+            for (int j = j0; j < j1; ++j) {
+                fn((k - begin[2]) * rowsY + (j - begin[1]));
+            }
+        }
+    };
+    for (int t = 0; t < triangleCount; ++t) {
+        forEachRow(t, [&](int row) { ++rowStart[row + 1]; });
+    }
+    for (int row = 0; row < rowsY * rowsZ; ++row) {
+        rowStart[row + 1] += rowStart[row];
+    }
+    QVector<int> rowTriangles(rowStart.last());
+    QVector<int> fill = rowStart;
+    for (int t = 0; t < triangleCount; ++t) {
+        forEachRow(t, [&](int row) { rowTriangles[fill[row]++] = t; });
+    }
+
+    Parallel::forRange(0, rowsY * rowsZ, [&](qint64 first, qint64 last) {
+        QVector<double> hits;
+        for (qint64 row = first; row < last; ++row) {
+            const int j = begin[1] + int(row % rowsY);
+            const int k = begin[2] + int(row / rowsY);
+            hits.clear();
+            for (int n = rowStart[row]; n < rowStart[row + 1]; ++n) {
+                double x;
+                if (crossX(triangles.constData() + 3 * rowTriangles[n], centres[1][j], centres[2][k], &x)) {
+                    hits.append(x);
+                }
+            }
+            std::sort(hits.begin(), hits.end());
+
+            qint16* line = cells + (qint64(k) * cy + j) * cx;
+            int next = 0;
+            bool inside = false;
+            for (int i = begin[0]; i < end[0]; ++i) {
+                while (next < hits.size() && hits[next] < centres[0][i]) {
+                    inside = !inside;
+                    ++next;
+                }
+                if (inside) {
+                    line[i] = region;
+                }
+            }
+        }
+    }, 16);
+}
+
+} // namespace
+
+QVector<SceneTetrahedralizer::Block> SceneTetrahedralizer::snapshot(const ObjectManager& objectManager)
+{
+    QVector<Block> blocks;
+    int approximated = 0;
+    for (const SceneObject* object : objectManager.allObjects()) {
+        const BoundingBox& bounds = object->worldBounds();
+        if (!object->isVisible() || bounds.isEmpty()) {
+            continue;
+        }
+        Block block;
+        block.bounds = bounds;
+        block.materialId = object->materialId();
+        block.elementSize = object->meshSize();
+        if (!qobject_cast<const BoxObject*>(object) || !object->rotation().isNull()) {
+            block.triangles = closedSurface(*object);
+            if (block.triangles.isEmpty()) {
+                ++approximated;
+            }
+        }
+        blocks.append(block);
+    }
+    if (approximated > 0) {
+        qWarning() << "SceneTetrahedralizer:" << approximated << "objects without a closed surface meshed as their bounds";
+    }
+    return blocks;
+}
+
+QVector<QVector3D> SceneTetrahedralizer::closedSurface(const SceneObject& object)
+{
+    const MeshData* mesh = object.meshData();
+    if (!mesh || mesh->faceCount() == 0) {
+        return {};
+    }
+    const HalfEdgeMesh* topology = mesh->halfEdgeTopology();
+    if (!topology->isManifold() || !topology->boundaryEdges().isEmpty()) {
+        return {};
+    }
+
+    // Fan-triangulated like the rendered geometry, in world space
+    const QMatrix4x4 transform = object.transformMatrix();
+    QVector<QVector3D> positions(mesh->vertexCount());
+    for (const MeshData::Vertex& vertex : mesh->getVertices()) {
+        positions[mesh->vertexSlot(vertex.index)] = transform.map(vertex.position);
+    }
+    QVector<QVector3D> triangles;
+    for (const MeshData::Face& face : mesh->getFaces()) {
+        for (int i = 2; i < face.vertices.size(); ++i) {
+            triangles.append(positions[mesh->vertexSlot(face.vertices[0])]);
+            triangles.append(positions[mesh->vertexSlot(face.vertices[i - 1])]);
+            triangles.append(positions[mesh->vertexSlot(face.vertices[i])]);
+        }
+    }
+    return triangles;
+}
+
+QVector<double> SceneTetrahedralizer::gridLines(const QVector<Block>& blocks, int axis, double elementSize)
+{
+    QVector<double> breaks;
+    for (const Block& block : blocks) {
+        breaks.append(block.bounds.min()[axis]);
+        breaks.append(block.bounds.max()[axis]);
+    }
+    std::sort(breaks.begin(), breaks.end());
+    if (breaks.isEmpty()) {
+        return breaks;
+    }
+
+    // Faces closer than this are the same grid line
+    const double tolerance = 1e-9 * qMax(1.0, breaks.last() - breaks.first());
+
+    QVector<double> lines;
+    lines.append(breaks.first());
+    for (double b : std::as_const(breaks)) {
+        const double a = lines.last();
+        if (b - a <= tolerance) {
+            continue;
+        }
+
+        // Finest size among the blocks spanning this interval
+        const double middle = 0.5 * (a + b);
+        double size = elementSize;
+        for (const Block& block : blocks) {
+            if (block.elementSize > 0.0 && block.bounds.min()[axis] <= middle && middle <= block.bounds.max()[axis]) {
+                size = qMin(size, block.elementSize);
+            }
+        }
+
+        const int divisions = qMax(1, int(std::ceil((b - a) / size - 1e-9)));
+        for (int i = 1; i < divisions; ++i) {
+            lines.append(a + (b - a) * i / divisions);
+        }
+        lines.append(b);
+    }
+    return lines;
+}
+
+TetMesh SceneTetrahedralizer::build(const QVector<Block>& blocks, const Settings& settings)
+{
+    TetMesh mesh;
+
+    BoundingBox modelBounds;
+    for (const Block& block : blocks) {
+        modelBounds.expand(block.bounds);
+    }
+    if (modelBounds.isEmpty()) {
+        return mesh;
+    }
+
+    const QVector3D size = modelBounds.size();
+    const double longest = qMax(size.x(), qMax(size.y(), size.z()));
+    const double elementSize = settings.elementSize > 0.0 ? settings.elementSize
+                                                          : longest / qMax(1, settings.autoDivisions);
+
+    QVector<double> lines[3];
+    QVector<double> centres[3];
+    int cells[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        lines[axis] = gridLines(blocks, axis, elementSize);
+        cells[axis] = qMax(0, int(lines[axis].size()) - 1);
+        for (int i = 0; i < cells[axis]; ++i) {
+            centres[axis].append(0.5 * (lines[axis][i] + lines[axis][i + 1]));
+        }
+    }
+    const int cx = cells[0], cy = cells[1], cz = cells[2];
+    const int nx = cx + 1, ny = cy + 1, nz = cz + 1;
+    auto cellIndex = [&](int i, int j, int k) { return (qint64(k) * cy + j) * cx + i; };
+    auto gridNode = [&](int i, int j, int k) { return (qint64(k) * ny + j) * nx + i; };
+
+    // Paint cells with the region of each block in order; later blocks win
+    QHash<int, int> regionOfMaterial;
+    QVector<qint16> cellRegion(qint64(cx) * cy * cz, -1);
+    for (const Block& block : blocks) {
+        auto it = regionOfMaterial.find(block.materialId);
+        if (it == regionOfMaterial.end()) {
+            it = regionOfMaterial.insert(block.materialId, mesh.regionMaterial.size());
+            mesh.regionMaterial.append(block.materialId);
+        }
+        const qint16 region = qint16(*it);
+
+        int begin[3], end[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            begin[axis] = firstCentreAtLeast(centres[axis], block.bounds.min()[axis]);
+            end[axis] = firstCentreAbove(centres[axis], block.bounds.max()[axis]);
+        }
+        if (!block.triangles.isEmpty()) {
+            fillSurface(block.triangles, centres, begin, end, cx, cy, region, cellRegion.data());
+            continue;
+        }
+        qint16* paint = cellRegion.data();
+        Parallel::forRange(begin[2], end[2], [&](qint64 first, qint64 last) {
+            for (qint64 k = first; k < last; ++k) {
+                for (int j = begin[1]; j < end[1]; ++j) {
+                    qint16* row = paint + cellIndex(0, j, int(k));
+                    std::fill(row + begin[0], row + end[0], region);
+                }
+            }
+        }, 1);
+    }
+
+    // The layer loops below write disjoint ranges through raw pointers
+    const qint16* regionOfCell = cellRegion.constData();
+    auto occupied = [&](int i, int j, int k) {
+        return i >= 0 && i < cx && j >= 0 && j < cy && k >= 0 && k < cz && regionOfCell[cellIndex(i, j, k)] >= 0;
+    };
+
+    // Number the nodes of occupied cells in grid order (keeps the matrix
+    // bandwidth small): count per z layer, then number from each layer's
+    // offset, so the numbering does not depend on the thread count
+    QVector<int> nodeOfGrid(qint64(nx) * ny * nz, -1);
+    int* nodeIds = nodeOfGrid.data();
+    QVector<int> layerFirstNode(nz + 1, 0);
+    Parallel::forRange(0, nz, [&](qint64 first, qint64 last) {
+        for (qint64 k = first; k < last; ++k) {
+            int count = 0;
+            for (int j = 0; j < ny; ++j) {
+                for (int i = 0; i < nx; ++i) {
+                    bool used = false;
+                    for (int corner = 0; corner < 8 && !used; ++corner) {
+                        used = occupied(i - (corner & 1), j - ((corner >> 1) & 1), int(k) - ((corner >> 2) & 1));
+                    }
+                    if (used) {
+                        nodeIds[gridNode(i, j, int(k))] = 0;
+                        ++count;
+                    }
+                }
+            }
+            layerFirstNode[k + 1] = count;
+        }
+    }, 1);
+    for (int k = 0; k < nz; ++k) {
+        layerFirstNode[k + 1] += layerFirstNode[k];
+    }
+
+    const int nodeCount = layerFirstNode.last();
+    mesh.x.resize(nodeCount);
+    mesh.y.resize(nodeCount);
+    mesh.z.resize(nodeCount);
+    double* nodeX = mesh.x.data();
+    double* nodeY = mesh.y.data();
+    double* nodeZ = mesh.z.data();
+    Parallel::forRange(0, nz, [&](qint64 first, qint64 last) {
+        for (qint64 k = first; k < last; ++k) {
+            int id = layerFirstNode[k];
+            for (int j = 0; j < ny; ++j) {
+                for (int i = 0; i < nx; ++i) {
+                    int& node = nodeIds[gridNode(i, j, int(k))];
+                    if (node < 0) continue;
+                    node = id++;
+                    nodeX[node] = lines[0][i];
+                    nodeY[node] = lines[1][j];
+                    nodeZ[node] = lines[2][k];
+                }
+            }
+        }
+    }, 1);
+
+    // Cell faces without an occupied neighbour are boundary
+    auto exposed = [&](int i, int j, int k, int axis, int side) {
+        int neighbour[3] = { i, j, k };
+        neighbour[axis] += side ? 1 : -1;
+        return !occupied(neighbour[0], neighbour[1], neighbour[2]);
+    };
+
+    // Elements and boundary faces the same way: count per cell layer, then
+    // fill from each layer's offsets
+    QVector<qint64> layerFirstCell(cz + 1, 0);
+    QVector<qint64> layerFirstFace(cz + 1, 0);
+    Parallel::forRange(0, cz, [&](qint64 first, qint64 last) {
+        for (qint64 k = first; k < last; ++k) {
+            qint64 cellCount = 0;
+            qint64 faceCount = 0;
+            for (int j = 0; j < cy; ++j) {
+                for (int i = 0; i < cx; ++i) {
+                    if (regionOfCell[cellIndex(i, j, int(k))] < 0) continue;
+                    ++cellCount;
+                    for (int face = 0; face < 6; ++face) {
+                        faceCount += exposed(i, j, int(k), face / 2, face % 2) ? 2 : 0;
+                    }
+                }
+            }
+            layerFirstCell[k + 1] = cellCount;
+            layerFirstFace[k + 1] = faceCount;
+        }
+    }, 1);
+    for (int k = 0; k < cz; ++k) {
+        layerFirstCell[k + 1] += layerFirstCell[k];
+        layerFirstFace[k + 1] += layerFirstFace[k];
+    }
+
+    mesh.tets.resize(layerFirstCell.last() * 24);
+    mesh.elementRegion.resize(layerFirstCell.last() * 6);
+    mesh.boundaryFaces.resize(layerFirstFace.last() * 3);
+    mesh.boundarySide.resize(layerFirstFace.last());
+    int* tets = mesh.tets.data();
+    quint16* elementRegions = mesh.elementRegion.data();
+    int* boundaryFaces = mesh.boundaryFaces.data();
+    quint8* boundarySides = mesh.boundarySide.data();
+
+    Parallel::forRange(0, cz, [&](qint64 first, qint64 last) {
+        for (qint64 k = first; k < last; ++k) {
+            int* tet = tets + layerFirstCell[k] * 24;
+            quint16* tetRegion = elementRegions + layerFirstCell[k] * 6;
+            int* face = boundaryFaces + layerFirstFace[k] * 3;
+            quint8* faceSide = boundarySides + layerFirstFace[k];
+
+            for (int j = 0; j < cy; ++j) {
+                for (int i = 0; i < cx; ++i) {
+                    const qint16 region = regionOfCell[cellIndex(i, j, int(k))];
+                    if (region < 0) continue;
+
+                    int corners[8];
+                    for (int corner = 0; corner < 8; ++corner) {
+                        corners[corner] = nodeIds[gridNode(i + (corner & 1), j + ((corner >> 1) & 1),
+                                                              int(k) + ((corner >> 2) & 1))];
+                    }
+
+                    for (const auto& order : axisOrders) {
+                        const int c1 = 1 << order[0];
+                        const int c2 = c1 | (1 << order[1]);
+                        *tet++ = corners[0];
+                        *tet++ = corners[c1];
+                        *tet++ = corners[c2];
+                        *tet++ = corners[7];
+                        *tetRegion++ = quint16(region);
+                    }
+
+                    for (int axis = 0; axis < 3; ++axis) {
+                        for (int side = 0; side < 2; ++side) {
+                            if (!exposed(i, j, int(k), axis, side)) {
+                                continue;
+                            }
+
+                            // Face triangulation matching the Kuhn split: the
+                            // diagonal runs from the face's lowest corner
+                            const int u = axis == 0 ? 1 : 0;
+                            const int v = axis == 2 ? 1 : 2;
+                            const int c00 = side << axis;
+                            const int c10 = c00 | (1 << u);
+                            const int c01 = c00 | (1 << v);
+                            const int c11 = c10 | c01;
+                            const int faces[2][3] = { { c00, c10, c11 }, { c00, c11, c01 } };
+                            for (const auto& triangle : faces) {
+                                for (int corner : triangle) {
+                                    *face++ = corners[corner];
+                                }
+                                *faceSide++ = quint8(axis * 2 + side);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }, 1);
+
+    qDebug() << "SceneTetrahedralizer:" << mesh.nodeCount() << "nodes," << mesh.elementCount() << "tetrahedra,"
+             << mesh.boundaryFaceCount() << "boundary faces, cell size" << elementSize;
+    return mesh;
+}
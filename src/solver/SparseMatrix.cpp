@@ -0,0 +1,66 @@
+#include "solver/SparseMatrix.h"
+#include "solver/Parallel.h"
+
+#include <algorithm>
+#include <utility>
+
+SparseMatrix::SparseMatrix(int rows, QVector<int> rowStart, QVector<int> columns)
+    : m_rows(rows)
+    , m_rowStart(std::move(rowStart))
+    , m_columns(std::move(columns))
+    , m_values(m_columns.size(), 0.0)
+{
+}
+
+int SparseMatrix::find(int row, int column) const
+{
+    const int* begin = m_columns.constData() + m_rowStart[row];
+    const int* end = m_columns.constData() + m_rowStart[row + 1];
+    const int* it = std::lower_bound(begin, end, column);
+    return (it != end && *it == column) ? int(it - m_columns.constData()) : -1;
+}
+
+void SparseMatrix::setZero()
+{
+    double* values = m_values.data();
+    Parallel::forRange(0, m_values.size(), [values](qint64 begin, qint64 end) {
+        std::fill(values + begin, values + end, 0.0);
+    });
+}
+
+void SparseMatrix::multiply(const QVector<double>& x, QVector<double>& y) const
+{
+    y.resize(m_rows);
+    const int* rowStart = m_rowStart.constData();
+    const int* columns = m_columns.constData();
+    const double* values = m_values.constData();
+    const double* in = x.constData();
+    double* out = y.data();
+
+    Parallel::forRange(0, m_rows, [=](qint64 begin, qint64 end) {
+        for (qint64 row = begin; row < end; ++row) {
+            double sum = 0.0;
+            for (int k = rowStart[row]; k < rowStart[row + 1]; ++k) {
+                sum += values[k] * in[columns[k]];
+            }
+            out[row] = sum;
+        }
+    }, 2048);
+}
+
+QVector<double> SparseMatrix::diagonal() const
+{
+    QVector<double> result(m_rows, 0.0);
+    for (int row = 0; row < m_rows; ++row) {
+        const int k = find(row, row);
+        if (k != -1) {
+            result[row] = m_values[k];
+        }
+    }
+    return result;
+}
+
+qint64 SparseMatrix::memoryBytes() const
+{
+    return qint64(m_rowStart.size() + m_columns.size()) * sizeof(int) + qint64(m_values.size()) * sizeof(double);
+}
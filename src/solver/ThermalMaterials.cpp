@@ -0,0 +1,24 @@
+#include "solver/ThermalMaterials.h"
+
+ThermalMaterials::ThermalMaterials()
+{
+    // Same order as the Materials dock; ρ and c as in ISO 10456 / ISO 13370
+    m_materials.append({ QStringLiteral("Concrete"), 1.7, 2300.0, 1000.0 });
+    m_materials.append({ QStringLiteral("Brick"), 0.8, 1800.0, 840.0 });
+    m_materials.append({ QStringLiteral("Insulation"), 0.04, 30.0, 1450.0 });
+    m_materials.append({ QStringLiteral("Soil"), 2.0, 2000.0, 1000.0 });
+}
+
+const ThermalMaterial& ThermalMaterials::material(int materialId) const
+{
+    if (materialId < 0 || materialId >= m_materials.size()) {
+        return m_materials[DefaultMaterial];
+    }
+    return m_materials[materialId];
+}
+
+int ThermalMaterials::add(const ThermalMaterial& material)
+{
+    m_materials.append(material);
+    return m_materials.size() - 1;
+}
@@ -0,0 +1,270 @@
+#include "solver/ThermalSolver.h"
+#include "solver/TransientWriter.h"
+#include "scene/ObjectManager.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+ThermalSolver::ThermalSolver(QObject* parent)
+    : QObject(parent)
+    , m_running(false)
+    , m_cancel(false)
+{
+}
+
+ThermalSolver::~ThermalSolver()
+{
+    // The worker reports through this object; let it stop first
+    cancel();
+    m_future.waitForFinished();
+}
+
+ThermalSolver::Settings ThermalSolver::defaultSettings()
+{
+    Settings settings;
+    settings.boundaryConditions.fixed.append({ TetMesh::NegY, 10.0 });
+    settings.boundaryConditions.convection.append({ TetMesh::PosY, 20.0, 7.7 });
+    return settings;
+}
+
+ThermalSolver::Settings ThermalSolver::defaultTransientSettings()
+{
+    Settings settings;
+    settings.boundaryConditions.fixed.append({ TetMesh::NegY, 10.0 });
+    HeatAssembler::Convection outdoor{ TetMesh::PosY, 10.0, 25.0 };
+    outdoor.amplitude = 9.0;
+    settings.boundaryConditions.convection.append(outdoor);
+    return settings;
+}
+
+bool ThermalSolver::isRunning() const
+{
+    return m_running;
+}
+
+void ThermalSolver::cancel()
+{
+    m_cancel = true;
+}
+
+bool ThermalSolver::solveSteadyState(const ObjectManager& objectManager, const Settings& settings)
+{
+    return start(objectManager, settings, QString());
+}
+
+bool ThermalSolver::solveTransient(const ObjectManager& objectManager, const Settings& settings,
+                                   const QString& outputDirectory)
+{
+    return !outputDirectory.isEmpty() && start(objectManager, settings, outputDirectory);
+}
+
+bool ThermalSolver::start(const ObjectManager& objectManager, const Settings& settings, const QString& outputDirectory)
+{
+    if (m_running) {
+        return false;
+    }
+    const QVector<SceneTetrahedralizer::Block> blocks = SceneTetrahedralizer::snapshot(objectManager);
+    if (blocks.isEmpty()) {
+        qWarning() << "ThermalSolver: nothing to solve";
+        return false;
+    }
+
+    m_running = true;
+    m_cancel = false;
+    auto* watcher = new QFutureWatcher<std::shared_ptr<Result>>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher]() {
+        watcher->deleteLater();
+        m_running = false;
+        m_result = watcher->result();
+        emit finished(m_result->ok);
+    });
+    m_future = QtConcurrent::run([this, blocks, settings, outputDirectory]() {
+        // The steady-state system is released before time stepping starts
+        std::shared_ptr<Result> result = run(blocks, settings);
+        if (result->ok && !outputDirectory.isEmpty()) {
+            runTransient(*result, settings, outputDirectory);
+        }
+        return result;
+    });
+    watcher->setFuture(m_future);
+    return true;
+}
+
+void ThermalSolver::report(const QString& message)
+{
+    qDebug() << "ThermalSolver:" << message;
+    QMetaObject::invokeMethod(this, [this, message]() { emit progress(message); }, Qt::QueuedConnection);
+}
+
+std::shared_ptr<ThermalSolver::Result> ThermalSolver::run(const QVector<SceneTetrahedralizer::Block>& blocks,
+                                                          const Settings& settings)
+{
+    auto result = std::make_shared<Result>();
+    QElapsedTimer timer;
+
+    timer.start();
+    result->mesh = SceneTetrahedralizer::build(blocks, settings.mesh);
+    result->meshSeconds = timer.elapsed() / 1000.0;
+    const TetMesh& mesh = result->mesh;
+    if (mesh.elementCount() == 0) {
+        result->error = tr("The scene produced no volume elements");
+        return result;
+    }
+    report(tr("Mesh: %1 nodes, %2 tetrahedra (%3 s)")
+               .arg(mesh.nodeCount()).arg(mesh.elementCount()).arg(result->meshSeconds, 0, 'f', 2));
+
+    timer.restart();
+    const HeatAssembler assembler(mesh, m_materials);
+    const QVector<double> fixed = assembler.fixedTemperatures(settings.boundaryConditions);
+    if (settings.boundaryConditions.fixed.isEmpty() && settings.boundaryConditions.convection.isEmpty()) {
+        result->error = tr("No boundary conditions: the temperature is undetermined");
+        return result;
+    }
+
+    SparseMatrix K = assembler.createMatrix();
+    QVector<double> rhs;
+    assembler.assemble(settings.boundaryConditions, K, rhs);
+    HeatAssembler::applyFixedTemperatures(fixed, K, rhs);
+    result->assemblySeconds = timer.elapsed() / 1000.0;
+    result->matrixBytes = K.memoryBytes();
+    report(tr("Assembly: %1 nonzeros, %2 MB (%3 s)")
+               .arg(K.nonZeros()).arg(K.memoryBytes() / (1024.0 * 1024.0), 0, 'f', 1)
+               .arg(result->assemblySeconds, 0, 'f', 2));
+
+    if (m_cancel) {
+        result->error = tr("Cancelled");
+        return result;
+    }
+
+    // Start from the fixed temperatures (or their mean) to save iterations
+    double start = 0.0;
+    int fixedCount = 0;
+    for (double t : fixed) {
+        if (!std::isnan(t)) {
+            start += t;
+            ++fixedCount;
+        }
+    }
+    start = fixedCount > 0 ? start / fixedCount : 0.0;
+    QVector<double> temperatures(mesh.nodeCount(), start);
+    for (int i = 0; i < fixed.size(); ++i) {
+        if (!std::isnan(fixed[i])) {
+            temperatures[i] = fixed[i];
+        }
+    }
+
+    timer.restart();
+    const std::unique_ptr<Preconditioner> preconditioner = Preconditioner::create(settings.preconditioner, K);
+    result->preconditionerSeconds = timer.elapsed() / 1000.0;
+    report(tr("%1 (%2 s)").arg(preconditioner->description()).arg(result->preconditionerSeconds, 0, 'f', 2));
+
+    timer.restart();
+    result->solve = ConjugateGradient::solve(K, rhs, temperatures, *preconditioner, settings.solver,
+        [this](int iteration, double residual) {
+            if (iteration > 0 && iteration % (ConjugateGradient::ProgressInterval * 40) == 0) {
+                report(tr("CG iteration %1, residual %2").arg(iteration).arg(residual, 0, 'e', 2));
+            }
+            return !m_cancel;
+        });
+    result->solveSeconds = timer.elapsed() / 1000.0;
+
+    if (result->solve.cancelled) {
+        result->error = tr("Cancelled");
+        return result;
+    }
+    report(tr("%1-preconditioned CG: %2 iterations, residual %3 (%4 s)")
+               .arg(preconditioner->name()).arg(result->solve.iterations)
+               .arg(result->solve.relativeResidual, 0, 'e', 2).arg(result->solveSeconds, 0, 'f', 2));
+    if (!result->solve.converged) {
+        result->error = tr("The solver did not converge");
+    }
+
+    const auto range = std::minmax_element(temperatures.cbegin(), temperatures.cend());
+    result->minTemperature = *range.first;
+    result->maxTemperature = *range.second;
+    result->temperatures = std::move(temperatures);
+    result->ok = result->solve.converged;
+    return result;
+}
+
+void ThermalSolver::runTransient(Result& result, const Settings& settings, const QString& outputDirectory)
+{
+    const TransientIntegrator::Settings& transient = settings.transient;
+    result.ok = false;
+
+    QElapsedTimer timer;
+    timer.start();
+    TransientWriter writer;
+    if (!writer.open(outputDirectory, result.mesh, result.temperatures)) {
+        result.error = tr("Cannot write results to %1").arg(outputDirectory);
+        return;
+    }
+    report(tr("Transient: %1 days, steps %2..%3 h, %4")
+               .arg(transient.duration / HeatAssembler::SecondsPerDay, 0, 'f', 1)
+               .arg(transient.minStep / 3600.0, 0, 'g', 3).arg(transient.maxStep / 3600.0, 0, 'g', 3)
+               .arg(transient.theta < 1.0 ? tr("Crank-Nicolson") : tr("backward Euler")));
+
+    TransientIntegrator integrator(result.mesh, m_materials, settings.boundaryConditions);
+    bool writeFailed = false;
+    result.transient = integrator.run(result.temperatures, transient,
+        [&](const TransientIntegrator::Step& step, const QVector<double>& temperatures) {
+            if (!writer.write(step, temperatures)) {
+                writeFailed = true;
+                return false;
+            }
+            if (step.output) {
+                report(tr("Day %1: %2 .. %3 °C (step %4 h)")
+                           .arg(step.time / HeatAssembler::SecondsPerDay, 0, 'f', 1)
+                           .arg(step.minTemperature, 0, 'f', 2).arg(step.maxTemperature, 0, 'f', 2)
+                           .arg(step.size / 3600.0, 0, 'g', 3));
+            }
+            return !m_cancel;
+        });
+    writer.close();
+    result.transientSeconds = timer.elapsed() / 1000.0;
+    result.frameCount = writer.frameCount();
+
+    if (writeFailed) {
+        result.error = tr("Writing the results failed");
+        return;
+    }
+    if (result.transient.cancelled) {
+        result.error = tr("Cancelled");
+        return;
+    }
+    if (!result.transient.completed) {
+        result.error = result.transient.error;
+        return;
+    }
+    report(tr("Transient: %1 steps (%2 rejected), %3 preconditioner updates, %4 CG iterations, %5 frames (%6 s)")
+               .arg(result.transient.steps).arg(result.transient.rejectedSteps)
+               .arg(result.transient.preconditionerUpdates).arg(result.transient.iterations)
+               .arg(result.frameCount).arg(result.transientSeconds, 0, 'f', 2));
+
+    const auto range = std::minmax_element(result.temperatures.cbegin(), result.temperatures.cend());
+    result.minTemperature = *range.first;
+    result.maxTemperature = *range.second;
+    result.ok = true;
+}
+
+bool ThermalSolver::writeNodeCsv(const Result& result, const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "ThermalSolver: cannot write" << filePath << file.errorString();
+        return false;
+    }
+    QTextStream out(&file);
+    out << "node,x,y,z,temperature\n";
+    for (int i = 0; i < result.temperatures.size(); ++i) {
+        out << i << ',' << result.mesh.x[i] << ',' << result.mesh.y[i] << ',' << result.mesh.z[i] << ','
+            << result.temperatures[i] << '\n';
+    }
+    return true;
+}
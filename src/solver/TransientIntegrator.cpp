@@ -0,0 +1,194 @@
+#include "solver/TransientIntegrator.h"
+#include "solver/ThermalMaterials.h"
+#include "solver/Parallel.h"
+
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+namespace {
+
+// Accepted steps at one size before it may double
+constexpr int StepsBeforeGrowth = 3;
+
+} // namespace
+
+TransientIntegrator::TransientIntegrator(const TetMesh& mesh, const ThermalMaterials& materials,
+                                         const HeatAssembler::BoundaryConditions& conditions)
+    : m_mesh(mesh)
+    , m_conditions(conditions)
+    , m_assembler(mesh, materials)
+{
+    // K with convection, without eliminating fixed temperatures: the
+    // right-hand side needs the full K T
+    m_K = m_assembler.createMatrix();
+    QVector<double> meanLoad;
+    m_assembler.assemble(m_conditions, m_K, meanLoad);
+    m_capacity = m_assembler.lumpedCapacity();
+
+    m_diagonal = QVector<int>(mesh.nodeCount());
+    for (int row = 0; row < mesh.nodeCount(); ++row) {
+        m_diagonal[row] = m_K.find(row, row);
+    }
+
+    m_fixed = m_assembler.fixedTemperatures(m_conditions);
+    for (double& t : m_fixed) {
+        if (!std::isnan(t)) {
+            t = 0.0;
+        }
+    }
+}
+
+void TransientIntegrator::buildSystem(double step, double theta, SparseMatrix& A) const
+{
+    // A = C / dt + theta K, then rows and columns of fixed nodes replaced
+    // by the identity (their increment is zero)
+    const double* k = m_K.values().constData();
+    double* a = A.values().data();
+    Parallel::forRange(0, A.nonZeros(), [=](qint64 begin, qint64 end) {
+        for (qint64 i = begin; i < end; ++i) {
+            a[i] = theta * k[i];
+        }
+    });
+    const double* capacity = m_capacity.constData();
+    const int* diagonal = m_diagonal.constData();
+    Parallel::forRange(0, A.rows(), [=](qint64 begin, qint64 end) {
+        for (qint64 row = begin; row < end; ++row) {
+            a[diagonal[row]] += capacity[row] / step;
+        }
+    });
+
+    QVector<double> unused(A.rows(), 0.0);
+    HeatAssembler::applyFixedTemperatures(m_fixed, A, unused);
+}
+
+TransientIntegrator::Result TransientIntegrator::run(QVector<double>& temperatures, const Settings& settings,
+                                                     const StepCallback& callback)
+{
+    Result result;
+    const int n = m_mesh.nodeCount();
+    if (temperatures.size() != n) {
+        result.error = QStringLiteral("Initial temperatures do not match the mesh");
+        return result;
+    }
+
+    const double theta = qBound(0.5, settings.theta, 1.0);
+    const double maxStep = qMax(settings.minStep, settings.maxStep);
+    double step = qBound(settings.minStep, settings.initialStep, maxStep);
+
+    SparseMatrix A = m_assembler.createMatrix();
+    buildSystem(step, theta, A);
+    const std::unique_ptr<Preconditioner> preconditioner = Preconditioner::create(settings.preconditioner, A);
+    auto resize = [&](double newStep) {
+        step = newStep;
+        buildSystem(step, theta, A);
+        preconditioner->updateValues(A);
+        ++result.preconditionerUpdates;
+    };
+
+    QVector<double> loadOld;
+    QVector<double> loadNew;
+    QVector<double> kt(n, 0.0);
+    QVector<double> rhs(n, 0.0);
+    QVector<double> delta(n, 0.0);
+    QVector<double> previousDelta;
+    m_assembler.assembleLoad(m_conditions, 0.0, loadOld);
+
+    double time = 0.0;
+    double previousStep = 0.0;
+    double nextOutput = settings.outputInterval;
+    int stepsAtSize = 0;
+    const double* fixed = m_fixed.constData();
+
+    while (time < settings.duration * (1.0 - 1e-12)) {
+        // rhs = theta f(t + dt) + (1 - theta) f(t) - K T, zero at fixed nodes
+        m_assembler.assembleLoad(m_conditions, time + step, loadNew);
+        m_K.multiply(temperatures, kt);
+        {
+            const double* fOld = loadOld.constData();
+            const double* fNew = loadNew.constData();
+            const double* pkt = kt.constData();
+            double* prhs = rhs.data();
+            Parallel::forRange(0, n, [=](qint64 begin, qint64 end) {
+                for (qint64 i = begin; i < end; ++i) {
+                    prhs[i] = std::isnan(fixed[i]) ? theta * fNew[i] + (1.0 - theta) * fOld[i] - pkt[i] : 0.0;
+                }
+            });
+        }
+
+        delta.fill(0.0);
+        const ConjugateGradient::Result solve =
+            ConjugateGradient::solve(A, rhs, delta, *preconditioner, settings.solver);
+        result.iterations += solve.iterations;
+        if (!solve.converged) {
+            result.error = QString("The solver did not converge at t = %1 d").arg(time / HeatAssembler::SecondsPerDay);
+            return result;
+        }
+
+        // Local error: distance from the extrapolated previous increment
+        double error = 0.0;
+        if (!previousDelta.isEmpty()) {
+            const double ratio = step / previousStep;
+            for (int i = 0; i < n; ++i) {
+                error = qMax(error, std::abs(delta[i] - ratio * previousDelta[i]));
+            }
+            error *= step / (step + previousStep);
+        }
+        if (error > settings.tolerance && step > settings.minStep) {
+            ++result.rejectedSteps;
+            stepsAtSize = 0;
+            resize(qMax(settings.minStep, step / 2.0));
+            continue;
+        }
+
+        // Accept
+        double* t = temperatures.data();
+        const double* d = delta.constData();
+        Parallel::forRange(0, n, [=](qint64 begin, qint64 end) {
+            for (qint64 i = begin; i < end; ++i) {
+                t[i] += d[i];
+            }
+        });
+        time += step;
+        loadOld.swap(loadNew);
+        previousDelta.swap(delta);
+        if (delta.size() != n) {
+            delta = QVector<double>(n, 0.0);
+        }
+        previousStep = step;
+        ++result.steps;
+        ++stepsAtSize;
+
+        Step info;
+        info.index = result.steps;
+        info.time = time;
+        info.size = step;
+        info.errorEstimate = error;
+        info.iterations = solve.iterations;
+        const auto range = std::minmax_element(temperatures.cbegin(), temperatures.cend());
+        info.minTemperature = *range.first;
+        info.maxTemperature = *range.second;
+        const bool last = time >= settings.duration * (1.0 - 1e-12);
+        if (time >= nextOutput - 1e-6 * step || last) {
+            info.output = true;
+            while (nextOutput <= time + 1e-6 * step) {
+                nextOutput += qMax(settings.outputInterval, settings.minStep);
+            }
+        }
+        if (callback && !callback(info, temperatures)) {
+            result.cancelled = true;
+            return result;
+        }
+
+        // Doubling the step roughly quadruples the error estimate
+        if (stepsAtSize >= StepsBeforeGrowth && 4.0 * error < 0.5 * settings.tolerance && 2.0 * step <= maxStep) {
+            stepsAtSize = 0;
+            resize(2.0 * step);
+        }
+    }
+
+    result.completed = true;
+    return result;
+}
@@ -0,0 +1,95 @@
+#include "solver/TransientWriter.h"
+#include "solver/HeatAssembler.h"
+
+#include <QDir>
+#include <QtEndian>
+#include <QDebug>
+#include <cstring>
+
+TransientWriter::~TransientWriter()
+{
+    close();
+}
+
+bool TransientWriter::open(const QString& directory, const TetMesh& mesh, const QVector<double>& initialTemperatures)
+{
+    close();
+
+    const QDir dir(directory);
+    if (!dir.mkpath(QStringLiteral("."))) {
+        qWarning() << "TransientWriter: cannot create" << directory;
+        return false;
+    }
+
+    QFile nodes(dir.filePath(QStringLiteral("nodes.csv")));
+    if (!nodes.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "TransientWriter: cannot write" << nodes.fileName() << nodes.errorString();
+        return false;
+    }
+    QTextStream nodeStream(&nodes);
+    nodeStream << "node,x,y,z\n";
+    for (int i = 0; i < mesh.nodeCount(); ++i) {
+        nodeStream << i << ',' << mesh.x[i] << ',' << mesh.y[i] << ',' << mesh.z[i] << '\n';
+    }
+
+    auto log = std::make_unique<QFile>(dir.filePath(QStringLiteral("steps.csv")));
+    if (!log->open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "TransientWriter: cannot write" << log->fileName() << log->errorString();
+        return false;
+    }
+    auto frames = std::make_unique<QFile>(dir.filePath(QStringLiteral("temperatures.bin")));
+    if (!frames->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "TransientWriter: cannot write" << frames->fileName() << frames->errorString();
+        return false;
+    }
+
+    m_log = std::move(log);
+    m_logStream.setDevice(m_log.get());
+    m_logStream << "step,time_days,step_hours,error_estimate,iterations,min_temperature,max_temperature\n";
+
+    m_frames = std::move(frames);
+    quint32 header[3] = { 0, qToLittleEndian(FormatVersion), qToLittleEndian(quint32(mesh.nodeCount())) };
+    memcpy(header, "DFDT", 4);
+    m_frames->write(reinterpret_cast<const char*>(header), sizeof(header));
+    m_frameCount = 0;
+    return writeFrame(0.0, initialTemperatures);
+}
+
+bool TransientWriter::write(const TransientIntegrator::Step& step, const QVector<double>& temperatures)
+{
+    if (!isOpen()) {
+        return false;
+    }
+    m_logStream << step.index << ',' << step.time / HeatAssembler::SecondsPerDay << ','
+                << step.size / 3600.0 << ',' << step.errorEstimate << ',' << step.iterations << ','
+                << step.minTemperature << ',' << step.maxTemperature << '\n';
+    return !step.output || writeFrame(step.time, temperatures);
+}
+
+bool TransientWriter::writeFrame(double time, const QVector<double>& temperatures)
+{
+    m_buffer.resize(temperatures.size());
+    for (int i = 0; i < temperatures.size(); ++i) {
+        m_buffer[i] = qToLittleEndian(float(temperatures[i]));
+    }
+    const double t = qToLittleEndian(time);
+    const qint64 bytes = qint64(m_buffer.size()) * qint64(sizeof(float));
+    if (m_frames->write(reinterpret_cast<const char*>(&t), sizeof(t)) != qint64(sizeof(t)) ||
+        m_frames->write(reinterpret_cast<const char*>(m_buffer.constData()), bytes) != bytes) {
+        qWarning() << "TransientWriter: write failed" << m_frames->errorString();
+        return false;
+    }
+    ++m_frameCount;
+    return true;
+}
+
+void TransientWriter::close()
+{
+    if (!m_frames) {
+        return;
+    }
+    m_logStream.flush();
+    m_logStream.setDevice(nullptr);
+    m_log.reset();
+    m_frames.reset();
+}
@@ -1,11 +1,15 @@
 #include "ui/MainWindow.h"
 #include "viewport/Viewport3D.h"
+#include "viewport/ViewLayout.h"
+#include "viewport/ViewCuller.h"
+#include "viewport/FrameProfiler.h"
 #include "auth/AuthManager.h"
 #include "ui/PropertiesPanel.h"
 #include "ui/SceneHierarchyPanel.h"
 #include "scene/SelectionManager.h"
 #include "scene/SceneObject.h"
 #include "scene/ObjectManager.h"
+#include "solver/ThermalSolver.h"
 
 #include <QMenuBar>
 #include <QToolBar>
@@ -17,11 +21,13 @@
 #include <QVBoxLayout>
 #include <QMessageBox>
 #include <QFileDialog>
+#include <QActionGroup>
 #include <QLabel>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , m_authManager(std::make_unique<AuthManager>(this))
+    , m_thermalSolver(std::make_unique<ThermalSolver>())
 {
     setWindowTitle("DFD-HEAT - 3D FEM Thermal Analysis");
     resize(1400, 900);
@@ -37,6 +43,10 @@ MainWindow::MainWindow(QWidget *parent)
     createDockWindows();
     createStatusBar();
 
+    // Solver output goes to the console
+    connect(m_thermalSolver.get(), &ThermalSolver::progress, m_consoleOutput, &QTextEdit::append);
+    connect(m_thermalSolver.get(), &ThermalSolver::finished, this, &MainWindow::onSolverFinished);
+
     // Setup authentication
     connect(m_authManager.get(), &AuthManager::authenticationChanged,
             this, &MainWindow::onAuthStatusChanged);
@@ -110,7 +120,51 @@ void MainWindow::createMenus()
     m_viewMenu = menuBar()->addMenu(tr("&View"));
     m_viewMenu->addAction(tr("&Zoom In"));
     m_viewMenu->addAction(tr("&Zoom Out"));
-    m_viewMenu->addAction(tr("&Fit All"));
+    QAction* fitAllAction = m_viewMenu->addAction(tr("&Fit All"));
+    connect(fitAllAction, &QAction::triggered, m_viewport3D, &Viewport3D::frameAll);
+    QAction* fitSelectedAction = m_viewMenu->addAction(tr("Fit &Selected"));
+    connect(fitSelectedAction, &QAction::triggered, m_viewport3D, &Viewport3D::frameSelected);
+    QMenu* layoutMenu = m_viewMenu->addMenu(tr("&Layout"));
+    auto* layoutGroup = new QActionGroup(this);
+    const QPair<QString, ViewLayout::Layout> layouts[] = {
+        { tr("Single View"), ViewLayout::Single },
+        { tr("Side by Side"), ViewLayout::SideBySide },
+        { tr("Stacked"), ViewLayout::Stacked },
+        { tr("Quad View"), ViewLayout::Quad },
+    };
+    for (const auto& entry : layouts) {
+        QAction* action = layoutMenu->addAction(entry.first);
+        action->setCheckable(true);
+        action->setChecked(entry.second == m_viewport3D->viewLayout()->layout());
+        layoutGroup->addAction(action);
+        const ViewLayout::Layout layout = entry.second;
+        connect(action, &QAction::triggered, this, [this, layout]() { m_viewport3D->setViewLayout(layout); });
+        if (layout == ViewLayout::Quad) {
+            action->setShortcut(QKeySequence(tr("Ctrl+Alt+Q")));
+        }
+    }
+    m_viewMenu->addSeparator();
+    QAction* statsAction = m_viewMenu->addAction(tr("Render S&tatistics"));
+    statsAction->setCheckable(true);
+    connect(statsAction, &QAction::toggled, m_viewport3D, &Viewport3D::setStatsOverlayVisible);
+    QAction* traceAction = m_viewMenu->addAction(tr("Record Frame T&race..."));
+    traceAction->setCheckable(true);
+    connect(traceAction, &QAction::toggled, this, [this, traceAction](bool record) {
+        FrameProfiler* profiler = m_viewport3D->frameProfiler();
+        if (!record) {
+            profiler->stopTrace();
+            statusBar()->showMessage(tr("Frame trace stopped"), 2000);
+            return;
+        }
+        const QString path = QFileDialog::getSaveFileName(this, tr("Record Frame Trace"),
+                                                          QString(), tr("CSV Files (*.csv)"));
+        if (path.isEmpty() || !profiler->startTrace(path)) {
+            QSignalBlocker blocker(traceAction);
+            traceAction->setChecked(false);
+            return;
+        }
+        statusBar()->showMessage(tr("Recording frame trace to %1").arg(path), 2000);
+    });
     m_viewMenu->addSeparator();
     m_viewMenu->addAction(tr("&Wireframe"));
     m_viewMenu->addAction(tr("&Shaded"));
@@ -132,8 +186,10 @@ void MainWindow::createMenus()
 
     // Solve menu
     m_solveMenu = menuBar()->addMenu(tr("&Solve"));
-    m_solveMenu->addAction(tr("&Steady State"));
-    m_solveMenu->addAction(tr("&Transient"));
+    QAction* steadyStateAction = m_solveMenu->addAction(tr("&Steady State"));
+    connect(steadyStateAction, &QAction::triggered, this, &MainWindow::solveSteadyState);
+    QAction* transientAction = m_solveMenu->addAction(tr("&Transient..."));
+    connect(transientAction, &QAction::triggered, this, &MainWindow::solveTransient);
     m_solveMenu->addSeparator();
     m_solveMenu->addAction(tr("&Solver Settings..."));
 
@@ -141,7 +197,8 @@ void MainWindow::createMenus()
     m_resultsMenu = menuBar()->addMenu(tr("&Results"));
     m_resultsMenu->addAction(tr("&Temperature Field"));
     m_resultsMenu->addAction(tr("&Heat Flux"));
-    m_resultsMenu->addAction(tr("&Export Results..."));
+    QAction* exportResultsAction = m_resultsMenu->addAction(tr("&Export Results..."));
+    connect(exportResultsAction, &QAction::triggered, this, &MainWindow::exportResults);
 
     // Help menu
     m_helpMenu = menuBar()->addMenu(tr("&Help"));
@@ -213,6 +270,7 @@ void MainWindow::createDockWindows()
     auto concrete = new QTreeWidgetItem(m_materialsTree, QStringList() << "Concrete (λ=1.7 W/mK)");
     auto brick = new QTreeWidgetItem(m_materialsTree, QStringList() << "Brick (λ=0.8 W/mK)");
     auto insulation = new QTreeWidgetItem(m_materialsTree, QStringList() << "Insulation (λ=0.04 W/mK)");
+    auto soil = new QTreeWidgetItem(m_materialsTree, QStringList() << "Soil (λ=2.0 W/mK)");
 
     m_materialsDock->setWidget(m_materialsTree);
     addDockWidget(Qt::RightDockWidgetArea, m_materialsDock);
@@ -249,6 +307,19 @@ void MainWindow::createStatusBar()
 
     auto coordLabel = new QLabel(tr("X: 0.00 Y: 0.00 Z: 0.00"));
     statusBar()->addPermanentWidget(coordLabel);
+
+    // Culling/LOD readout of the last view update
+    auto renderStatsLabel = new QLabel();
+    statusBar()->addPermanentWidget(renderStatsLabel);
+    connect(m_viewport3D->viewCuller(), &ViewCuller::statsChanged,
+            renderStatsLabel, [renderStatsLabel](const ViewCuller::Stats& stats) {
+        renderStatsLabel->setText(tr("Objects: %1 drawn, %2 culled | Tris: %3 (%4 full detail), %5 culled")
+            .arg(stats.drawnObjects)
+            .arg(stats.culledObjects)
+            .arg(stats.drawnTriangles)
+            .arg(stats.fullDetailTriangles)
+            .arg(stats.culledTriangles));
+    });
 }
 
 void MainWindow::newProject()
@@ -319,4 +390,78 @@ void MainWindow::onAuthStatusChanged(bool authenticated)
         m_consoleOutput->append("Logged out");
         statusBar()->showMessage(tr("Logged out"), 2000);
     }
-}
\ No newline at end of file
+}
+
+void MainWindow::solveSteadyState()
+{
+    if (m_thermalSolver->isRunning()) {
+        statusBar()->showMessage(tr("A solve is already running"), 2000);
+        return;
+    }
+    if (!m_thermalSolver->solveSteadyState(*m_viewport3D->objectManager(), ThermalSolver::defaultSettings())) {
+        QMessageBox::warning(this, tr("Steady State"), tr("The scene contains no solid objects to solve."));
+        return;
+    }
+    m_consoleOutput->append("Solving steady-state heat conduction...");
+    statusBar()->showMessage(tr("Solving..."));
+}
+
+void MainWindow::solveTransient()
+{
+    if (m_thermalSolver->isRunning()) {
+        statusBar()->showMessage(tr("A solve is already running"), 2000);
+        return;
+    }
+    const QString directory = QFileDialog::getExistingDirectory(this, tr("Transient Results Folder"));
+    if (directory.isEmpty()) {
+        return;
+    }
+    if (!m_thermalSolver->solveTransient(*m_viewport3D->objectManager(), ThermalSolver::defaultTransientSettings(),
+                                         directory)) {
+        QMessageBox::warning(this, tr("Transient"), tr("The scene contains no solid objects to solve."));
+        return;
+    }
+    m_consoleOutput->append(QString("Simulating transient heat conduction into %1...").arg(directory));
+    statusBar()->showMessage(tr("Solving..."));
+}
+
+void MainWindow::onSolverFinished(bool ok)
+{
+    const std::shared_ptr<const ThermalSolver::Result> result = m_thermalSolver->lastResult();
+    if (!ok) {
+        m_consoleOutput->append(QString("Solve failed: %1").arg(result->error));
+        statusBar()->showMessage(tr("Solve failed"), 2000);
+        return;
+    }
+    m_consoleOutput->append(QString("Temperatures %1 .. %2 °C over %3 nodes (total %4 s)")
+        .arg(result->minTemperature, 0, 'f', 2)
+        .arg(result->maxTemperature, 0, 'f', 2)
+        .arg(result->mesh.nodeCount())
+        .arg(result->meshSeconds + result->assemblySeconds + result->preconditionerSeconds
+             + result->solveSeconds + result->transientSeconds, 0, 'f', 2));
+    if (result->transient.completed) {
+        m_consoleOutput->append(QString("%1 time steps, %2 frames written").arg(result->transient.steps)
+                                    .arg(result->frameCount));
+    }
+    statusBar()->showMessage(tr("Solve finished"), 2000);
+}
+
+void MainWindow::exportResults()
+{
+    const std::shared_ptr<const ThermalSolver::Result> result = m_thermalSolver->lastResult();
+    if (!result || !result->ok) {
+        QMessageBox::information(this, tr("Export Results"), tr("There are no results to export yet."));
+        return;
+    }
+    const QString fileName = QFileDialog::getSaveFileName(this,
+        tr("Export Results"), "", tr("CSV Files (*.csv)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+    if (ThermalSolver::writeNodeCsv(*result, fileName)) {
+        m_consoleOutput->append(QString("Results exported: %1").arg(fileName));
+        statusBar()->showMessage(tr("Results exported"), 2000);
+    } else {
+        QMessageBox::warning(this, tr("Export Results"), tr("Cannot write %1").arg(fileName));
+    }
+}
@@ -43,6 +43,16 @@ void PropertiesPanel::setupUI()
     m_lockedCheck = new QCheckBox("Locked");
     objLayout->addWidget(m_lockedCheck, 2, 1);
 
+    // Largest solver element edge inside the object; 0 follows the global size
+    objLayout->addWidget(new QLabel("Mesh size:"), 3, 0);
+    m_meshSize = new QDoubleSpinBox();
+    m_meshSize->setRange(0.0, 100.0);
+    m_meshSize->setDecimals(3);
+    m_meshSize->setSingleStep(0.05);
+    m_meshSize->setSuffix(" m");
+    m_meshSize->setSpecialValueText("Auto");
+    objLayout->addWidget(m_meshSize, 3, 1);
+
     mainLayout->addWidget(objGroup);
 
     // Transform Properties Group
@@ -139,6 +149,7 @@ void PropertiesPanel::setupUI()
 
     connect(m_visibleCheck, &QCheckBox::stateChanged, this, &PropertiesPanel::onVisibleChanged);
     connect(m_lockedCheck, &QCheckBox::stateChanged, this, &PropertiesPanel::onLockedChanged);
+    connect(m_meshSize, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &PropertiesPanel::onMeshSizeChanged);
 
     // Disable by default (no object selected)
     setEnabled(false);
@@ -182,6 +193,7 @@ void PropertiesPanel::updateFromObject()
     m_uuidLabel->setText(m_currentObject->uuid().toString());
     m_visibleCheck->setChecked(m_currentObject->isVisible());
     m_lockedCheck->setChecked(m_currentObject->isLocked());
+    m_meshSize->setValue(m_currentObject->meshSize());
 
     // Location
     QVector3D loc = m_currentObject->location();
@@ -227,6 +239,7 @@ void PropertiesPanel::blockSignalsTemporarily(bool block)
     m_dimensionsZ->blockSignals(block);
     m_visibleCheck->blockSignals(block);
     m_lockedCheck->blockSignals(block);
+    m_meshSize->blockSignals(block);
 }
 
 void PropertiesPanel::onNameChanged()
@@ -282,6 +295,13 @@ void PropertiesPanel::onLockedChanged(int state)
     }
 }
 
+void PropertiesPanel::onMeshSizeChanged(double size)
+{
+    if (m_currentObject) {
+        m_currentObject->setMeshSize(size);
+    }
+}
+
 void PropertiesPanel::onObjectTransformChanged()
 {
     updateFromObject();
@@ -14,6 +14,8 @@
 #include <QMouseEvent>
 #include <QMimeData>
 #include <QDataStream>
+#include <QSet>
+#include <QPair>
 #include <QDebug>
 
 // Custom item roles for storing pointers
@@ -35,9 +37,468 @@ constexpr const char* SCENE_HIERARCHY_MIME = "application/x-dfd-scene-hierarchy"
 // SceneHierarchyModel Implementation
 //==============================================================================
 
+// Objects exposed per fetchMore() call
+constexpr int FetchBatchSize = 1000;
+
+// Above this many separate row ranges, a removal resets the collection's rows
+constexpr int MaxRemovedRanges = 32;
+
 SceneHierarchyModel::SceneHierarchyModel(QObject* parent)
-    : QStandardItemModel(parent)
+    : QAbstractItemModel(parent)
+    , m_root(nullptr)
+{
+}
+
+void SceneHierarchyModel::setRootCollection(Collection* root)
+{
+    beginResetModel();
+    m_root = root;
+    m_fetched.clear();
+    m_objectCollection.clear();
+    m_objectSlots.clear();
+
+    // Remember which collection holds each object
+    QVector<Collection*> pending;
+    if (m_root) {
+        pending.append(m_root);
+    }
+    while (!pending.isEmpty()) {
+        Collection* collection = pending.takeLast();
+        for (SceneObject* object : collection->objects()) {
+            m_objectCollection.insert(object, collection);
+        }
+        pending += collection->childCollections();
+    }
+    endResetModel();
+}
+
+Collection* SceneHierarchyModel::collectionAt(const QModelIndex& index) const
+{
+    if (!index.isValid()) {
+        return nullptr;
+    }
+
+    Collection* parentCollection = static_cast<Collection*>(index.internalPointer());
+    if (!parentCollection) {
+        return m_root;
+    }
+
+    const QVector<Collection*>& children = parentCollection->childCollections();
+    return index.row() < children.size() ? children[index.row()] : nullptr;
+}
+
+SceneObject* SceneHierarchyModel::objectAt(const QModelIndex& index) const
+{
+    if (!index.isValid()) {
+        return nullptr;
+    }
+
+    Collection* parentCollection = static_cast<Collection*>(index.internalPointer());
+    if (!parentCollection) {
+        return nullptr;
+    }
+
+    int slot = index.row() - parentCollection->childCollections().size();
+    if (slot < 0 || slot >= fetchedObjects(parentCollection)) {
+        return nullptr;
+    }
+    return parentCollection->objects()[slot];
+}
+
+QModelIndex SceneHierarchyModel::indexOfCollection(Collection* collection, int column) const
+{
+    if (!collection) {
+        return QModelIndex();
+    }
+    if (collection == m_root) {
+        return createIndex(0, column, nullptr);
+    }
+
+    Collection* parentCollection = collection->parentCollection();
+    if (!parentCollection) {
+        return QModelIndex();
+    }
+    int row = parentCollection->childCollections().indexOf(collection);
+    return row == -1 ? QModelIndex() : createIndex(row, column, parentCollection);
+}
+
+QModelIndex SceneHierarchyModel::indexOfObject(SceneObject* object, int column) const
+{
+    Collection* collection = m_objectCollection.value(object);
+    if (!collection) {
+        return QModelIndex();
+    }
+
+    int row = objectRow(collection, object);
+    return row == -1 ? QModelIndex() : createIndex(row, column, collection);
+}
+
+int SceneHierarchyModel::objectSlot(Collection* collection, SceneObject* object) const
+{
+    // Built on the first lookup after the collection's objects changed
+    auto it = m_objectSlots.find(collection);
+    if (it == m_objectSlots.end()) {
+        QHash<SceneObject*, int> slotOfObject;
+        const QVector<SceneObject*>& objects = collection->objects();
+        slotOfObject.reserve(objects.size());
+        for (int slot = 0; slot < objects.size(); ++slot) {
+            slotOfObject.insert(objects[slot], slot);
+        }
+        it = m_objectSlots.insert(collection, slotOfObject);
+    }
+    return it->value(object, -1);
+}
+
+int SceneHierarchyModel::objectRow(Collection* collection, SceneObject* object) const
+{
+    int slot = objectSlot(collection, object);
+    if (slot == -1 || slot >= fetchedObjects(collection)) {
+        return -1;  // Not exposed yet
+    }
+    return collection->childCollections().size() + slot;
+}
+
+void SceneHierarchyModel::addObjects(Collection* collection, const QVector<SceneObject*>& objects)
+{
+    if (!collection) {
+        return;
+    }
+
+    QVector<SceneObject*> added;
+    added.reserve(objects.size());
+    for (SceneObject* object : objects) {
+        if (object && !m_objectCollection.contains(object)) {
+            added.append(object);
+        }
+    }
+    if (added.isEmpty()) {
+        return;
+    }
+
+    // Appended objects become rows only if everything before them is
+    // already exposed; otherwise fetchMore() reaches them later
+    const int fetched = fetchedObjects(collection);
+    const int exposed = fetched == collection->objectCount() ? qMin<int>(added.size(), FetchBatchSize) : 0;
+    const int first = collection->childCollections().size() + fetched;
+
+    if (exposed > 0) {
+        beginInsertRows(indexOfCollection(collection), first, first + exposed - 1);
+    }
+    // Appending keeps existing slots valid
+    auto cachedSlots = m_objectSlots.find(collection);
+    for (SceneObject* object : added) {
+        collection->addObject(object);
+        m_objectCollection.insert(object, collection);
+        if (cachedSlots != m_objectSlots.end()) {
+            cachedSlots->insert(object, collection->objectCount() - 1);
+        }
+    }
+    if (exposed > 0) {
+        m_fetched[collection] = fetched + exposed;
+        endInsertRows();
+    }
+}
+
+void SceneHierarchyModel::removeObjects(const QVector<SceneObject*>& objects)
+{
+    // Group by collection so each collection is walked once
+    QHash<Collection*, QSet<SceneObject*>> byCollection;
+    for (SceneObject* object : objects) {
+        Collection* collection = m_objectCollection.take(object);
+        if (collection) {
+            byCollection[collection].insert(object);
+        }
+    }
+
+    for (auto it = byCollection.cbegin(); it != byCollection.cend(); ++it) {
+        Collection* collection = it.key();
+        const QSet<SceneObject*>& removed = it.value();
+        const QModelIndex parentIndex = indexOfCollection(collection);
+        const int childCount = collection->childCollections().size();
+        const int fetched = fetchedObjects(collection);
+
+        // Exposed rows being removed, as [first, last] slot ranges
+        QVector<QPair<int, int>> ranges;
+        int removedRows = 0;
+        for (int slot = 0; slot < fetched; ++slot) {
+            if (!removed.contains(collection->objects()[slot])) continue;
+            if (!ranges.isEmpty() && ranges.last().second == slot - 1) {
+                ranges.last().second = slot;
+            } else {
+                ranges.append({slot, slot});
+            }
+            ++removedRows;
+        }
+
+        if (ranges.size() > MaxRemovedRanges) {
+            // Scattered removal: drop all object rows, then expose one batch again
+            beginRemoveRows(parentIndex, childCount, childCount + fetched - 1);
+            collection->removeObjects(removed.values());
+            m_objectSlots.remove(collection);
+            m_fetched[collection] = 0;
+            endRemoveRows();
+
+            const int exposed = qMin(collection->objectCount(), fetched - removedRows);
+            if (exposed > 0) {
+                beginInsertRows(parentIndex, childCount, childCount + exposed - 1);
+                m_fetched[collection] = exposed;
+                endInsertRows();
+            }
+            continue;
+        }
+
+        // Few ranges (typical selection): remove them back to front
+        for (int i = ranges.size() - 1; i >= 0; --i) {
+            const int first = ranges[i].first;
+            const int last = ranges[i].second;
+            beginRemoveRows(parentIndex, childCount + first, childCount + last);
+            collection->removeObjects(collection->objects().mid(first, last - first + 1));
+            m_objectSlots.remove(collection);
+            m_fetched[collection] -= last - first + 1;
+            endRemoveRows();
+        }
+
+        // Objects that were never exposed as rows
+        collection->removeObjects(removed.values());
+        m_objectSlots.remove(collection);
+    }
+}
+
+void SceneHierarchyModel::moveObject(SceneObject* object, Collection* target)
+{
+    Collection* source = m_objectCollection.value(object);
+    if (!target || source == target) {
+        return;
+    }
+
+    if (source) {
+        removeObjects({object});
+    }
+    addObjects(target, {object});
+}
+
+void SceneHierarchyModel::addCollection(Collection* collection, Collection* parent)
+{
+    if (!collection || !parent) {
+        return;
+    }
+
+    const int row = parent->childCollections().size();
+    beginInsertRows(indexOfCollection(parent), row, row);
+    parent->addChildCollection(collection);
+    for (SceneObject* object : collection->objects()) {
+        m_objectCollection.insert(object, collection);
+    }
+    endInsertRows();
+}
+
+void SceneHierarchyModel::removeCollection(Collection* collection)
+{
+    Collection* parentCollection = collection ? collection->parentCollection() : nullptr;
+    if (!parentCollection) {
+        return;
+    }
+
+    const int row = parentCollection->childCollections().indexOf(collection);
+    beginRemoveRows(indexOfCollection(parentCollection), row, row);
+    parentCollection->removeChildCollection(collection);
+    forgetCollection(collection);
+    endRemoveRows();
+}
+
+void SceneHierarchyModel::moveCollection(Collection* collection, Collection* target)
+{
+    Collection* source = collection ? collection->parentCollection() : nullptr;
+    if (!source || !target || source == target) {
+        return;
+    }
+
+    const int sourceRow = source->childCollections().indexOf(collection);
+    const int targetRow = target->childCollections().size();
+
+    // Child collections sit before objects, so this is a plain row move
+    if (beginMoveRows(indexOfCollection(source), sourceRow, sourceRow, indexOfCollection(target), targetRow)) {
+        source->removeChildCollection(collection);
+        target->addChildCollection(collection);
+        endMoveRows();
+    }
+}
+
+void SceneHierarchyModel::forgetCollection(Collection* collection)
+{
+    m_fetched.remove(collection);
+    m_objectSlots.remove(collection);
+    for (SceneObject* object : collection->objects()) {
+        m_objectCollection.remove(object);
+    }
+    for (Collection* child : collection->childCollections()) {
+        forgetCollection(child);
+    }
+}
+
+void SceneHierarchyModel::notifyObjectChanged(SceneObject* object)
+{
+    QModelIndex nameIndex = indexOfObject(object, 0);
+    if (nameIndex.isValid()) {
+        emit dataChanged(nameIndex, nameIndex.siblingAtColumn(1));
+    }
+}
+
+void SceneHierarchyModel::notifyVisibilityChanged(Collection* collection)
+{
+    QModelIndex visIndex = indexOfCollection(collection, 1);
+    if (visIndex.isValid()) {
+        emit dataChanged(visIndex, visIndex, {VisibilityRole});
+        notifyVisibilityRecursive(collection);
+    }
+}
+
+void SceneHierarchyModel::notifyVisibilityRecursive(Collection* collection)
+{
+    const QModelIndex parentIndex = indexOfCollection(collection);
+    const int rows = rowCount(parentIndex);
+    if (rows > 0) {
+        emit dataChanged(index(0, 1, parentIndex), index(rows - 1, 1, parentIndex), {VisibilityRole});
+    }
+    for (Collection* child : collection->childCollections()) {
+        notifyVisibilityRecursive(child);
+    }
+}
+
+QModelIndex SceneHierarchyModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (!hasIndex(row, column, parent)) {
+        return QModelIndex();
+    }
+
+    // Internal pointer = parent collection (nullptr for the scene collection)
+    return createIndex(row, column, parent.isValid() ? collectionAt(parent) : nullptr);
+}
+
+QModelIndex SceneHierarchyModel::parent(const QModelIndex& index) const
+{
+    if (!index.isValid()) {
+        return QModelIndex();
+    }
+    return indexOfCollection(static_cast<Collection*>(index.internalPointer()));
+}
+
+int SceneHierarchyModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.column() > 0) {
+        return 0;
+    }
+    if (!parent.isValid()) {
+        return m_root ? 1 : 0;
+    }
+
+    Collection* collection = collectionAt(parent);
+    return collection ? collection->childCollections().size() + fetchedObjects(collection) : 0;
+}
+
+int SceneHierarchyModel::columnCount(const QModelIndex& parent) const
 {
+    Q_UNUSED(parent);
+    return 2;  // Name, Visibility
+}
+
+bool SceneHierarchyModel::hasChildren(const QModelIndex& parent) const
+{
+    if (!parent.isValid()) {
+        return m_root != nullptr;
+    }
+    if (parent.column() > 0) {
+        return false;
+    }
+
+    // Report unfetched objects too so collections can be expanded
+    Collection* collection = collectionAt(parent);
+    return collection && (!collection->childCollections().isEmpty() || collection->objectCount() > 0);
+}
+
+bool SceneHierarchyModel::canFetchMore(const QModelIndex& parent) const
+{
+    Collection* collection = collectionAt(parent);
+    return collection && fetchedObjects(collection) < collection->objectCount();
+}
+
+void SceneHierarchyModel::fetchMore(const QModelIndex& parent)
+{
+    Collection* collection = collectionAt(parent);
+    if (!collection) {
+        return;
+    }
+
+    const int fetched = fetchedObjects(collection);
+    const int count = qMin(collection->objectCount() - fetched, FetchBatchSize);
+    if (count <= 0) {
+        return;
+    }
+
+    const int first = collection->childCollections().size() + fetched;
+    beginInsertRows(parent, first, first + count - 1);
+    m_fetched[collection] = fetched + count;
+    endInsertRows();
+}
+
+QVariant SceneHierarchyModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid()) {
+        return QVariant();
+    }
+
+    if (Collection* collection = collectionAt(index)) {
+        if (index.column() == 1) {
+            return role == VisibilityRole ? QVariant(collection->isVisible()) : QVariant();
+        }
+        switch (role) {
+        case Qt::DisplayRole: return collection->name();
+        case CollectionRole:  return QVariant::fromValue((void*)collection);
+        case ItemTypeRole:    return int(CollectionItem);
+        case UuidRole:        return collection->uuid().toString();  // For drag & drop
+        default:              return QVariant();
+        }
+    }
+
+    if (SceneObject* object = objectAt(index)) {
+        if (index.column() == 1) {
+            return role == VisibilityRole ? QVariant(object->isVisible()) : QVariant();
+        }
+        switch (role) {
+        case Qt::DisplayRole: return object->name();
+        case ObjectRole:      return QVariant::fromValue((void*)object);
+        case ItemTypeRole:    return int(ObjectItem);
+        case UuidRole:        return object->uuid().toString();  // For drag & drop
+        default:              return QVariant();
+        }
+    }
+
+    return QVariant();
+}
+
+QVariant SceneHierarchyModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    return section == 0 ? QStringLiteral("Name") : QStringLiteral("Visibility");
+}
+
+Qt::ItemFlags SceneHierarchyModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid()) {
+        return Qt::NoItemFlags;
+    }
+
+    Qt::ItemFlags result = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+    Collection* collection = collectionAt(index);
+    if (collection) {
+        result |= Qt::ItemIsDropEnabled;
+    }
+    if (collection != m_root) {
+        result |= Qt::ItemIsDragEnabled;  // The scene collection stays put
+    }
+    return result;
 }
 
 QStringList SceneHierarchyModel::mimeTypes() const
@@ -61,27 +522,17 @@ QMimeData* SceneHierarchyModel::mimeData(const QModelIndexList& indexes) const
         index = index.sibling(index.row(), 0);
     }
 
-    QStandardItem* item = itemFromIndex(index);
-    if (!item) {
-        return mimeData;
-    }
-
     // Store item type and UUID
-    ItemType type = static_cast<ItemType>(item->data(ItemTypeRole).toInt());
-    QString uuid = item->data(UuidRole).toString();
+    int type = index.data(ItemTypeRole).toInt();
+    QString uuid = index.data(UuidRole).toString();
 
-    stream << static_cast<int>(type);
+    stream << type;
     stream << uuid;
 
     // Store parent path (for reconstructing tree position)
     QStringList parentPath;
-    QModelIndex parentIndex = index.parent();
-    while (parentIndex.isValid()) {
-        QStandardItem* parentItem = itemFromIndex(parentIndex);
-        if (parentItem) {
-            parentPath.prepend(parentItem->data(UuidRole).toString());
-        }
-        parentIndex = parentIndex.parent();
+    for (QModelIndex parentIndex = index.parent(); parentIndex.isValid(); parentIndex = parentIndex.parent()) {
+        parentPath.prepend(parentIndex.data(UuidRole).toString());
     }
     stream << parentPath;
 
@@ -120,20 +571,14 @@ bool SceneHierarchyModel::dropMimeData(const QMimeData* data, Qt::DropAction act
         return false;
     }
 
-    // Get target collection UUID from parent item
-    QStandardItem* parentItem = itemFromIndex(parent);
-    if (!parentItem) {
-        return false;
-    }
-
     // Only allow drops onto collections
-    ItemType parentType = static_cast<ItemType>(parentItem->data(ItemTypeRole).toInt());
-    if (parentType != CollectionItem) {
+    Collection* targetCollection = collectionAt(parent.sibling(parent.row(), 0));
+    if (!targetCollection) {
         qDebug() << "[SceneHierarchyModel] Can only drop onto collections";
         return false;
     }
 
-    QString targetCollectionUuid = parentItem->data(UuidRole).toString();
+    QString targetCollectionUuid = targetCollection->uuid().toString();
 
     qDebug() << "[SceneHierarchyModel] Drop:" << (type == ObjectItem ? "Object" : "Collection")
              << "UUID:" << uuid << "to collection:" << targetCollectionUuid;
@@ -142,7 +587,7 @@ bool SceneHierarchyModel::dropMimeData(const QMimeData* data, Qt::DropAction act
     emit itemDropped(uuid, targetCollectionUuid, typeInt);
 
     // Return false so Qt doesn't modify the tree
-    // The panel will rebuild the tree after reassigning collections
+    // The panel moves the rows through the model after reassigning collections
     return false;
 }
 
@@ -151,6 +596,7 @@ Qt::DropActions SceneHierarchyModel::supportedDropActions() const
     return Qt::MoveAction;
 }
 
+
 //==============================================================================
 // VisibilityDelegate Implementation
 //==============================================================================
@@ -271,10 +717,10 @@ void SceneHierarchyPanel::setupUI()
     m_treeView->setDragDropMode(QAbstractItemView::InternalMove);
     m_treeView->setSelectionMode(QAbstractItemView::SingleSelection);
     m_treeView->setExpandsOnDoubleClick(false);
+    m_treeView->setUniformRowHeights(true);  // Constant-time layout for large scenes
 
     // Model
     m_model = new SceneHierarchyModel(this);
-    m_model->setHorizontalHeaderLabels({"Name", "Visibility"});
     m_treeView->setModel(m_model);
 
     // Delegate for visibility column
@@ -305,78 +751,29 @@ void SceneHierarchyPanel::setupConnections()
 
     // ObjectManager signals
     if (m_objectManager) {
-        connect(m_objectManager, &ObjectManager::objectAdded, this, &SceneHierarchyPanel::onObjectAdded);
-        connect(m_objectManager, &ObjectManager::objectRemoved, this, &SceneHierarchyPanel::onObjectRemoved);
+        connect(m_objectManager, &ObjectManager::objectsAdded, this, &SceneHierarchyPanel::onObjectsAdded);
+        connect(m_objectManager, &ObjectManager::objectsRemoved, this, &SceneHierarchyPanel::onObjectsRemoved);
     }
 }
 
 void SceneHierarchyPanel::rebuildTree()
 {
-    m_model->removeRows(0, m_model->rowCount());
-
-    if (m_sceneCollection) {
-        addCollectionToTree(m_sceneCollection, m_model->invisibleRootItem());
-    }
-
-    m_treeView->expandAll();
-}
-
-void SceneHierarchyPanel::addCollectionToTree(Collection* collection, QStandardItem* parentItem)
-{
-    if (!collection) return;
-
-    // Create collection item
-    QStandardItem* nameItem = new QStandardItem(collection->name());
-    nameItem->setData(QVariant::fromValue((void*)collection), CollectionRole);
-    nameItem->setData(CollectionItem, ItemTypeRole);
-    nameItem->setData(collection->uuid().toString(), UuidRole);  // Store UUID for drag & drop
-    nameItem->setEditable(false);
-
-    QStandardItem* visItem = new QStandardItem();
-    visItem->setData(collection->isVisible(), VisibilityRole);
-    visItem->setEditable(false);
-
-    parentItem->appendRow({nameItem, visItem});
-
-    // Add child collections
-    for (Collection* child : collection->childCollections()) {
-        addCollectionToTree(child, nameItem);
-    }
-
-    // Add objects
-    for (SceneObject* obj : collection->objects()) {
-        addObjectToTree(obj, nameItem);
-    }
-}
-
-void SceneHierarchyPanel::addObjectToTree(SceneObject* object, QStandardItem* parentItem)
-{
-    if (!object) return;
-
-    QStandardItem* nameItem = new QStandardItem(object->name());
-    nameItem->setData(QVariant::fromValue((void*)object), ObjectRole);
-    nameItem->setData(ObjectItem, ItemTypeRole);
-    nameItem->setData(object->uuid().toString(), UuidRole);  // Store UUID for drag & drop
-    nameItem->setEditable(false);
+    m_model->setRootCollection(m_sceneCollection);
 
-    QStandardItem* visItem = new QStandardItem();
-    visItem->setData(object->isVisible(), VisibilityRole);
-    visItem->setEditable(false);
-
-    parentItem->appendRow({nameItem, visItem});
+    // Only the scene collection; deeper levels expand (and fetch) on demand
+    m_treeView->expand(m_model->indexOfCollection(m_sceneCollection));
 }
 
 Collection* SceneHierarchyPanel::createCollection(const QString& name, Collection* parent)
 {
     Collection* collection = new Collection(name, this);
 
-    if (parent) {
-        parent->addChildCollection(collection);
-    } else {
-        m_sceneCollection->addChildCollection(collection);
+    if (!parent) {
+        parent = m_sceneCollection;
     }
+    m_model->addCollection(collection, parent);
+    m_treeView->expand(m_model->indexOfCollection(parent));
 
-    rebuildTree();
     emit collectionCreated(collection);
 
     return collection;
@@ -390,12 +787,8 @@ void SceneHierarchyPanel::deleteCollection(Collection* collection)
 
     // TODO: Handle objects in deleted collection
 
-    if (collection->parentCollection()) {
-        collection->parentCollection()->removeChildCollection(collection);
-    }
-
+    m_model->removeCollection(collection);
     collection->deleteLater();
-    rebuildTree();
 
     emit collectionDeleted(collection);
 }
@@ -404,17 +797,10 @@ void SceneHierarchyPanel::onItemClicked(const QModelIndex& index)
 {
     if (!index.isValid() || index.column() != 0) return;
 
-    QStandardItem* item = m_model->itemFromIndex(index);
-    if (!item) return;
-
-    ItemType type = static_cast<ItemType>(item->data(ItemTypeRole).toInt());
-
-    if (type == ObjectItem) {
-        SceneObject* object = static_cast<SceneObject*>(item->data(ObjectRole).value<void*>());
-        if (object && m_selectionManager) {
-            m_selectionManager->selectObject(object, false);
-            emit objectSelected(object);
-        }
+    SceneObject* object = m_model->objectAt(index);
+    if (object && m_selectionManager) {
+        m_selectionManager->selectObject(object, false);
+        emit objectSelected(object);
     }
 }
 
@@ -422,12 +808,8 @@ void SceneHierarchyPanel::onItemDoubleClicked(const QModelIndex& index)
 {
     if (!index.isValid() || index.column() != 0) return;
 
-    QStandardItem* item = m_model->itemFromIndex(index);
-    if (!item) return;
-
     // Toggle expand/collapse for collections
-    ItemType type = static_cast<ItemType>(item->data(ItemTypeRole).toInt());
-    if (type == CollectionItem) {
+    if (m_model->collectionAt(index)) {
         m_treeView->setExpanded(index, !m_treeView->isExpanded(index));
     }
 }
@@ -439,29 +821,27 @@ void SceneHierarchyPanel::onCustomContextMenu(const QPoint& pos)
     QMenu menu(this);
 
     if (index.isValid()) {
-        QStandardItem* item = m_model->itemFromIndex(index);
-        ItemType type = static_cast<ItemType>(item->data(ItemTypeRole).toInt());
+        index = index.siblingAtColumn(0);
+        Collection* collection = m_model->collectionAt(index);
+        SceneObject* object = m_model->objectAt(index);
 
-        if (type == CollectionItem) {
-            menu.addAction("New Collection", [this, item]() {
-                Collection* parent = static_cast<Collection*>(item->data(CollectionRole).value<void*>());
+        if (collection) {
+            menu.addAction("New Collection", [this, collection]() {
                 QString name = QInputDialog::getText(this, "New Collection", "Collection name:");
                 if (!name.isEmpty()) {
-                    createCollection(name, parent);
+                    createCollection(name, collection);
                 }
             });
 
             // Don't allow deleting scene collection
-            Collection* collection = static_cast<Collection*>(item->data(CollectionRole).value<void*>());
             if (collection != m_sceneCollection) {
                 menu.addAction("Delete Collection", [this, collection]() {
                     deleteCollection(collection);
                 });
             }
-        } else if (type == ObjectItem) {
-            menu.addAction("Delete Object", [this, item]() {
-                SceneObject* object = static_cast<SceneObject*>(item->data(ObjectRole).value<void*>());
-                if (object && m_objectManager) {
+        } else if (object) {
+            menu.addAction("Delete Object", [this, object]() {
+                if (m_objectManager) {
                     m_objectManager->removeObject(object);
                 }
             });
@@ -483,55 +863,30 @@ void SceneHierarchyPanel::onVisibilityToggled(const QModelIndex& index)
 {
     if (!index.isValid()) return;
 
-    // Get the clicked item (visibility column, column 1)
-    QStandardItem* visItem = m_model->itemFromIndex(index);
-    if (!visItem) return;
-
-    // Get the corresponding name item (column 0)
-    QModelIndex nameIndex = index.sibling(index.row(), 0);
-    QStandardItem* nameItem = m_model->itemFromIndex(nameIndex);
-    if (!nameItem) return;
-
-    bool currentVisibility = visItem->data(VisibilityRole).toBool();
-    bool newVisibility = !currentVisibility;
-
-    ItemType type = static_cast<ItemType>(nameItem->data(ItemTypeRole).toInt());
+    // Resolve through the name column (column 0)
+    QModelIndex nameIndex = index.siblingAtColumn(0);
+    bool newVisibility = !index.data(VisibilityRole).toBool();
 
-    if (type == ObjectItem) {
-        SceneObject* object = static_cast<SceneObject*>(nameItem->data(ObjectRole).value<void*>());
-        if (object) {
-            object->setVisible(newVisibility);
-            visItem->setData(newVisibility, VisibilityRole);
-            qDebug() << "[SceneHierarchyPanel] Toggled object visibility:" << object->name() << "to" << newVisibility;
-        }
-    } else if (type == CollectionItem) {
-        Collection* collection = static_cast<Collection*>(nameItem->data(CollectionRole).value<void*>());
-        if (collection) {
-            collection->setVisible(newVisibility);
-            qDebug() << "[SceneHierarchyPanel] Toggled collection visibility:" << collection->name() << "to" << newVisibility;
-            // Rebuild tree to update all child visibilities
-            rebuildTree();
-        }
+    if (SceneObject* object = m_model->objectAt(nameIndex)) {
+        object->setVisible(newVisibility);
+        m_model->notifyObjectChanged(object);
+        qDebug() << "[SceneHierarchyPanel] Toggled object visibility:" << object->name() << "to" << newVisibility;
+    } else if (Collection* collection = m_model->collectionAt(nameIndex)) {
+        collection->setVisible(newVisibility);
+        m_model->notifyVisibilityChanged(collection);
+        qDebug() << "[SceneHierarchyPanel] Toggled collection visibility:" << collection->name() << "to" << newVisibility;
     }
-
-    m_treeView->viewport()->update();
 }
 
-void SceneHierarchyPanel::onObjectAdded(SceneObject* object)
+void SceneHierarchyPanel::onObjectsAdded(const QVector<SceneObject*>& objects)
 {
-    if (object) {
-        // Add to scene collection by default
-        m_sceneCollection->addObject(object);
-        rebuildTree();
-    }
+    // Add to scene collection by default
+    m_model->addObjects(m_sceneCollection, objects);
 }
 
-void SceneHierarchyPanel::onObjectRemoved(SceneObject* object)
+void SceneHierarchyPanel::onObjectsRemoved(const QVector<SceneObject*>& objects)
 {
-    if (object) {
-        m_sceneCollection->removeObject(object);
-        rebuildTree();
-    }
+    m_model->removeObjects(objects);
 }
 
 void SceneHierarchyPanel::onItemDropped(const QString& itemUuid, const QString& targetCollectionUuid, int itemType)
@@ -546,18 +901,14 @@ void SceneHierarchyPanel::onItemDropped(const QString& itemUuid, const QString&
     }
 
     if (itemType == ObjectItem) {
-        // Moving an object
+        // Moving an object (objects live in exactly one collection)
         SceneObject* object = findObjectByUuid(itemUuid);
         if (!object) {
             qDebug() << "[SceneHierarchyPanel] Object not found!";
             return;
         }
 
-        // Remove from all collections
-        removeObjectFromAllCollections(object, m_sceneCollection);
-
-        // Add to target collection
-        targetCollection->addObject(object);
+        m_model->moveObject(object, targetCollection);
 
         qDebug() << "[SceneHierarchyPanel] Moved object" << object->name() << "to collection" << targetCollection->name();
 
@@ -575,20 +926,13 @@ void SceneHierarchyPanel::onItemDropped(const QString& itemUuid, const QString&
             return;
         }
 
-        // Remove from current parent
-        if (collection->parentCollection()) {
-            collection->parentCollection()->removeChildCollection(collection);
-        }
-
-        // Add to target collection
-        targetCollection->addChildCollection(collection);
+        m_model->moveCollection(collection, targetCollection);
 
         qDebug() << "[SceneHierarchyPanel] Moved collection" << collection->name() << "to collection" << targetCollection->name();
     }
 
-    // Rebuild tree to show new structure
-    rebuildTree();
-    m_treeView->expandAll();
+    // Show the dropped item in its new place
+    m_treeView->expand(m_model->indexOfCollection(targetCollection));
 }
 
 Collection* SceneHierarchyPanel::findCollectionByUuid(const QString& uuidStr, Collection* root)
@@ -627,21 +971,6 @@ SceneObject* SceneHierarchyPanel::findObjectByUuid(const QString& uuidStr)
     return m_objectManager->findByUuid(uuid);
 }
 
-void SceneHierarchyPanel::removeObjectFromAllCollections(SceneObject* object, Collection* root)
-{
-    if (!root) {
-        return;
-    }
-
-    // Remove from this collection
-    root->removeObject(object);
-
-    // Remove from child collections recursively
-    for (Collection* child : root->childCollections()) {
-        removeObjectFromAllCollections(object, child);
-    }
-}
-
 bool SceneHierarchyPanel::isDescendantOf(Collection* potential, Collection* ancestor)
 {
     if (!potential || !ancestor) {
@@ -658,15 +987,3 @@ bool SceneHierarchyPanel::isDescendantOf(Collection* potential, Collection* ance
 
     return false;
 }
-
-QStandardItem* SceneHierarchyPanel::findItemByObject(SceneObject* object)
-{
-    // TODO: Implement if needed for optimization
-    return nullptr;
-}
-
-QStandardItem* SceneHierarchyPanel::findItemByCollection(Collection* collection)
-{
-    // TODO: Implement if needed for optimization
-    return nullptr;
-}
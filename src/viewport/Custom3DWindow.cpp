@@ -11,6 +11,8 @@ Custom3DWindow::Custom3DWindow(QScreen *screen)
     , m_orbiting(false)
     , m_panning(false)
     , m_flyMode(false)
+    , m_leftPressed(false)
+    , m_rectDragging(false)
 {
     // Enable mouse tracking to get move events even without buttons pressed
     setMouseGrabEnabled(true);
@@ -39,6 +41,8 @@ void Custom3DWindow::setFlyMode(bool enabled)
 
 void Custom3DWindow::mousePressEvent(QMouseEvent *event)
 {
+    emit pointerPressed(event->pos());
+
     if (!m_blenderStyle) {
         Qt3DExtras::Qt3DWindow::mousePressEvent(event);
         return;
@@ -61,6 +65,12 @@ void Custom3DWindow::mousePressEvent(QMouseEvent *event)
         return;
     }
 
+    if (event->button() == Qt::LeftButton && !m_flyMode) {
+        m_leftPressed = true;
+        m_rectDragging = false;
+        m_leftPressPos = event->pos();
+    }
+
     // Let Qt3D handle other mouse buttons
     Qt3DExtras::Qt3DWindow::mousePressEvent(event);
 }
@@ -97,6 +107,12 @@ void Custom3DWindow::mouseMoveEvent(QMouseEvent *event)
         return;
     }
 
+    // Left drag becomes a rectangle selection
+    if (m_leftPressed && !m_rectDragging &&
+        (event->pos() - m_leftPressPos).manhattanLength() >= QApplication::startDragDistance()) {
+        m_rectDragging = true;
+    }
+
     // Let Qt3D handle other mouse movements
     Qt3DExtras::Qt3DWindow::mouseMoveEvent(event);
 }
@@ -117,6 +133,18 @@ void Custom3DWindow::mouseReleaseEvent(QMouseEvent *event)
         return;
     }
 
+    if (event->button() == Qt::LeftButton && m_leftPressed && !m_flyMode) {
+        if (m_rectDragging) {
+            emit rectangleSelected(QRect(m_leftPressPos, event->pos()).normalized(), event->modifiers());
+        } else {
+            emit leftClicked(event->pos(), event->modifiers());
+        }
+    }
+    if (event->button() == Qt::LeftButton) {
+        m_leftPressed = false;
+        m_rectDragging = false;
+    }
+
     // Let Qt3D handle other mouse button releases
     Qt3DExtras::Qt3DWindow::mouseReleaseEvent(event);
 }
@@ -128,6 +156,8 @@ void Custom3DWindow::wheelEvent(QWheelEvent *event)
         return;
     }
 
+    emit pointerPressed(event->position().toPoint());
+
     float delta = event->angleDelta().y() / 120.0f;
     emit zoomRequested(delta);
     event->accept();
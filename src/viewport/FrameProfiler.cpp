@@ -0,0 +1,183 @@
+#include "viewport/FrameProfiler.h"
+#include "viewport/ViewCuller.h"
+#include "core/RenderCounters.h"
+
+#include <Qt3DCore/QEntity>
+#include <Qt3DLogic/QFrameAction>
+#include <QDebug>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <ctime>
+#endif
+
+namespace {
+
+// Counting entities walks the whole scene graph; refresh it at most this often
+constexpr qint64 EntityCountIntervalNs = 1000 * 1000 * 1000;
+
+// Weight of the newest frame in the smoothed FPS
+constexpr double FpsSmoothing = 0.1;
+
+// CPU time consumed by the calling thread (not the whole process)
+qint64 threadCpuNs()
+{
+#ifdef Q_OS_WIN
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+        return 0;
+    }
+    const quint64 ticks = (quint64(kernel.dwHighDateTime) << 32 | kernel.dwLowDateTime)
+                        + (quint64(user.dwHighDateTime) << 32 | user.dwLowDateTime);
+    return qint64(ticks * 100);  // 100 ns units
+#else
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return qint64(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+} // namespace
+
+FrameProfiler::FrameProfiler(Qt3DCore::QEntity* rootEntity, ViewCuller* viewCuller, QObject* parent)
+    : QObject(parent)
+    , m_rootEntity(rootEntity)
+    , m_viewCuller(viewCuller)
+    , m_frameEntity(new Qt3DCore::QEntity(rootEntity))
+    , m_frameAction(new Qt3DLogic::QFrameAction(m_frameEntity))
+    , m_active(false)
+    , m_lastFrameNs(0)
+    , m_lastCpuNs(0)
+    , m_lastEntityCountNs(-EntityCountIntervalNs)
+{
+    m_frameEntity->addComponent(m_frameAction);
+    connect(m_frameAction, &Qt3DLogic::QFrameAction::triggered, this, &FrameProfiler::onFrame);
+    updateFrameAction();
+}
+
+FrameProfiler::~FrameProfiler()
+{
+    stopTrace();
+}
+
+void FrameProfiler::setActive(bool active)
+{
+    if (m_active != active) {
+        m_active = active;
+        updateFrameAction();
+    }
+}
+
+void FrameProfiler::updateFrameAction()
+{
+    const bool running = isRunning();
+    if (running == m_frameEntity->isEnabled()) {
+        return;
+    }
+    if (running) {
+        resetTiming();
+    }
+    m_frameEntity->setEnabled(running);
+    emit runningChanged(running);
+}
+
+void FrameProfiler::resetTiming()
+{
+    m_sample = Sample();
+    m_clock.start();
+    m_lastFrameNs = 0;
+    m_lastCpuNs = threadCpuNs();
+    m_lastEntityCountNs = -EntityCountIntervalNs;
+    RenderCounters::takeUploadedBytes();  // Start counting from this frame
+}
+
+bool FrameProfiler::startTrace(const QString& filePath)
+{
+    stopTrace();
+
+    auto file = std::make_unique<QFile>(filePath);
+    if (!file->open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "FrameProfiler: cannot open trace file" << filePath << file->errorString();
+        return false;
+    }
+    m_traceFile = std::move(file);
+    m_traceStream.setDevice(m_traceFile.get());
+    m_traceStream << csvHeader() << '\n';
+
+    // Frame numbers and times of the trace start at zero
+    if (m_frameEntity->isEnabled()) {
+        resetTiming();
+    }
+    updateFrameAction();
+    qDebug() << "FrameProfiler: tracing to" << filePath;
+    return true;
+}
+
+void FrameProfiler::stopTrace()
+{
+    if (!m_traceFile) {
+        return;
+    }
+    m_traceStream.flush();
+    m_traceStream.setDevice(nullptr);
+    m_traceFile.reset();
+    updateFrameAction();
+}
+
+QString FrameProfiler::csvHeader()
+{
+    return QStringLiteral("frame,time_ms,frame_ms,fps,cpu_ms,est_objects,est_triangles,uploaded_bytes,entities");
+}
+
+QString FrameProfiler::toCsv(const Sample& sample)
+{
+    return QStringLiteral("%1,%2,%3,%4,%5,%6,%7,%8,%9")
+        .arg(sample.frame)
+        .arg(sample.timeMs, 0, 'f', 3)
+        .arg(sample.frameMs, 0, 'f', 3)
+        .arg(sample.fps, 0, 'f', 1)
+        .arg(sample.cpuMs, 0, 'f', 3)
+        .arg(sample.estimatedObjects)
+        .arg(sample.estimatedTriangles)
+        .arg(sample.uploadedBytes)
+        .arg(sample.entityCount);
+}
+
+void FrameProfiler::onFrame()
+{
+    const qint64 nowNs = m_clock.nsecsElapsed();
+    const qint64 cpuNs = threadCpuNs();
+
+    Sample& s = m_sample;
+    ++s.frame;
+    s.timeMs = nowNs / 1e6;
+    s.frameMs = (nowNs - m_lastFrameNs) / 1e6;
+    if (s.frameMs > 0.0) {
+        const double fps = 1000.0 / s.frameMs;
+        s.fps = s.frame == 1 ? fps : s.fps + (fps - s.fps) * FpsSmoothing;
+    }
+    s.cpuMs = (cpuNs - m_lastCpuNs) / 1e6;
+    s.uploadedBytes = RenderCounters::takeUploadedBytes();
+
+    if (m_viewCuller) {
+        const ViewCuller::Stats& stats = m_viewCuller->stats();
+        s.estimatedObjects = stats.drawnObjects;
+        s.estimatedTriangles = stats.drawnTriangles;
+    }
+
+    if (nowNs - m_lastEntityCountNs >= EntityCountIntervalNs) {
+        s.entityCount = m_rootEntity->findChildren<Qt3DCore::QEntity*>().size() + 1;
+        m_lastEntityCountNs = nowNs;
+    }
+
+    m_lastFrameNs = nowNs;
+    m_lastCpuNs = cpuNs;
+
+    if (m_traceFile) {
+        m_traceStream << toCsv(s) << '\n';
+    }
+    emit sampleReady(s);
+}
@@ -0,0 +1,287 @@
+#include "viewport/OffscreenRenderer.h"
+#include "viewport/ViewportController.h"
+#include "scene/ObjectManager.h"
+
+#include <Qt3DCore/QAspectEngine>
+#include <Qt3DCore/QEntity>
+#include <Qt3DRender/QRenderAspect>
+#include <Qt3DRender/QRenderSettings>
+#include <Qt3DRender/QRenderSurfaceSelector>
+#include <Qt3DRender/QRenderTargetSelector>
+#include <Qt3DRender/QRenderTarget>
+#include <Qt3DRender/QRenderTargetOutput>
+#include <Qt3DRender/QTexture>
+#include <Qt3DRender/QViewport>
+#include <Qt3DRender/QCameraSelector>
+#include <Qt3DRender/QCamera>
+#include <Qt3DRender/QClearBuffers>
+#include <Qt3DRender/QTechniqueFilter>
+#include <Qt3DRender/QFilterKey>
+#include <Qt3DRender/QRenderStateSet>
+#include <Qt3DRender/QDepthTest>
+#include <Qt3DRender/QRenderCapture>
+#include <Qt3DRender/QDirectionalLight>
+#include <QOffscreenSurface>
+#include <QSurfaceFormat>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QFutureWatcher>
+#include <QDir>
+#include <QDebug>
+
+namespace {
+
+struct ViewInfo {
+    OffscreenRenderer::View view;
+    const char* name;
+};
+
+const ViewInfo viewInfos[] = {
+    { OffscreenRenderer::Isometric, "iso" },
+    { OffscreenRenderer::Front, "front" },
+    { OffscreenRenderer::Back, "back" },
+    { OffscreenRenderer::Left, "left" },
+    { OffscreenRenderer::Right, "right" },
+    { OffscreenRenderer::Top, "top" },
+    { OffscreenRenderer::Bottom, "bottom" },
+};
+
+} // namespace
+
+OffscreenRenderer::OffscreenRenderer(QObject* parent)
+    : QObject(parent)
+    , m_surface(std::make_unique<QOffscreenSurface>())
+    , m_engine(std::make_unique<Qt3DCore::QAspectEngine>())
+    , m_root(new Qt3DCore::QEntity())
+    , m_sceneRoot(new Qt3DCore::QEntity(m_root))
+    , m_camera(new Qt3DRender::QCamera(m_root))
+    , m_surfaceSelector(nullptr)
+    , m_clearBuffers(nullptr)
+    , m_capture(nullptr)
+    , m_colorTexture(nullptr)
+    , m_depthTexture(nullptr)
+    , m_busy(false)
+    , m_pendingWrites(0)
+{
+    m_surface->setFormat(QSurfaceFormat::defaultFormat());
+    m_surface->create();
+
+    m_engine->registerAspect(new Qt3DRender::QRenderAspect());
+
+    m_controller = std::make_unique<ViewportController>(m_camera);
+    m_camera->lens()->setPerspectiveProjection(
+        m_controller->settings()->fieldOfView(),
+        4.0f / 3.0f,
+        m_controller->settings()->nearPlane(),
+        m_controller->settings()->farPlane());
+
+    buildFrameGraph(m_root);
+    setupLighting(m_root);
+    m_objectManager = std::make_unique<ObjectManager>(m_sceneRoot);
+
+    m_engine->setRootEntity(Qt3DCore::QEntityPtr(m_root));
+    qDebug() << "OffscreenRenderer created";
+}
+
+OffscreenRenderer::~OffscreenRenderer()
+{
+    // Objects first, while the engine still owns the scene graph
+    m_objectManager.reset();
+}
+
+void OffscreenRenderer::buildFrameGraph(Qt3DCore::QEntity* root)
+{
+    // Colour + depth textures, resized for each job
+    auto* renderTarget = new Qt3DRender::QRenderTarget();
+
+    auto* colorOutput = new Qt3DRender::QRenderTargetOutput(renderTarget);
+    colorOutput->setAttachmentPoint(Qt3DRender::QRenderTargetOutput::Color0);
+    m_colorTexture = new Qt3DRender::QTexture2D(colorOutput);
+    m_colorTexture->setFormat(Qt3DRender::QAbstractTexture::RGBA8_UNorm);
+    colorOutput->setTexture(m_colorTexture);
+    renderTarget->addOutput(colorOutput);
+
+    auto* depthOutput = new Qt3DRender::QRenderTargetOutput(renderTarget);
+    depthOutput->setAttachmentPoint(Qt3DRender::QRenderTargetOutput::Depth);
+    m_depthTexture = new Qt3DRender::QTexture2D(depthOutput);
+    m_depthTexture->setFormat(Qt3DRender::QAbstractTexture::D24);
+    depthOutput->setTexture(m_depthTexture);
+    renderTarget->addOutput(depthOutput);
+
+    // Offscreen surface -> texture target -> camera -> clear -> forward
+    // techniques (as QForwardRenderer) -> depth test -> capture
+    m_surfaceSelector = new Qt3DRender::QRenderSurfaceSelector();
+    m_surfaceSelector->setSurface(m_surface.get());
+
+    auto* targetSelector = new Qt3DRender::QRenderTargetSelector(m_surfaceSelector);
+    targetSelector->setTarget(renderTarget);
+    renderTarget->setParent(targetSelector);
+
+    auto* viewport = new Qt3DRender::QViewport(targetSelector);
+    auto* cameraSelector = new Qt3DRender::QCameraSelector(viewport);
+    cameraSelector->setCamera(m_camera);
+
+    m_clearBuffers = new Qt3DRender::QClearBuffers(cameraSelector);
+    m_clearBuffers->setBuffers(Qt3DRender::QClearBuffers::ColorDepthBuffer);
+    m_clearBuffers->setClearColor(m_controller->settings()->backgroundColor());
+
+    auto* techniqueFilter = new Qt3DRender::QTechniqueFilter(m_clearBuffers);
+    auto* filterKey = new Qt3DRender::QFilterKey(techniqueFilter);
+    filterKey->setName(QStringLiteral("renderingStyle"));
+    filterKey->setValue(QStringLiteral("forward"));
+    techniqueFilter->addMatch(filterKey);
+
+    auto* stateSet = new Qt3DRender::QRenderStateSet(techniqueFilter);
+    auto* depthTest = new Qt3DRender::QDepthTest(stateSet);
+    depthTest->setDepthFunction(Qt3DRender::QDepthTest::Less);
+    stateSet->addRenderState(depthTest);
+
+    m_capture = new Qt3DRender::QRenderCapture(stateSet);
+
+    auto* renderSettings = new Qt3DRender::QRenderSettings(root);
+    renderSettings->setActiveFrameGraph(m_surfaceSelector);
+    root->addComponent(renderSettings);
+}
+
+void OffscreenRenderer::setupLighting(Qt3DCore::QEntity* root)
+{
+    // Same key and fill lights as the interactive viewport
+    auto* lightEntity = new Qt3DCore::QEntity(root);
+    auto* light = new Qt3DRender::QDirectionalLight(lightEntity);
+    light->setColor(QColor(255, 255, 255));
+    light->setIntensity(1.0f);
+    light->setWorldDirection(QVector3D(-0.5f, -1.0f, -0.5f).normalized());
+    lightEntity->addComponent(light);
+
+    auto* fillLightEntity = new Qt3DCore::QEntity(root);
+    auto* fillLight = new Qt3DRender::QDirectionalLight(fillLightEntity);
+    fillLight->setColor(QColor(180, 180, 200));
+    fillLight->setIntensity(0.4f);
+    fillLight->setWorldDirection(QVector3D(0.5f, 0.5f, 1.0f).normalized());
+    fillLightEntity->addComponent(fillLight);
+}
+
+void OffscreenRenderer::setBackgroundColor(const QColor& color)
+{
+    m_clearBuffers->setClearColor(color);
+}
+
+void OffscreenRenderer::render(const QVector<Job>& jobs)
+{
+    m_queue += jobs;
+    if (!m_busy) {
+        m_busy = true;
+        startNextJob();
+    }
+}
+
+void OffscreenRenderer::startNextJob()
+{
+    if (m_queue.isEmpty()) {
+        m_busy = false;
+        if (m_pendingWrites == 0) {
+            emit finished();
+        }
+        return;
+    }
+
+    m_currentJob = m_queue.takeFirst();
+    const QSize size = m_currentJob.size.expandedTo(QSize(1, 1));
+
+    m_colorTexture->setSize(size.width(), size.height());
+    m_depthTexture->setSize(size.width(), size.height());
+    m_surfaceSelector->setExternalRenderTargetSize(size);
+    m_camera->setAspectRatio(float(size.width()) / size.height());
+
+    switch (m_currentJob.view) {
+    case Isometric: m_controller->viewIsometric(); break;
+    case Front: m_controller->viewFront(); break;
+    case Back: m_controller->viewBack(); break;
+    case Left: m_controller->viewLeft(); break;
+    case Right: m_controller->viewRight(); break;
+    case Top: m_controller->viewTop(); break;
+    case Bottom: m_controller->viewBottom(); break;
+    }
+    m_controller->frameBounds(m_objectManager->sceneBounds());
+
+    // Changes above reach the backend before the frame that serves the capture
+    Qt3DRender::QRenderCaptureReply* reply = m_capture->requestCapture();
+    connect(reply, &Qt3DRender::QRenderCaptureReply::completed, this, [this, reply]() { onCaptureCompleted(reply); });
+}
+
+void OffscreenRenderer::onCaptureCompleted(Qt3DRender::QRenderCaptureReply* reply)
+{
+    const QImage image = reply->image();
+    reply->deleteLater();
+    const Job job = m_currentJob;
+
+    if (image.isNull()) {
+        qWarning() << "OffscreenRenderer: capture failed for" << viewName(job.view);
+    } else {
+        emit imageReady(job, image);
+    }
+
+    if (image.isNull() || job.filePath.isEmpty()) {
+        emit jobFinished(job, false);
+    } else {
+        // Encode and write on the thread pool while the next job renders
+        ++m_pendingWrites;
+        auto* watcher = new QFutureWatcher<bool>(this);
+        connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, job]() {
+            watcher->deleteLater();
+            onJobWritten(job, watcher->result());
+        });
+        watcher->setFuture(QtConcurrent::run([image, path = job.filePath]() { return image.save(path); }));
+    }
+
+    startNextJob();
+}
+
+void OffscreenRenderer::onJobWritten(const Job& job, bool written)
+{
+    --m_pendingWrites;
+    if (!written) {
+        qWarning() << "OffscreenRenderer: cannot write" << job.filePath;
+    }
+    emit jobFinished(job, written);
+
+    if (!m_busy && m_pendingWrites == 0) {
+        emit finished();
+    }
+}
+
+QVector<OffscreenRenderer::Job> OffscreenRenderer::viewJobs(const QString& directory, const QString& baseName,
+                                                            const QVector<View>& views, const QSize& size)
+{
+    QVector<Job> jobs;
+    jobs.reserve(views.size());
+    const QDir dir(directory);
+    for (View view : views) {
+        Job job;
+        job.view = view;
+        job.size = size;
+        job.filePath = dir.filePath(QString("%1_%2.png").arg(baseName, viewName(view)));
+        jobs.append(job);
+    }
+    return jobs;
+}
+
+QString OffscreenRenderer::viewName(View view)
+{
+    for (const ViewInfo& info : viewInfos) {
+        if (info.view == view) {
+            return QString::fromLatin1(info.name);
+        }
+    }
+    return QString();
+}
+
+bool OffscreenRenderer::viewFromName(const QString& name, View* view)
+{
+    for (const ViewInfo& info : viewInfos) {
+        if (name.compare(QLatin1String(info.name), Qt::CaseInsensitive) == 0) {
+            *view = info.view;
+            return true;
+        }
+    }
+    return false;
+}
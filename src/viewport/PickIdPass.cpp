@@ -0,0 +1,397 @@
+#include "viewport/PickIdPass.h"
+#include "scene/ObjectManager.h"
+#include "scene/SceneObject.h"
+#include "mesh/MeshData.h"
+
+#include <Qt3DCore/QEntity>
+#include <Qt3DRender/QCamera>
+#include <Qt3DRender/QCameraSelector>
+#include <Qt3DRender/QClearBuffers>
+#include <Qt3DRender/QDepthTest>
+#include <Qt3DRender/QEffect>
+#include <Qt3DRender/QFilterKey>
+#include <Qt3DRender/QGeometryRenderer>
+#include <Qt3DRender/QGraphicsApiFilter>
+#include <Qt3DRender/QMaterial>
+#include <Qt3DRender/QParameter>
+#include <Qt3DRender/QRenderCapture>
+#include <Qt3DRender/QRenderPass>
+#include <Qt3DRender/QRenderSurfaceSelector>
+#include <Qt3DRender/QRenderStateSet>
+#include <Qt3DRender/QRenderTarget>
+#include <Qt3DRender/QRenderTargetOutput>
+#include <Qt3DRender/QRenderTargetSelector>
+#include <Qt3DRender/QScissorTest>
+#include <Qt3DRender/QShaderProgram>
+#include <Qt3DRender/QTechnique>
+#include <Qt3DRender/QTechniqueFilter>
+#include <Qt3DRender/QTexture>
+#include <Qt3DRender/QViewport>
+#include <Qt3DExtras/Qt3DWindow>
+#include <QImage>
+#include <QSet>
+#include <QtMath>
+#include <QDebug>
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+const char* const idVertexShader = R"(
+#version 330 core
+
+in vec3 vertexPosition;
+
+uniform mat4 modelViewProjection;
+
+void main()
+{
+    gl_Position = modelViewProjection * vec4(vertexPosition, 1.0);
+}
+)";
+
+// Object id, or in Edit Mode the edited object's triangle index + 1
+const char* const idFragmentShader = R"(
+#version 330 core
+
+out vec4 fragColor;
+
+uniform int pickId;
+uniform int editObjectId;
+
+void main()
+{
+    int value = editObjectId == 0 ? pickId : (pickId == editObjectId ? gl_PrimitiveID + 1 : 0);
+    fragColor = vec4(value & 0xff, (value >> 8) & 0xff, (value >> 16) & 0xff, 255) / 255.0;
+}
+)";
+
+Qt3DRender::QFilterKey* createPickFilterKey(Qt3DCore::QNode* parent)
+{
+    auto* filterKey = new Qt3DRender::QFilterKey(parent);
+    filterKey->setName(QStringLiteral("renderingStyle"));
+    filterKey->setValue(QStringLiteral("pickId"));
+    return filterKey;
+}
+
+} // namespace
+
+PickIdPass::PickIdPass(Qt3DExtras::Qt3DWindow* window, ObjectManager* objectManager, QObject *parent)
+    : QObject(parent)
+    , m_window(window)
+    , m_objectManager(objectManager)
+    , m_branch(nullptr)
+    , m_viewport(nullptr)
+    , m_cameraSelector(nullptr)
+    , m_capture(nullptr)
+    , m_scissor(nullptr)
+    , m_colorTexture(nullptr)
+    , m_depthTexture(nullptr)
+    , m_editObjectParameter(nullptr)
+    , m_idEffect(nullptr)
+    , m_nextRequestId(1)
+{
+    buildFrameGraph();
+
+    // Shared by every object's ID material; only the pickId parameter differs
+    m_idEffect = new Qt3DRender::QEffect(m_objectManager->rootEntity());
+    auto* technique = new Qt3DRender::QTechnique(m_idEffect);
+    technique->graphicsApiFilter()->setApi(Qt3DRender::QGraphicsApiFilter::OpenGL);
+    technique->graphicsApiFilter()->setProfile(Qt3DRender::QGraphicsApiFilter::CoreProfile);
+    technique->graphicsApiFilter()->setMajorVersion(3);
+    technique->graphicsApiFilter()->setMinorVersion(3);
+    technique->addFilterKey(createPickFilterKey(technique));
+
+    auto* shader = new Qt3DRender::QShaderProgram(technique);
+    shader->setVertexShaderCode(idVertexShader);
+    shader->setFragmentShaderCode(idFragmentShader);
+
+    auto* pass = new Qt3DRender::QRenderPass(technique);
+    pass->setShaderProgram(shader);
+    technique->addRenderPass(pass);
+    m_idEffect->addTechnique(technique);
+
+    connect(m_objectManager, &ObjectManager::objectsAdded, this, &PickIdPass::onObjectsAdded);
+    connect(m_objectManager, &ObjectManager::objectsRemoved, this, &PickIdPass::onObjectsRemoved);
+    onObjectsAdded(m_objectManager->allObjects());
+
+    connect(m_window, &QWindow::widthChanged, this, &PickIdPass::updateTargetSize);
+    connect(m_window, &QWindow::heightChanged, this, &PickIdPass::updateTargetSize);
+    updateTargetSize();
+
+    qDebug() << "PickIdPass created";
+}
+
+PickIdPass::~PickIdPass()
+{
+}
+
+void PickIdPass::buildFrameGraph()
+{
+    // ID target: RGBA8 colour (24-bit id) plus depth, sized to the window
+    auto* renderTarget = new Qt3DRender::QRenderTarget();
+
+    auto* colorOutput = new Qt3DRender::QRenderTargetOutput(renderTarget);
+    colorOutput->setAttachmentPoint(Qt3DRender::QRenderTargetOutput::Color0);
+    m_colorTexture = new Qt3DRender::QTexture2D(colorOutput);
+    m_colorTexture->setFormat(Qt3DRender::QAbstractTexture::RGBA8_UNorm);
+    m_colorTexture->setMinificationFilter(Qt3DRender::QAbstractTexture::Nearest);
+    m_colorTexture->setMagnificationFilter(Qt3DRender::QAbstractTexture::Nearest);
+    colorOutput->setTexture(m_colorTexture);
+    renderTarget->addOutput(colorOutput);
+
+    auto* depthOutput = new Qt3DRender::QRenderTargetOutput(renderTarget);
+    depthOutput->setAttachmentPoint(Qt3DRender::QRenderTargetOutput::Depth);
+    m_depthTexture = new Qt3DRender::QTexture2D(depthOutput);
+    m_depthTexture->setFormat(Qt3DRender::QAbstractTexture::D24);
+    depthOutput->setTexture(m_depthTexture);
+    renderTarget->addOutput(depthOutput);
+
+    // Branch: window surface -> pickId techniques -> ID target -> scene
+    // camera -> clear -> depth test + scissor to the requested regions ->
+    // capture. Without a surface Qt3D never renders the branch.
+    auto* surfaceSelector = new Qt3DRender::QRenderSurfaceSelector();
+    surfaceSelector->setSurface(m_window);
+
+    auto* techniqueFilter = new Qt3DRender::QTechniqueFilter(surfaceSelector);
+    techniqueFilter->addMatch(createPickFilterKey(techniqueFilter));
+    m_editObjectParameter = new Qt3DRender::QParameter(QStringLiteral("editObjectId"), 0, techniqueFilter);
+    techniqueFilter->addParameter(m_editObjectParameter);
+
+    auto* targetSelector = new Qt3DRender::QRenderTargetSelector(techniqueFilter);
+    targetSelector->setTarget(renderTarget);
+    renderTarget->setParent(targetSelector);
+
+    m_viewport = new Qt3DRender::QViewport(targetSelector);
+    m_cameraSelector = new Qt3DRender::QCameraSelector(m_viewport);
+    m_cameraSelector->setCamera(m_window->camera());
+
+    auto* clearBuffers = new Qt3DRender::QClearBuffers(m_cameraSelector);
+    clearBuffers->setBuffers(Qt3DRender::QClearBuffers::ColorDepthBuffer);
+    clearBuffers->setClearColor(Qt::black);
+
+    auto* stateSet = new Qt3DRender::QRenderStateSet(clearBuffers);
+    auto* depthTest = new Qt3DRender::QDepthTest(stateSet);
+    depthTest->setDepthFunction(Qt3DRender::QDepthTest::Less);
+    stateSet->addRenderState(depthTest);
+    m_scissor = new Qt3DRender::QScissorTest(stateSet);
+    stateSet->addRenderState(m_scissor);
+
+    m_capture = new Qt3DRender::QRenderCapture(stateSet);
+
+    // Idle until a pick is requested
+    m_branch = surfaceSelector;
+    m_branch->setEnabled(false);
+
+    // Run after the window's own frame graph
+    auto* root = new Qt3DRender::QFrameGraphNode();
+    m_window->activeFrameGraph()->setParent(root);
+    m_branch->setParent(root);
+    m_window->setActiveFrameGraph(root);
+}
+
+void PickIdPass::updateTargetSize()
+{
+    const qreal dpr = m_window->devicePixelRatio();
+    const QSize size(qMax(1, qRound(m_window->width() * dpr)), qMax(1, qRound(m_window->height() * dpr)));
+    if (size == m_targetSize) {
+        return;
+    }
+
+    m_targetSize = size;
+    m_colorTexture->setSize(size.width(), size.height());
+    m_depthTexture->setSize(size.width(), size.height());
+}
+
+void PickIdPass::setView(Qt3DRender::QCamera* camera, const QRectF& normalizedRect)
+{
+    // Same placement as the view, so window coordinates map unchanged
+    m_cameraSelector->setCamera(camera);
+    m_viewport->setNormalizedRect(normalizedRect);
+}
+
+void PickIdPass::setEditObject(SceneObject* object)
+{
+    if (m_editObject == object) {
+        return;
+    }
+    m_editObject = object;
+    m_editObjectParameter->setValue(int(object ? object->pickId() : 0));
+}
+
+void PickIdPass::onObjectsAdded(const QVector<SceneObject*>& objects)
+{
+    for (SceneObject* object : objects) {
+        if (m_objectsByPickId.contains(object->pickId())) {
+            continue;
+        }
+        m_objectsByPickId.insert(object->pickId(), object);
+        connect(object, &SceneObject::geometryChanged, this, [this, object]() { syncIdEntity(object); });
+        syncIdEntity(object);
+    }
+}
+
+void PickIdPass::onObjectsRemoved(const QVector<SceneObject*>& objects)
+{
+    for (SceneObject* object : objects) {
+        if (!m_objectsByPickId.remove(object->pickId())) {
+            continue;
+        }
+        disconnect(object, nullptr, this, nullptr);
+
+        const IdEntity idEntity = m_idEntities.take(object);
+        delete idEntity.entity;
+    }
+}
+
+void PickIdPass::syncIdEntity(SceneObject* object)
+{
+    // Attached instances have no renderer; their group draws their ids
+    Qt3DRender::QGeometryRenderer* renderer = object->geometryRenderer();
+    auto it = m_idEntities.find(object);
+
+    if (!renderer) {
+        if (it != m_idEntities.end()) {
+            delete it->entity;
+            m_idEntities.erase(it);
+        }
+        return;
+    }
+
+    if (it == m_idEntities.end()) {
+        // Child entity: inherits the object's transform and visibility
+        IdEntity idEntity;
+        idEntity.entity = new Qt3DCore::QEntity(object);
+
+        auto* material = new Qt3DRender::QMaterial(idEntity.entity);
+        material->setEffect(m_idEffect);
+        material->addParameter(new Qt3DRender::QParameter(QStringLiteral("pickId"), int(object->pickId()), material));
+        idEntity.entity->addComponent(material);
+
+        it = m_idEntities.insert(object, idEntity);
+    } else if (it->renderer == renderer) {
+        return;
+    } else if (it->renderer) {
+        it->entity->removeComponent(it->renderer);
+    }
+
+    // Share the object's renderer (and so its geometry) as is
+    it->entity->addComponent(renderer);
+    it->renderer = renderer;
+}
+
+int PickIdPass::requestPick(const QRect& windowRect)
+{
+    // Window -> framebuffer pixels, clipped to the target
+    const qreal dpr = m_window->devicePixelRatio();
+    const QRect pixelRect = QRect(qFloor(windowRect.x() * dpr), qFloor(windowRect.y() * dpr),
+                                  qMax(1, qCeil(windowRect.width() * dpr)), qMax(1, qCeil(windowRect.height() * dpr)))
+                                .intersected(QRect(QPoint(0, 0), m_targetSize));
+    if (pixelRect.isEmpty()) {
+        return -1;
+    }
+
+    // Capture and scissor rects use the GL convention (origin bottom-left)
+    const QRect glRect(pixelRect.x(), m_targetSize.height() - pixelRect.y() - pixelRect.height(),
+                       pixelRect.width(), pixelRect.height());
+
+    Request request;
+    request.id = m_nextRequestId++;
+    request.rect = windowRect;
+    request.glRect = glRect;
+    request.pickFaces = m_editObject != nullptr;
+    request.editObject = m_editObject;
+
+    Qt3DRender::QRenderCaptureReply* reply = m_capture->requestCapture(glRect);
+    m_pending.insert(reply, request);
+    connect(reply, &Qt3DRender::QRenderCaptureReply::completed, this, [this, reply]() { onCaptureCompleted(reply); });
+
+    updateScissor();
+    m_branch->setEnabled(true);
+    return request.id;
+}
+
+void PickIdPass::updateScissor()
+{
+    // Only pixels some pending request reads are rendered
+    QRect bounds;
+    for (const Request& request : std::as_const(m_pending)) {
+        bounds = bounds.united(request.glRect);
+    }
+    m_scissor->setLeft(bounds.x());
+    m_scissor->setBottom(bounds.y());
+    m_scissor->setWidth(bounds.width());
+    m_scissor->setHeight(bounds.height());
+}
+
+void PickIdPass::onCaptureCompleted(Qt3DRender::QRenderCaptureReply* reply)
+{
+    const Request request = m_pending.take(reply);
+    const QImage image = reply->image().convertToFormat(QImage::Format_RGBX8888);
+    reply->deleteLater();
+
+    if (m_pending.isEmpty()) {
+        m_branch->setEnabled(false);
+    } else {
+        updateScissor();
+    }
+
+    // Decode each pixel, keeping the smallest distance to the centre per
+    // value. Distances are symmetric, so row order does not matter.
+    const float centreX = (image.width() - 1) * 0.5f;
+    const float centreY = (image.height() - 1) * 0.5f;
+    QHash<quint32, float> nearest;
+    for (int y = 0; y < image.height(); ++y) {
+        const uchar* line = image.constScanLine(y);
+        for (int x = 0; x < image.width(); ++x) {
+            const uchar* pixel = line + 4 * x;
+            const quint32 value = quint32(pixel[0]) | (quint32(pixel[1]) << 8) | (quint32(pixel[2]) << 16);
+            if (value == 0) {
+                continue;
+            }
+            const float dx = x - centreX;
+            const float dy = y - centreY;
+            const float distance = dx * dx + dy * dy;
+            auto it = nearest.find(value);
+            if (it == nearest.end()) {
+                nearest.insert(value, distance);
+            } else if (distance < *it) {
+                *it = distance;
+            }
+        }
+    }
+
+    QVector<QPair<float, quint32>> ordered;
+    ordered.reserve(nearest.size());
+    for (auto it = nearest.cbegin(); it != nearest.cend(); ++it) {
+        ordered.append(qMakePair(it.value(), it.key()));
+    }
+    std::sort(ordered.begin(), ordered.end());
+
+    Result result;
+    result.rect = request.rect;
+    result.editObject = request.editObject;
+
+    if (request.pickFaces) {
+        // Triangle index + 1 of the edited object; several triangles per face
+        const MeshData* mesh = request.editObject ? request.editObject->meshData() : nullptr;
+        QSet<int> seen;
+        for (const auto& entry : ordered) {
+            if (!mesh) break;
+            const int face = mesh->faceOfTriangle(int(entry.second) - 1);
+            if (face != -1 && !seen.contains(face)) {
+                seen.insert(face);
+                result.faces.append(face);
+            }
+        }
+    } else {
+        for (const auto& entry : ordered) {
+            SceneObject* object = m_objectsByPickId.value(entry.second, nullptr);
+            if (object) {
+                result.objects.append(object);
+            }
+        }
+    }
+
+    emit pickCompleted(request.id, result);
+}
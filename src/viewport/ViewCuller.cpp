@@ -0,0 +1,225 @@
+#include "viewport/ViewCuller.h"
+#include "scene/ObjectManager.h"
+#include "scene/SceneObject.h"
+#include "mesh/BoundingBox.h"
+
+#include <Qt3DRender/QCamera>
+#include <QVector4D>
+#include <QtMath>
+#include <cmath>
+#include <utility>
+#include <QDebug>
+
+namespace {
+
+// Planes of the view frustum (normal pointing inside) from the combined
+// view-projection matrix
+struct Frustum {
+    QVector4D planes[6];
+
+    explicit Frustum(const QMatrix4x4& viewProjection)
+    {
+        const QVector4D r0 = viewProjection.row(0);
+        const QVector4D r1 = viewProjection.row(1);
+        const QVector4D r2 = viewProjection.row(2);
+        const QVector4D r3 = viewProjection.row(3);
+        planes[0] = r3 + r0;  // Left
+        planes[1] = r3 - r0;  // Right
+        planes[2] = r3 + r1;  // Bottom
+        planes[3] = r3 - r1;  // Top
+        planes[4] = r3 + r2;  // Near
+        planes[5] = r3 - r2;  // Far
+    }
+
+    // False only if the box lies entirely outside one plane
+    bool intersects(const BoundingBox& box) const
+    {
+        for (const QVector4D& plane : planes) {
+            // Box corner furthest along the plane normal
+            const QVector3D corner(plane.x() >= 0.0f ? box.max().x() : box.min().x(),
+                                   plane.y() >= 0.0f ? box.max().y() : box.min().y(),
+                                   plane.z() >= 0.0f ? box.max().z() : box.min().z());
+            if (QVector3D::dotProduct(plane.toVector3D(), corner) + plane.w() < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+ViewCuller::ViewCuller(ObjectManager* objectManager, QObject* parent)
+    : QObject(parent)
+    , m_objectManager(objectManager)
+    , m_enabled(true)
+    , m_lodPixelError(1.0f)
+    , m_updatePending(false)
+{
+    connect(m_objectManager, &ObjectManager::objectsAdded, this, &ViewCuller::onObjectsAdded);
+    connect(m_objectManager, &ObjectManager::objectsRemoved, this, &ViewCuller::onObjectsRemoved);
+
+    onObjectsAdded(m_objectManager->allObjects());
+}
+
+void ViewCuller::setViews(const QVector<View>& views)
+{
+    for (const View& view : std::as_const(m_views)) {
+        disconnect(view.camera, nullptr, this, nullptr);
+    }
+    m_views.clear();
+    for (const View& view : views) {
+        if (!view.camera || view.viewportSize.isEmpty()) {
+            continue;
+        }
+        m_views.append(view);
+        connect(view.camera, &Qt3DRender::QCamera::viewMatrixChanged, this, &ViewCuller::scheduleUpdate);
+        connect(view.camera, &Qt3DRender::QCamera::projectionMatrixChanged, this, &ViewCuller::scheduleUpdate);
+    }
+    scheduleUpdate();
+}
+
+void ViewCuller::setEnabled(bool enabled)
+{
+    if (m_enabled != enabled) {
+        m_enabled = enabled;
+        scheduleUpdate();
+    }
+}
+
+void ViewCuller::setLodPixelError(float pixels)
+{
+    if (!qFuzzyCompare(m_lodPixelError, pixels)) {
+        m_lodPixelError = pixels;
+        scheduleUpdate();
+    }
+}
+
+void ViewCuller::setEditObject(SceneObject* object)
+{
+    if (m_editObject != object) {
+        m_editObject = object;
+        scheduleUpdate();
+    }
+}
+
+void ViewCuller::onObjectsAdded(const QVector<SceneObject*>& objects)
+{
+    for (SceneObject* object : objects) {
+        connect(object, &SceneObject::boundsChanged, this, &ViewCuller::scheduleUpdate);
+        connect(object, &SceneObject::lodChainReady, this, &ViewCuller::scheduleUpdate);
+    }
+    scheduleUpdate();
+}
+
+void ViewCuller::onObjectsRemoved(const QVector<SceneObject*>& objects)
+{
+    for (SceneObject* object : objects) {
+        disconnect(object, nullptr, this, nullptr);
+    }
+    scheduleUpdate();
+}
+
+void ViewCuller::scheduleUpdate()
+{
+    if (!m_updatePending) {
+        m_updatePending = true;
+        QMetaObject::invokeMethod(this, &ViewCuller::update, Qt::QueuedConnection);
+    }
+}
+
+void ViewCuller::update()
+{
+    m_updatePending = false;
+
+    QVector<Frustum> frusta;
+    frusta.reserve(m_views.size());
+    for (const View& view : std::as_const(m_views)) {
+        frusta.append(Frustum(view.camera->projectionMatrix() * view.camera->viewMatrix()));
+    }
+    Stats stats;
+
+    for (SceneObject* object : m_objectManager->allObjects()) {
+        if (!object->isVisible()) {
+            continue;
+        }
+
+        // Attached instances are drawn (and bounded) by their group
+        if (!object->geometryRenderer()) {
+            ++stats.drawnObjects;
+            stats.drawnTriangles += object->triangleCount();
+            stats.fullDetailTriangles += object->triangleCount();
+            continue;
+        }
+
+        // Views that see the object; all of them while culling is off
+        const BoundingBox& bounds = object->worldBounds();
+        QVector<int> seenBy;
+        for (int i = 0; i < frusta.size(); ++i) {
+            if (!m_enabled || bounds.isEmpty() || frusta[i].intersects(bounds)) {
+                seenBy.append(i);
+            }
+        }
+
+        const bool culled = m_enabled && !frusta.isEmpty() && seenBy.isEmpty();
+        object->setCulled(culled);
+        if (culled) {
+            ++stats.culledObjects;
+            stats.culledTriangles += object->triangleCount();
+            continue;
+        }
+
+        // The entity is shared, so the view needing the most detail decides
+        int level = 0;
+        if (m_enabled && object != m_editObject && !seenBy.isEmpty()) {
+            object->requestLodChain();
+            level = object->lodLevelCount() - 1;
+            for (int i : std::as_const(seenBy)) {
+                level = qMin(level, selectLod(object, bounds, m_views[i]));
+            }
+            level = qMax(level, 0);
+        }
+        object->setLodLevel(level);
+
+        const int views = qMax(1, int(seenBy.size()));
+        ++stats.drawnObjects;
+        stats.drawnTriangles += object->lodTriangleCount(object->lodLevel()) * views;
+        stats.fullDetailTriangles += object->triangleCount();
+    }
+
+    m_stats = stats;
+    emit statsChanged(m_stats);
+}
+
+int ViewCuller::selectLod(const SceneObject* object, const BoundingBox& bounds, const View& view) const
+{
+    const int levels = object->lodLevelCount();
+    if (levels <= 1) {
+        return 0;
+    }
+
+    // Distance from the eye to the nearest point of the bounds
+    const QVector3D eye = view.camera->position();
+    const QVector3D nearest(qBound(bounds.min().x(), eye.x(), bounds.max().x()),
+                            qBound(bounds.min().y(), eye.y(), bounds.max().y()),
+                            qBound(bounds.min().z(), eye.z(), bounds.max().z()));
+    const float distance = (nearest - eye).length();
+    if (distance <= view.camera->nearPlane()) {
+        return 0;
+    }
+
+    // Pixels covered by one world unit at that distance
+    const float halfFov = qDegreesToRadians(view.camera->fieldOfView()) * 0.5f;
+    const float pixelsPerUnit = view.viewportSize.height() / (2.0f * distance * std::tan(halfFov));
+
+    const QVector3D scale = object->scale();
+    const float maxScale = qMax(qAbs(scale.x()), qMax(qAbs(scale.y()), qAbs(scale.z())));
+
+    // Coarsest level whose error stays below the pixel threshold
+    for (int level = levels - 1; level > 0; --level) {
+        if (object->lodError(level) * maxScale * pixelsPerUnit <= m_lodPixelError) {
+            return level;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include "viewport/ViewLayout.h"
+#include "viewport/ViewportController.h"
+#include "viewport/ViewportSettings.h"
+
+#include <Qt3DCore/QEntity>
+#include <Qt3DRender/QCamera>
+#include <Qt3DRender/QCameraSelector>
+#include <Qt3DRender/QClearBuffers>
+#include <Qt3DRender/QFilterKey>
+#include <Qt3DRender/QFrustumCulling>
+#include <Qt3DRender/QLayer>
+#include <Qt3DRender/QLayerFilter>
+#include <Qt3DRender/QNoDraw>
+#include <Qt3DRender/QRenderSurfaceSelector>
+#include <Qt3DRender/QTechniqueFilter>
+#include <Qt3DRender/QViewport>
+#include <Qt3DExtras/QForwardRenderer>
+#include <Qt3DExtras/Qt3DWindow>
+#include <QDebug>
+
+ViewLayout::ViewLayout(Qt3DExtras::Qt3DWindow* window, Qt3DCore::QEntity* rootEntity, QObject* parent)
+    : QObject(parent)
+    , m_window(window)
+    , m_rootEntity(rootEntity)
+    , m_clearBuffers(nullptr)
+    , m_layout(Single)
+    , m_activePane(0)
+{
+    m_panes.resize(MaxPanes);
+    for (Pane& pane : m_panes) {
+        pane.camera = new Qt3DRender::QCamera(m_rootEntity);
+        pane.controller = std::make_unique<ViewportController>(pane.camera);
+        pane.overlayLayer = new Qt3DRender::QLayer(m_rootEntity);
+
+        const ViewportSettings* settings = pane.controller->settings();
+        pane.camera->lens()->setPerspectiveProjection(settings->fieldOfView(), 16.0f / 9.0f,
+                                                      settings->nearPlane(), settings->farPlane());
+    }
+
+    // Blender's quad view: perspective, top, front, right
+    m_panes[1].controller->viewTop();
+    m_panes[2].controller->viewFront();
+    m_panes[3].controller->viewRight();
+
+    buildFrameGraph();
+
+    connect(m_window, &QWindow::widthChanged, this, &ViewLayout::updateGeometry);
+    connect(m_window, &QWindow::heightChanged, this, &ViewLayout::updateGeometry);
+    setLayout(Single);
+}
+
+ViewLayout::~ViewLayout() = default;
+
+void ViewLayout::buildFrameGraph()
+{
+    // Surface -> clear once -> one branch per pane:
+    // viewport -> camera -> without other panes' overlays -> forward
+    // techniques (as QForwardRenderer) -> frustum culling
+    auto* surfaceSelector = new Qt3DRender::QRenderSurfaceSelector();
+    surfaceSelector->setSurface(m_window);
+
+    m_clearBuffers = new Qt3DRender::QClearBuffers(surfaceSelector);
+    m_clearBuffers->setBuffers(Qt3DRender::QClearBuffers::ColorDepthBuffer);
+    m_clearBuffers->setClearColor(m_window->defaultFrameGraph()->clearColor());
+    new Qt3DRender::QNoDraw(m_clearBuffers);
+
+    for (int i = 0; i < MaxPanes; ++i) {
+        Pane& pane = m_panes[i];
+        pane.viewport = new Qt3DRender::QViewport(surfaceSelector);
+
+        auto* cameraSelector = new Qt3DRender::QCameraSelector(pane.viewport);
+        cameraSelector->setCamera(pane.camera);
+
+        auto* layerFilter = new Qt3DRender::QLayerFilter(cameraSelector);
+        layerFilter->setFilterMode(Qt3DRender::QLayerFilter::DiscardAnyMatchingLayers);
+        for (int other = 0; other < MaxPanes; ++other) {
+            if (other != i) {
+                layerFilter->addLayer(m_panes[other].overlayLayer);
+            }
+        }
+
+        auto* techniqueFilter = new Qt3DRender::QTechniqueFilter(layerFilter);
+        auto* filterKey = new Qt3DRender::QFilterKey(techniqueFilter);
+        filterKey->setName(QStringLiteral("renderingStyle"));
+        filterKey->setValue(QStringLiteral("forward"));
+        techniqueFilter->addMatch(filterKey);
+
+        new Qt3DRender::QFrustumCulling(techniqueFilter);
+    }
+
+    m_window->setActiveFrameGraph(surfaceSelector);
+}
+
+void ViewLayout::setLayout(Layout layout)
+{
+    m_layout = layout;
+    const int count = paneCount();
+    for (int i = 0; i < MaxPanes; ++i) {
+        m_panes[i].viewport->setEnabled(i < count);
+    }
+
+    updateGeometry();
+    if (m_activePane >= count) {
+        setActivePane(0);
+    }
+    emit layoutChanged(m_layout);
+    qDebug() << "[ViewLayout] Showing" << count << "view(s)";
+}
+
+int ViewLayout::paneCount() const
+{
+    switch (m_layout) {
+    case Single: return 1;
+    case SideBySide:
+    case Stacked: return 2;
+    case Quad: return 4;
+    }
+    return 1;
+}
+
+void ViewLayout::setActivePane(int index)
+{
+    if (index < 0 || index >= paneCount() || index == m_activePane) {
+        return;
+    }
+    m_activePane = index;
+    emit activePaneChanged(m_activePane);
+}
+
+int ViewLayout::paneAt(const QPoint& windowPos) const
+{
+    for (int i = 0; i < paneCount(); ++i) {
+        if (paneRect(i).contains(windowPos)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+QRectF ViewLayout::normalizedPaneRect(int index) const
+{
+    switch (m_layout) {
+    case Single:
+        return QRectF(0.0, 0.0, 1.0, 1.0);
+    case SideBySide:
+        return QRectF(index * 0.5, 0.0, 0.5, 1.0);
+    case Stacked:
+        return QRectF(0.0, index * 0.5, 1.0, 0.5);
+    case Quad:
+        return QRectF((index % 2) * 0.5, (index / 2) * 0.5, 0.5, 0.5);
+    }
+    return QRectF(0.0, 0.0, 1.0, 1.0);
+}
+
+QRect ViewLayout::paneRect(int index) const
+{
+    // Round the edges, not the sizes, so neighbouring panes meet exactly
+    const QRectF r = normalizedPaneRect(index);
+    const int left = qRound(r.left() * m_window->width());
+    const int top = qRound(r.top() * m_window->height());
+    const int right = qRound(r.right() * m_window->width());
+    const int bottom = qRound(r.bottom() * m_window->height());
+    return QRect(left, top, right - left, bottom - top);
+}
+
+Qt3DRender::QCamera* ViewLayout::camera(int index) const
+{
+    return m_panes[index].camera;
+}
+
+ViewportController* ViewLayout::controller(int index) const
+{
+    return m_panes[index].controller.get();
+}
+
+Qt3DRender::QLayer* ViewLayout::overlayLayer(int index) const
+{
+    return m_panes[index].overlayLayer;
+}
+
+void ViewLayout::setClearColor(const QColor& color)
+{
+    m_clearBuffers->setClearColor(color);
+}
+
+void ViewLayout::updateGeometry()
+{
+    for (int i = 0; i < paneCount(); ++i) {
+        Pane& pane = m_panes[i];
+        const QRect rect = paneRect(i);
+        pane.viewport->setNormalizedRect(normalizedPaneRect(i));
+        if (!rect.isEmpty()) {
+            pane.camera->setAspectRatio(float(rect.width()) / rect.height());
+        }
+        pane.controller->setViewportSize(rect.size());
+    }
+    emit paneGeometryChanged();
+}
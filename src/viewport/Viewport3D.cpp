@@ -1,6 +1,7 @@
 #include "viewport/Viewport3D.h"
 #include "viewport/Custom3DWindow.h"
 #include "viewport/ViewportController.h"
+#include "viewport/ViewLayout.h"
 #include "viewport/ViewportSettings.h"
 #include "entities/GridEntity.h"
 #include "entities/AxisEntity.h"
@@ -9,12 +10,19 @@
 #include "scene/SelectionManager.h"
 #include "scene/SceneObject.h"
 #include "scene/BoxObject.h"
+#include "scene/ScenePicker.h"
+#include "scene/SceneFile.h"
+#include "viewport/ViewCuller.h"
+#include "viewport/FrameProfiler.h"
+#include "mesh/MeshData.h"
 #include "entities/CrosshairsOverlay.h"
 #include "entities/CrosshairsEntity3D.h"
+#include "entities/RenderStatsOverlay.h"
 
 #include <Qt3DCore/QTransform>
 #include <Qt3DRender/QCamera>
 #include <Qt3DRender/QDirectionalLight>
+#include <Qt3DRender/QRenderSettings>
 #include <Qt3DExtras/QPhongMaterial>
 #include <Qt3DExtras/QCuboidMesh>
 
@@ -22,16 +30,19 @@
 #include <QWidget>
 #include <QDebug>
 #include <QResizeEvent>
+#include <QLineF>
+#include <QSet>
+#include <limits>
 
 Viewport3D::Viewport3D(QWidget *parent)
     : QWidget(parent)
     , m_view(new Custom3DWindow())
     , m_rootEntity(new Qt3DCore::QEntity())
-    , m_controller(std::make_unique<ViewportController>(m_view->camera()))
+    , m_layout(std::make_unique<ViewLayout>(m_view, m_rootEntity))
     , m_grid(nullptr)
     , m_axis(nullptr)
     , m_crosshairs(nullptr)
-    , m_crosshairs3D(nullptr)
+    , m_statsOverlay(nullptr)
 {
     // Create container widget for our custom Qt3D window
     QWidget *container = QWidget::createWindowContainer(m_view);
@@ -48,27 +59,45 @@ Viewport3D::Viewport3D(QWidget *parent)
     qDebug() << "[Viewport3D] Crosshairs created with geometry:" << m_crosshairs->geometry()
              << "Viewport size:" << size();
 
+    // Render statistics in the top-left corner, hidden until requested
+    m_statsOverlay = new RenderStatsOverlay(this);
+    m_statsOverlay->move(10, 10);
+    m_statsOverlay->raise();
+
     m_view->setRootEntity(m_rootEntity);
 
-    // Connect our custom window's signals to our controller
+    // Connect our custom window's signals to the active view's controller
+    connect(m_view, &Custom3DWindow::pointerPressed, this, &Viewport3D::onPointerPressed);
     connect(m_view, &Custom3DWindow::orbitRequested, this, &Viewport3D::onOrbitRequested);
     connect(m_view, &Custom3DWindow::panRequested, this, &Viewport3D::onPanRequested);
     connect(m_view, &Custom3DWindow::zoomRequested, this, &Viewport3D::onZoomRequested);
+    connect(m_view, &Custom3DWindow::leftClicked, this, &Viewport3D::onViewportClicked);
+    connect(m_view, &Custom3DWindow::rectangleSelected, this, &Viewport3D::onRectangleSelected);
+    connect(m_view, &Custom3DWindow::keyPressed, this, &Viewport3D::onKeyPressed);
 
     // Connect fly mode signals
     qDebug() << "[Viewport3D] Connecting fly mode signals...";
-    connect(m_view, &Custom3DWindow::flyModeToggleRequested, m_controller.get(), &ViewportController::toggleFlyMode);
-    connect(m_view, &Custom3DWindow::keyPressed, m_controller.get(), &ViewportController::handleKeyPress);
-    connect(m_view, &Custom3DWindow::keyReleased, m_controller.get(), &ViewportController::handleKeyRelease);
-    connect(m_view, &Custom3DWindow::mouseLookRequested, m_controller.get(), &ViewportController::handleMouseLook);
+    connect(m_view, &Custom3DWindow::flyModeToggleRequested, this, [this]() { controller()->toggleFlyMode(); });
+    connect(m_view, &Custom3DWindow::keyPressed, this, [this](int key) { controller()->handleKeyPress(key); });
+    connect(m_view, &Custom3DWindow::keyReleased, this, [this](int key) { controller()->handleKeyRelease(key); });
+    connect(m_view, &Custom3DWindow::mouseLookRequested, this, [this](int dx, int dy) { controller()->handleMouseLook(dx, dy); });
+
+    for (int i = 0; i < ViewLayout::MaxPanes; ++i) {
+        ViewportController* paneController = m_layout->controller(i);
 
-    // Update Custom3DWindow fly mode state when controller toggles it
-    connect(m_controller.get(), &ViewportController::flyModeToggled, m_view, &Custom3DWindow::setFlyMode);
+        // Update Custom3DWindow fly mode state when controller toggles it
+        connect(paneController, &ViewportController::flyModeToggled, m_view, &Custom3DWindow::setFlyMode);
 
-    // Update crosshairs visibility when fly mode toggles
-    connect(m_controller.get(), &ViewportController::flyModeToggled, this, &Viewport3D::onFlyModeToggled);
+        // Update crosshairs visibility when fly mode toggles
+        connect(paneController, &ViewportController::flyModeToggled, this,
+                [this, i](bool active) { onFlyModeToggled(i, active); });
+    }
     qDebug() << "[Viewport3D] Fly mode signals connected";
 
+    // Picking and culling follow the shown views
+    connect(m_layout.get(), &ViewLayout::paneGeometryChanged, this, &Viewport3D::updateViews);
+    connect(m_layout.get(), &ViewLayout::activePaneChanged, this, &Viewport3D::onActivePaneChanged);
+
     setupScene();
 }
 
@@ -76,12 +105,27 @@ Viewport3D::~Viewport3D() = default;
 
 Qt3DRender::QCamera* Viewport3D::camera() const
 {
-    return m_view->camera();
+    return m_layout->activeCamera();
+}
+
+ViewportController* Viewport3D::controller() const
+{
+    return m_layout->activeController();
 }
 
 ViewportSettings* Viewport3D::settings() const
 {
-    return m_controller->settings();
+    // Display settings are shared; the first view's controller holds them
+    return m_layout->controller(0)->settings();
+}
+
+void Viewport3D::setViewLayout(ViewLayout::Layout layout)
+{
+    // Leave fly mode first: it owns the mouse of the view it was started in
+    if (controller()->isFlyModeActive()) {
+        controller()->toggleFlyMode();
+    }
+    m_layout->setLayout(layout);
 }
 
 bool Viewport3D::eventFilter(QObject *obj, QEvent *event)
@@ -91,21 +135,18 @@ bool Viewport3D::eventFilter(QObject *obj, QEvent *event)
 
 void Viewport3D::setupScene()
 {
-    // Camera setup with proper settings
-    ViewportSettings *settings = m_controller->settings();
-    Qt3DRender::QCamera *camera = m_view->camera();
-    camera->lens()->setPerspectiveProjection(
-        settings->fieldOfView(),
-        16.0f/9.0f,
-        settings->nearPlane(),
-        settings->farPlane()
-    );
+    // Each view's camera lens is set up by ViewLayout
+    ViewportSettings *settings = this->settings();
 
     // Camera position is now managed by ViewportController
     // No manual camera positioning needed - ViewportController sets it via spherical coords
 
     // Set background color (dark gray like Blender) - will be implemented differently
 
+    // Continuous or on-demand rendering (see ViewportSettings::RenderPolicy)
+    applyRenderPolicy();
+    connect(settings, &ViewportSettings::renderPolicyChanged, this, &Viewport3D::applyRenderPolicy);
+
     // Setup scene elements
     setupLighting();
     setupGrid();
@@ -117,18 +158,22 @@ void Viewport3D::setupScene()
 
 void Viewport3D::setupCrosshairs()
 {
-    // Create Qt3D-based crosshairs entity
-    // Attach to camera so crosshairs always stay centered
-    m_crosshairs3D = new CrosshairsEntity3D(m_view->camera());
-
-    // Position crosshairs in front of camera (in camera space)
-    auto* transform = new Qt3DCore::QTransform(m_crosshairs3D);
-    transform->setTranslation(QVector3D(0, 0, -1.0f));  // 1 unit in front of camera
-    m_crosshairs3D->addComponent(transform);
-
-    m_crosshairs3D->setVisible(false);  // Hidden by default
+    // Qt3D crosshairs per view, attached to its camera so they stay
+    // centered and tagged with its overlay layer so only that view draws them
+    for (int i = 0; i < ViewLayout::MaxPanes; ++i) {
+        auto* crosshairs = new CrosshairsEntity3D(m_layout->camera(i));
+        crosshairs->setLayer(m_layout->overlayLayer(i));
+
+        // Position crosshairs in front of camera (in camera space)
+        auto* transform = new Qt3DCore::QTransform(crosshairs);
+        transform->setTranslation(QVector3D(0, 0, -1.0f));  // 1 unit in front of camera
+        crosshairs->addComponent(transform);
+
+        crosshairs->setVisible(false);  // Hidden by default
+        m_crosshairs3D.append(crosshairs);
+    }
 
-    qDebug() << "[Viewport3D] Created Qt3D crosshairs entity";
+    qDebug() << "[Viewport3D] Created Qt3D crosshairs entities";
 }
 
 void Viewport3D::setupLighting()
@@ -162,7 +207,7 @@ void Viewport3D::setupGrid()
 {
     if (!m_grid) {
         m_grid = new GridEntity(m_rootEntity);
-        ViewportSettings *settings = m_controller->settings();
+        ViewportSettings *settings = this->settings();
         m_grid->setGridSize(settings->gridSize());
         m_grid->setGridDivisions(settings->gridDivisions());
         m_grid->setColor(settings->gridColor());
@@ -174,7 +219,7 @@ void Viewport3D::setupAxis()
 {
     if (!m_axis) {
         m_axis = new AxisEntity(m_rootEntity);
-        ViewportSettings *settings = m_controller->settings();
+        ViewportSettings *settings = this->settings();
         m_axis->setLength(settings->axisLength());
         m_axis->setThickness(settings->axisThickness());
         m_axis->setVisible(settings->showAxis());
@@ -188,9 +233,27 @@ void Viewport3D::setupObjectSystem()
     m_objectManager = std::make_unique<ObjectManager>(m_rootEntity, this);
     m_selectionManager = std::make_unique<SelectionManager>(this);
 
-    // Connect ObjectManager signals to handle new objects
-    connect(m_objectManager.get(), &ObjectManager::objectAdded,
-            this, &Viewport3D::onObjectAdded);
+    // screenToWorld ray-casts against all objects
+    m_picker = std::make_unique<ScenePicker>(m_objectManager.get(), this);
+    for (int i = 0; i < ViewLayout::MaxPanes; ++i) {
+        m_layout->controller(i)->setPicker(m_picker.get());
+    }
+
+    // Click and rectangle selection read back the GPU ID pass
+    m_pickIdPass = std::make_unique<PickIdPass>(m_view, m_objectManager.get(), this);
+    connect(m_pickIdPass.get(), &PickIdPass::pickCompleted, this, &Viewport3D::onPickCompleted);
+    connect(m_modeManager.get(), &ModeManager::modeChanged, this, &Viewport3D::updatePickEditObject);
+    connect(m_modeManager.get(), &ModeManager::activeObjectChanged, this, &Viewport3D::updatePickEditObject);
+
+    // Skip objects outside the view; draw distant large meshes simplified
+    m_viewCuller = std::make_unique<ViewCuller>(m_objectManager.get(), this);
+    m_viewCuller->setEnabled(settings()->viewCulling());
+    m_viewCuller->setLodPixelError(settings()->lodPixelError());
+    updateViews();
+
+    m_frameProfiler = std::make_unique<FrameProfiler>(m_rootEntity, m_viewCuller.get(), this);
+    connect(m_frameProfiler.get(), &FrameProfiler::sampleReady, m_statsOverlay, &RenderStatsOverlay::setSample);
+    connect(m_frameProfiler.get(), &FrameProfiler::runningChanged, this, &Viewport3D::applyRenderPolicy);
 
     qDebug() << "Object system initialized";
 }
@@ -214,8 +277,58 @@ void Viewport3D::deleteSelected()
     }
 
     QVector<SceneObject*> selected = m_selectionManager->selectedObjects();
-    for (SceneObject* obj : selected) {
-        m_objectManager->removeObject(obj);
+    m_selectionManager->clearSelection();
+    m_objectManager->removeObjects(selected);
+}
+
+void Viewport3D::setStatsOverlayVisible(bool visible)
+{
+    m_statsOverlay->setVisible(visible);
+    m_statsOverlay->raise();
+    if (m_frameProfiler) {
+        m_frameProfiler->setActive(visible);
+    }
+}
+
+bool Viewport3D::isStatsOverlayVisible() const
+{
+    return m_statsOverlay->isVisible();
+}
+
+void Viewport3D::frameAll()
+{
+    if (!m_objectManager) {
+        return;
+    }
+    controller()->frameBounds(m_objectManager->sceneBounds());
+}
+
+void Viewport3D::frameSelected()
+{
+    if (!m_selectionManager) {
+        return;
+    }
+
+    // Nothing selected: frame the whole scene instead
+    const BoundingBox bounds = ObjectManager::boundsOf(m_selectionManager->selectedObjects());
+    if (bounds.isEmpty()) {
+        frameAll();
+        return;
+    }
+    controller()->frameBounds(bounds);
+}
+
+void Viewport3D::onKeyPressed(int key)
+{
+    // Fly mode owns the camera while active
+    if (controller()->isFlyModeActive()) {
+        return;
+    }
+
+    if (key == Qt::Key_Home) {
+        frameAll();
+    } else if (key == Qt::Key_Period) {
+        frameSelected();
     }
 }
 
@@ -243,14 +356,8 @@ void Viewport3D::createTestCube()
     floorEntity->addComponent(floorMaterial);
     floorEntity->addComponent(floorTransform);
 
-    // Create test boxes using new object system
-    SceneObject* box1 = m_objectManager->createBox(QVector3D(2, 2, 2));
-    box1->setLocation(QVector3D(0, 1, 0));
-    box1->setName("Cube");
-
-    SceneObject* box2 = m_objectManager->createBox(QVector3D(1.5, 3, 1));
-    box2->setLocation(QVector3D(3, 1.5, 0));
-    box2->setName("Tall Box");
+    // Default objects (shared with headless renders)
+    SceneFile::createDefault(m_objectManager.get());
 
     qDebug() << "Test scene created with" << m_objectManager->objectCount() << "objects";
 }
@@ -261,8 +368,8 @@ void Viewport3D::onOrbitRequested(int deltaX, int deltaY)
     QPoint currentPos(deltaX, deltaY);
     QPoint lastPos(0, 0);
 
-    m_controller->startOrbit(lastPos);
-    m_controller->orbit(currentPos);
+    controller()->startOrbit(lastPos);
+    controller()->orbit(currentPos);
 }
 
 void Viewport3D::onPanRequested(int deltaX, int deltaY)
@@ -271,49 +378,260 @@ void Viewport3D::onPanRequested(int deltaX, int deltaY)
     QPoint currentPos(deltaX, deltaY);
     QPoint lastPos(0, 0);
 
-    m_controller->startPan(lastPos);
-    m_controller->pan(currentPos);
+    controller()->startPan(lastPos);
+    controller()->pan(currentPos);
 }
 
 void Viewport3D::onZoomRequested(float delta)
 {
-    m_controller->zoom(delta);
+    controller()->zoom(delta);
+}
+
+void Viewport3D::onPointerPressed(const QPoint& pos)
+{
+    // Navigation goes to the view under the cursor, except during fly mode
+    if (controller()->isFlyModeActive()) {
+        return;
+    }
+    const int pane = m_layout->paneAt(pos);
+    if (pane != -1) {
+        m_layout->setActivePane(pane);
+    }
+}
+
+void Viewport3D::onActivePaneChanged(int index)
+{
+    qDebug() << "[Viewport3D] Active view:" << index;
+    updateViews();
+}
+
+void Viewport3D::updateViews()
+{
+    // Picks render from the active view, into its area of the window
+    const int active = m_layout->activePane();
+    if (m_pickIdPass) {
+        m_pickIdPass->setView(m_layout->camera(active), m_layout->normalizedPaneRect(active));
+    }
+
+    if (m_viewCuller) {
+        QVector<ViewCuller::View> views;
+        for (int i = 0; i < m_layout->paneCount(); ++i) {
+            views.append({m_layout->camera(i), m_layout->paneRect(i).size()});
+        }
+        m_viewCuller->setViews(views);
+    }
 }
 
-void Viewport3D::onObjectClicked(SceneObject* object)
+void Viewport3D::onViewportClicked(const QPoint& pos, Qt::KeyboardModifiers modifiers)
 {
-    if (!object || !m_selectionManager) {
+    if (!m_pickIdPass) {
         return;
     }
 
-    qDebug() << "Viewport received click on object:" << object->name();
+    // A few pixels around the cursor so thin parts are easy to hit; the
+    // pass orders hits by distance to the centre
+    constexpr int ClickRadius = 3;
+    const QRect region = QRect(pos - QPoint(ClickRadius, ClickRadius), QSize(2 * ClickRadius + 1, 2 * ClickRadius + 1))
+                             .intersected(m_layout->paneRect(m_layout->activePane()));
+    const int requestId = m_pickIdPass->requestPick(region);
+    if (requestId != -1) {
+        m_pendingPicks.insert(requestId, {false, modifiers});
+    }
+}
 
-    // TODO: Check for Shift modifier for multi-select
-    // For now, single selection only
-    m_selectionManager->selectObject(object, false);
+void Viewport3D::onRectangleSelected(const QRect& rect, Qt::KeyboardModifiers modifiers)
+{
+    if (!m_pickIdPass) {
+        return;
+    }
+
+    // A drag that leaves the active view selects within it only
+    const QRect viewRect = rect.intersected(m_layout->paneRect(m_layout->activePane()));
+    if (viewRect.isEmpty()) {
+        return;
+    }
+    const int requestId = m_pickIdPass->requestPick(viewRect);
+    if (requestId != -1) {
+        m_pendingPicks.insert(requestId, {true, modifiers});
+    }
 }
 
-void Viewport3D::onObjectAdded(SceneObject* object)
+void Viewport3D::onPickCompleted(int requestId, const PickIdPass::Result& result)
 {
-    if (!object) {
+    auto it = m_pendingPicks.find(requestId);
+    if (it == m_pendingPicks.end() || !m_selectionManager) {
         return;
     }
+    const PendingPick pending = *it;
+    m_pendingPicks.erase(it);
 
-    // Connect the object's clicked signal to our handler
-    connect(object, &SceneObject::clicked, this, &Viewport3D::onObjectClicked);
-    qDebug() << "Connected click handler for object:" << object->name();
+    const bool extend = pending.modifiers & Qt::ShiftModifier;
+
+    if (result.editObject) {
+        selectPickedElements(result, pending.isRectangle, extend);
+        return;
+    }
+
+    if (!pending.isRectangle) {
+        // Clicking empty space keeps the selection
+        if (!result.objects.isEmpty()) {
+            m_selectionManager->selectObject(result.objects.first(), extend);
+        }
+        return;
+    }
+
+    if (result.objects.isEmpty() && !extend) {
+        m_selectionManager->clearSelection();
+    } else {
+        m_selectionManager->selectObjects(result.objects, extend);
+    }
 }
 
-void Viewport3D::onFlyModeToggled(bool active)
+void Viewport3D::updatePickEditObject()
 {
-    qDebug() << "[Viewport3D::onFlyModeToggled] Fly mode toggled! Active:" << active;
+    SceneObject* editObject = m_modeManager->isEditMode() ? m_modeManager->activeObject() : nullptr;
+    if (m_pickIdPass) {
+        m_pickIdPass->setEditObject(editObject);
+    }
+    if (m_viewCuller) {
+        m_viewCuller->setEditObject(editObject);
+    }
+}
+
+QPointF Viewport3D::projectToView(const QVector3D& worldPos) const
+{
+    // Into the active view's area of the window
+    Qt3DRender::QCamera* cam = camera();
+    const QRect pane = m_layout->paneRect(m_layout->activePane());
+    const QRect viewport(pane.x(), 0, pane.width(), pane.height());
+    const QVector3D windowPos = worldPos.project(cam->viewMatrix(), cam->projectionMatrix(), viewport);
+    return QPointF(windowPos.x(), pane.y() + pane.height() - windowPos.y());
+}
+
+void Viewport3D::selectPickedElements(const PickIdPass::Result& result, bool isRectangle, bool extend)
+{
+    SceneObject* object = result.editObject;
+    const MeshData* mesh = object->meshData();
+    const QMatrix4x4 toWorld = object->transformMatrix();
+    const QPointF clickPos = QRectF(result.rect).center();
+
+    auto vertexPos = [&](int index) {
+        const MeshData::Vertex* vertex = mesh->findVertex(index);
+        return vertex ? projectToView(toWorld.map(vertex->position)) : QPointF(-1e9, -1e9);
+    };
+
+    // Only elements of faces visible in the region count, so a rectangle
+    // does not reach through the mesh to hidden vertices
+    QVector<int> picked;
+    switch (m_selectionManager->mode()) {
+    case SelectionManager::FaceSelection:
+        if (isRectangle) {
+            picked = result.faces;
+        } else if (!result.faces.isEmpty()) {
+            picked.append(result.faces.first());
+            emit faceSelected(result.faces.first());
+        }
+        break;
+
+    case SelectionManager::VertexSelection: {
+        QSet<int> seen;
+        int nearest = -1;
+        qreal nearestDistance = std::numeric_limits<qreal>::max();
+        for (int faceIndex : result.faces) {
+            const MeshData::Face* face = mesh->findFace(faceIndex);
+            if (!face) continue;
+            for (int v : face->vertices) {
+                const QPointF p = vertexPos(v);
+                if (isRectangle) {
+                    if (!seen.contains(v) && QRectF(result.rect).contains(p)) {
+                        seen.insert(v);
+                        picked.append(v);
+                    }
+                } else {
+                    const qreal d = QLineF(p, clickPos).length();
+                    if (d < nearestDistance) {
+                        nearestDistance = d;
+                        nearest = v;
+                    }
+                }
+            }
+            if (!isRectangle) break;  // Front-most face only
+        }
+        if (nearest != -1) {
+            picked.append(nearest);
+        }
+        break;
+    }
+
+    case SelectionManager::EdgeSelection: {
+        QSet<int> seen;
+        int nearest = -1;
+        qreal nearestDistance = std::numeric_limits<qreal>::max();
+        for (int faceIndex : result.faces) {
+            const MeshData::Face* face = mesh->findFace(faceIndex);
+            if (!face) continue;
+            for (int edgeIndex : face->edges) {
+                const int slot = mesh->edgeSlot(edgeIndex);
+                if (slot == -1 || seen.contains(edgeIndex)) continue;
+                const MeshData::Edge& edge = mesh->getEdges()[slot];
+                const QPointF a = vertexPos(edge.v0);
+                const QPointF b = vertexPos(edge.v1);
+                if (isRectangle) {
+                    if (QRectF(result.rect).contains(a) && QRectF(result.rect).contains(b)) {
+                        seen.insert(edgeIndex);
+                        picked.append(edgeIndex);
+                    }
+                } else {
+                    // Distance from the click to the edge segment
+                    const QPointF ab = b - a;
+                    const qreal lengthSq = QPointF::dotProduct(ab, ab);
+                    const qreal t = lengthSq > 0.0 ? qBound(0.0, QPointF::dotProduct(clickPos - a, ab) / lengthSq, 1.0) : 0.0;
+                    const qreal d = QLineF(a + ab * t, clickPos).length();
+                    if (d < nearestDistance) {
+                        nearestDistance = d;
+                        nearest = edgeIndex;
+                    }
+                }
+            }
+            if (!isRectangle) break;  // Front-most face only
+        }
+        if (nearest != -1) {
+            picked.append(nearest);
+        }
+        break;
+    }
+
+    default:
+        return;
+    }
+
+    if (picked.isEmpty()) {
+        if (isRectangle && !extend) {
+            m_selectionManager->clearVertexSelection();
+            m_selectionManager->clearEdgeSelection();
+            m_selectionManager->clearFaceSelection();
+        }
+        return;
+    }
+
+    switch (m_selectionManager->mode()) {
+    case SelectionManager::VertexSelection: m_selectionManager->selectVertices(picked, extend); break;
+    case SelectionManager::EdgeSelection:   m_selectionManager->selectEdges(picked, extend); break;
+    case SelectionManager::FaceSelection:   m_selectionManager->selectFaces(picked, extend); break;
+    default: break;
+    }
+}
+
+void Viewport3D::onFlyModeToggled(int pane, bool active)
+{
+    qDebug() << "[Viewport3D::onFlyModeToggled] Fly mode toggled in view" << pane << "Active:" << active;
 
     // Toggle Qt3D crosshairs (proper solution)
-    if (m_crosshairs3D) {
-        m_crosshairs3D->setVisible(active);
+    if (pane < m_crosshairs3D.size()) {
+        m_crosshairs3D[pane]->setVisible(active);
         qDebug() << "  Qt3D crosshairs visibility set to:" << active;
     } else {
-        qDebug() << "  WARNING: m_crosshairs3D is null!";
+        qDebug() << "  WARNING: no crosshairs for view" << pane;
     }
 
     // Old widget-based crosshairs (doesn't work with createWindowContainer, kept for reference)
@@ -322,10 +640,25 @@ void Viewport3D::onFlyModeToggled(bool active)
     }
 }
 
+void Viewport3D::applyRenderPolicy()
+{
+    // On demand, Qt3D renders only after a frontend node changed: camera
+    // moves from ViewportController, object transforms, geometry buffer
+    // updates and the material swaps done on selection all qualify.
+    // The frame profiler needs a rendered frame per sample.
+    const bool profiling = m_frameProfiler && m_frameProfiler->isRunning();
+    const bool onDemand = settings()->renderPolicy() == ViewportSettings::OnDemand && !profiling;
+    m_view->renderSettings()->setRenderPolicy(onDemand ? Qt3DRender::QRenderSettings::OnDemand
+                                                       : Qt3DRender::QRenderSettings::Always);
+    qDebug() << "[Viewport3D] Render policy:" << (onDemand ? "on demand" : "continuous");
+}
+
 void Viewport3D::resizeEvent(QResizeEvent *event)
 {
     QWidget::resizeEvent(event);
 
+    // View sizes follow the window through ViewLayout::paneGeometryChanged
+
     // Update crosshairs to match new size (now it's a direct child of this widget)
     if (m_crosshairs) {
         m_crosshairs->setGeometry(0, 0, width(), height());
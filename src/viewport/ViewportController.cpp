@@ -1,5 +1,7 @@
 #include "viewport/ViewportController.h"
 #include "viewport/ViewportSettings.h"
+#include "scene/ScenePicker.h"
+#include "mesh/BoundingBox.h"
 
 #include <Qt3DRender/QCamera>
 #include <Qt3DInput/QMouseDevice>
@@ -9,12 +11,14 @@
 #include <QMouseEvent>
 #include <QWheelEvent>
 #include <QtMath>
+#include <cmath>
 #include <QDebug>
 
 ViewportController::ViewportController(Qt3DRender::QCamera *camera, QObject *parent)
     : QObject(parent)
     , m_camera(camera)
     , m_settings(std::make_unique<ViewportSettings>())
+    , m_picker(nullptr)
     , m_navigationMode(Orbit)
     , m_orbitSpeed(0.5f)
     , m_panSpeed(0.01f)
@@ -27,14 +31,17 @@ ViewportController::ViewportController(Qt3DRender::QCamera *camera, QObject *par
     , m_middleMousePressed(false)
     , m_activeButton(Qt::NoButton)
     , m_flyModeActive(false)
+    , m_flyUpdatePending(false)
     , m_flySpeed(5.0f)  // 5 units per second
     , m_flyMouseSensitivity(0.15f)
     , m_yaw(45.0f)
     , m_pitch(35.264f)
     , m_flyPosition(10, 10, 10)
 {
-    // Setup fly mode timer for continuous movement
+    // Fly mode timer: only paces input sampling while keys are held; the
+    // distance moved comes from the measured frame time (m_flyClock)
     m_flyModeTimer = new QTimer(this);
+    m_flyModeTimer->setTimerType(Qt::PreciseTimer);
     m_flyModeTimer->setInterval(16);  // ~60 FPS
     connect(m_flyModeTimer, &QTimer::timeout, this, &ViewportController::updateFlyCamera);
 
@@ -132,11 +139,27 @@ void ViewportController::focusOnPoint(const QVector3D &point)
     updateCameraPosition();
 }
 
-void ViewportController::frameAll()
+void ViewportController::frameBounds(const BoundingBox &bounds)
 {
-    // TODO: Calculate bounding box of all objects and fit camera
-    m_radius = 10.0f;
-    m_target = QVector3D(0, 0, 0);
+    if (!m_camera) return;
+
+    if (bounds.isEmpty()) {
+        m_radius = 10.0f;
+        m_target = QVector3D(0, 0, 0);
+        updateCameraPosition();
+        return;
+    }
+
+    // Fit the bounding sphere into the narrower of the two fields of view
+    const float sphereRadius = qMax(bounds.size().length() * 0.5f, 0.05f);
+    const float halfFovY = qDegreesToRadians(m_camera->fieldOfView()) * 0.5f;
+    const float aspect = m_camera->aspectRatio() > 0.0f ? m_camera->aspectRatio() : 1.0f;
+    const float halfFovX = std::atan(std::tan(halfFovY) * aspect);
+    const float halfFov = qMin(halfFovY, halfFovX);
+
+    const float margin = 1.1f;
+    m_target = bounds.center();
+    m_radius = qBound(0.1f, sphereRadius / std::sin(halfFov) * margin, 1000.0f);
     updateCameraPosition();
 }
 
@@ -182,6 +205,13 @@ void ViewportController::viewBottom()
     updateCameraPosition();
 }
 
+void ViewportController::viewIsometric()
+{
+    m_azimuth = 45.0f;
+    m_elevation = 35.264f;
+    updateCameraPosition();
+}
+
 void ViewportController::updateCameraPosition()
 {
     if (!m_camera) return;
@@ -252,10 +282,33 @@ bool ViewportController::eventFilter(QObject *obj, QEvent *event)
     return QObject::eventFilter(obj, event);
 }
 
-QVector3D ViewportController::screenToWorld(const QPoint &screenPos)
+QVector3D ViewportController::screenToWorld(const QPoint &screenPos) const
 {
-    // TODO: Implement screen to world coordinate conversion
-    return QVector3D();
+    if (!m_camera || m_viewportSize.isEmpty()) {
+        return m_target;
+    }
+
+    const Ray ray = ScenePicker::screenRay(m_camera, screenPos, m_viewportSize);
+
+    if (m_picker) {
+        const ScenePicker::Hit hit = m_picker->pick(ray);
+        if (hit.isValid()) {
+            return hit.position;
+        }
+    }
+
+    // Ground plane, if the ray points down onto it
+    if (ray.direction.y() < 0.0f && ray.origin.y() > 0.0f) {
+        return ray.at(-ray.origin.y() / ray.direction.y());
+    }
+
+    // Plane through the orbit target, facing the camera
+    const QVector3D normal = m_camera->viewVector().normalized();
+    const float denom = QVector3D::dotProduct(ray.direction, normal);
+    if (qFuzzyIsNull(denom)) {
+        return m_target;
+    }
+    return ray.at(QVector3D::dotProduct(m_target - ray.origin, normal) / denom);
 }
 
 void ViewportController::toggleFlyMode()
@@ -280,8 +333,9 @@ void ViewportController::toggleFlyMode()
         qDebug() << "  Initial position:" << m_flyPosition;
         qDebug() << "  Initial yaw:" << m_yaw << "pitch:" << m_pitch;
 
-        // Start the update timer
-        m_flyModeTimer->start();
+        // Movement starts with the first key press
+        m_pendingLook = QPoint();
+        m_flyClock.start();
 
     } else {
         qDebug() << "  FLY MODE DEACTIVATED";
@@ -289,8 +343,9 @@ void ViewportController::toggleFlyMode()
         // Stop the update timer
         m_flyModeTimer->stop();
 
-        // Clear pressed keys
+        // Clear pressed keys and unapplied input
         m_pressedKeys.clear();
+        m_pendingLook = QPoint();
 
         // Return to orbit mode - recalculate spherical coordinates from current position
         QVector3D pos = m_camera->position();
@@ -317,12 +372,19 @@ void ViewportController::handleKeyPress(int key)
     if (!m_flyModeActive) return;
 
     m_pressedKeys.insert(key);
+
+    // Start moving; the first step covers only time from now on
+    if (hasFlyMovementKeys() && !m_flyModeTimer->isActive()) {
+        m_flyClock.restart();
+        m_flyModeTimer->start();
+    }
 }
 
 void ViewportController::handleKeyRelease(int key)
 {
     if (!m_flyModeActive) return;
 
+    // The timer stops itself on the next update once no movement key is held
     m_pressedKeys.remove(key);
 }
 
@@ -330,56 +392,56 @@ void ViewportController::handleMouseLook(int deltaX, int deltaY)
 {
     if (!m_flyModeActive || !m_camera) return;
 
-    // Update yaw (horizontal) and pitch (vertical)
-    m_yaw -= deltaX * m_flyMouseSensitivity;
-    m_pitch += deltaY * m_flyMouseSensitivity;
-
-    // Clamp pitch to prevent camera flipping
-    m_pitch = qBound(-89.0f, m_pitch, 89.0f);
-
-    // Normalize yaw to 0-360 range
-    while (m_yaw < 0.0f) m_yaw += 360.0f;
-    while (m_yaw >= 360.0f) m_yaw -= 360.0f;
-
-    // Update camera orientation IMMEDIATELY for responsive mouse look
-    updateFlyCameraOrientation();
+    // Coalesce all mouse moves of one frame into a single camera update
+    m_pendingLook += QPoint(deltaX, deltaY);
+    if (!m_flyModeTimer->isActive()) {
+        scheduleFlyUpdate();
+    }
 }
 
-void ViewportController::updateFlyCameraOrientation()
+void ViewportController::scheduleFlyUpdate()
 {
-    if (!m_flyModeActive || !m_camera) return;
-
-    // Calculate camera direction vectors from yaw and pitch
-    float yawRad = qDegreesToRadians(m_yaw);
-    float pitchRad = qDegreesToRadians(m_pitch);
-
-    // Forward vector (direction camera is looking)
-    QVector3D forward(
-        qSin(yawRad) * qCos(pitchRad),
-        -qSin(pitchRad),
-        qCos(yawRad) * qCos(pitchRad)
-    );
-    forward.normalize();
-
-    // Update camera view center (where it's looking)
-    // View center is always 1 unit in front of the camera position
-    QVector3D viewCenter = m_flyPosition + forward;
-    m_camera->setViewCenter(viewCenter);
-
-    // Keep up vector as world up
-    m_camera->setUpVector(QVector3D(0, 1, 0));
+    if (!m_flyUpdatePending) {
+        m_flyUpdatePending = true;
+        QMetaObject::invokeMethod(this, &ViewportController::updateFlyCamera, Qt::QueuedConnection);
+    }
+}
 
-    emit cameraChanged();
+bool ViewportController::hasFlyMovementKeys() const
+{
+    static const int movementKeys[] = { Qt::Key_W, Qt::Key_S, Qt::Key_A, Qt::Key_D, Qt::Key_E, Qt::Key_Q };
+    for (int key : movementKeys) {
+        if (m_pressedKeys.contains(key)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void ViewportController::updateFlyCamera()
 {
+    m_flyUpdatePending = false;
     if (!m_flyModeActive || !m_camera) return;
 
-    // Calculate movement delta based on time
-    float deltaTime = m_flyModeTimer->interval() / 1000.0f;  // Convert ms to seconds
+    // Real elapsed time, clamped so a stall (window drag, breakpoint)
+    // does not teleport the camera
+    float deltaTime = qMin(m_flyClock.restart() / 1000.0f, 0.1f);
     float moveAmount = m_flySpeed * deltaTime;
 
+    // Apply mouse look accumulated since the last update
+    if (!m_pendingLook.isNull()) {
+        m_yaw -= m_pendingLook.x() * m_flyMouseSensitivity;
+        m_pitch += m_pendingLook.y() * m_flyMouseSensitivity;
+        m_pendingLook = QPoint();
+
+        // Clamp pitch to prevent camera flipping
+        m_pitch = qBound(-89.0f, m_pitch, 89.0f);
+
+        // Normalize yaw to 0-360 range
+        m_yaw = std::fmod(m_yaw, 360.0f);
+        if (m_yaw < 0.0f) m_yaw += 360.0f;
+    }
+
     // Calculate camera direction vectors
     float yawRad = qDegreesToRadians(m_yaw);
     float pitchRad = qDegreesToRadians(m_pitch);
@@ -418,9 +480,14 @@ void ViewportController::updateFlyCamera()
         m_flyPosition -= worldUp * moveAmount;  // Down along world Y-axis
     }
 
-    // Update camera position
+    // One camera change per frame: position, then view center 1 unit ahead
     m_camera->setPosition(m_flyPosition);
+    m_camera->setViewCenter(m_flyPosition + forward);
+    m_camera->setUpVector(worldUp);
+
+    emit cameraChanged();
 
-    // Update camera orientation (view center based on current yaw/pitch)
-    updateFlyCameraOrientation();
-}
\ No newline at end of file
+    if (!hasFlyMovementKeys()) {
+        m_flyModeTimer->stop();
+    }
+}
@@ -14,6 +14,9 @@ ViewportSettings::ViewportSettings(QObject *parent)
     , m_panSensitivity(1.0f)
     , m_orbitSensitivity(1.0f)
     , m_zoomSensitivity(1.0f)
+    , m_renderPolicy(OnDemand)  // Idle viewport costs no CPU/GPU during solver runs
+    , m_viewCulling(true)
+    , m_lodPixelError(1.0f)
     , m_backgroundColor(60, 60, 60)
     , m_nearPlane(0.01f)
     , m_farPlane(10000.0f)
@@ -81,4 +84,12 @@ void ViewportSettings::setBackgroundColor(const QColor &color)
         m_backgroundColor = color;
         emit backgroundColorChanged();
     }
-}
\ No newline at end of file
+}
+
+void ViewportSettings::setRenderPolicy(RenderPolicy policy)
+{
+    if (m_renderPolicy != policy) {
+        m_renderPolicy = policy;
+        emit renderPolicyChanged();
+    }
+}
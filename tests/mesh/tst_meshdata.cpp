@@ -0,0 +1,129 @@
+#include "mesh/MeshData.h"
+#include "mesh/HalfEdgeMesh.h"
+
+#include <QtTest>
+
+/**
+ * @brief MeshData vertex removal with cached half-edge topology
+ *
+ * Removal walks the half-edge adjacency when it is cached. On non-manifold
+ * meshes that walk misses faces, so every face referencing a removed
+ * vertex must still go.
+ */
+class TestMeshData : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void removeVertexManifold();
+    void removePinchedVertex();
+    void removeClosedPinchedVertex();
+    void removeVertexOnSharedEdge();
+
+private:
+    static bool referencesVertex(const MeshData& mesh, int vertex);
+};
+
+bool TestMeshData::referencesVertex(const MeshData& mesh, int vertex)
+{
+    for (const MeshData::Face& face : mesh.getFaces()) {
+        if (face.vertices.contains(vertex)) {
+            return true;
+        }
+    }
+    for (const MeshData::Edge& edge : mesh.getEdges()) {
+        if (edge.v0 == vertex || edge.v1 == vertex) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TestMeshData::removeVertexManifold()
+{
+    // Closed tetrahedron
+    MeshData mesh;
+    const int a = mesh.addVertex(QVector3D(0, 0, 0));
+    const int b = mesh.addVertex(QVector3D(1, 0, 0));
+    const int c = mesh.addVertex(QVector3D(0, 1, 0));
+    const int d = mesh.addVertex(QVector3D(0, 0, 1));
+    mesh.addFace({a, c, b});
+    mesh.addFace({a, b, d});
+    mesh.addFace({b, c, d});
+    mesh.addFace({c, a, d});
+
+    QVERIFY(mesh.halfEdgeTopology()->isManifold());
+    mesh.removeVertex(d);
+
+    QCOMPARE(mesh.vertexCount(), 3);
+    QCOMPARE(mesh.faceCount(), 1);
+    QCOMPARE(mesh.edgeCount(), 3);
+    QVERIFY(!referencesVertex(mesh, d));
+}
+
+void TestMeshData::removePinchedVertex()
+{
+    // Bow tie: two triangles touching only at p
+    MeshData mesh;
+    const int p = mesh.addVertex(QVector3D(0, 0, 0));
+    const int a = mesh.addVertex(QVector3D(-1, -1, 0));
+    const int b = mesh.addVertex(QVector3D(-1, 1, 0));
+    const int c = mesh.addVertex(QVector3D(1, 1, 0));
+    const int d = mesh.addVertex(QVector3D(1, -1, 0));
+    mesh.addFace({p, a, b});
+    mesh.addFace({p, c, d});
+
+    QVERIFY(!mesh.halfEdgeTopology()->isManifold());
+    mesh.removeVertex(p);
+
+    QCOMPARE(mesh.vertexCount(), 4);
+    QCOMPARE(mesh.faceCount(), 0);
+    QCOMPARE(mesh.edgeCount(), 2);
+    QVERIFY(!referencesVertex(mesh, p));
+}
+
+void TestMeshData::removeClosedPinchedVertex()
+{
+    // Two closed tetrahedra sharing apex p and nothing else
+    MeshData mesh;
+    const int p = mesh.addVertex(QVector3D(0, 0, 0));
+    QVector<int> faces;
+    for (float side : {1.0f, -1.0f}) {
+        const int a = mesh.addVertex(QVector3D(side, 0, 0));
+        const int b = mesh.addVertex(QVector3D(side, side, 0));
+        const int c = mesh.addVertex(QVector3D(side, 0, side));
+        faces.append(mesh.addFace({p, b, a}));
+        faces.append(mesh.addFace({p, a, c}));
+        faces.append(mesh.addFace({p, c, b}));
+        faces.append(mesh.addFace({a, b, c}));
+    }
+
+    QVERIFY(!mesh.halfEdgeTopology()->isManifold());
+    mesh.removeVertices({p});
+
+    QCOMPARE(mesh.faceCount(), 2);
+    QVERIFY(mesh.findFace(faces[3]));
+    QVERIFY(mesh.findFace(faces[7]));
+    QVERIFY(!referencesVertex(mesh, p));
+}
+
+void TestMeshData::removeVertexOnSharedEdge()
+{
+    // Three triangles on edge (a, b)
+    MeshData mesh;
+    const int a = mesh.addVertex(QVector3D(0, 0, 0));
+    const int b = mesh.addVertex(QVector3D(1, 0, 0));
+    for (const QVector3D& position : {QVector3D(0.5f, 1, 0), QVector3D(0.5f, -1, 0), QVector3D(0.5f, 0, 1)}) {
+        mesh.addFace({a, b, mesh.addVertex(position)});
+    }
+
+    QVERIFY(!mesh.halfEdgeTopology()->isManifold());
+    mesh.removeVertex(a);
+
+    QCOMPARE(mesh.faceCount(), 0);
+    QCOMPARE(mesh.edgeCount(), 3);
+    QVERIFY(!referencesVertex(mesh, a));
+}
+
+QTEST_APPLESS_MAIN(TestMeshData)
+#include "tst_meshdata.moc"